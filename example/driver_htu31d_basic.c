@@ -37,6 +37,7 @@
 #include "driver_htu31d_basic.h"
 
 static htu31d_handle_t gs_handle;        /**< htu31d handle */
+static htu31d_periodic_t gs_periodic;    /**< htu31d periodic sampler */
 
 /**
  * @brief     basic example init
@@ -57,6 +58,8 @@ uint8_t htu31d_basic_init(htu31d_addr_pin_t addr_pin)
     DRIVER_HTU31D_LINK_IIC_WRITE(&gs_handle, htu31d_interface_iic_write);
     DRIVER_HTU31D_LINK_IIC_READ(&gs_handle, htu31d_interface_iic_read);
     DRIVER_HTU31D_LINK_DELAY_MS(&gs_handle, htu31d_interface_delay_ms);
+    DRIVER_HTU31D_LINK_DELAY_US(&gs_handle, htu31d_interface_delay_us);
+    DRIVER_HTU31D_LINK_TIMESTAMP_US(&gs_handle, htu31d_interface_timestamp_us);
     DRIVER_HTU31D_LINK_DEBUG_PRINT(&gs_handle, htu31d_interface_debug_print);
     
     /* set addr pin */
@@ -170,3 +173,108 @@ uint8_t htu31d_basic_get_serial_number(uint8_t number[3])
     
     return 0;
 }
+
+/**
+ * @brief      basic example get the diagnostic
+ * @param[out] *diagnostic pointer to a diagnostic buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get diagnostic failed
+ * @note       none
+ */
+uint8_t htu31d_basic_get_diagnostic(uint8_t *diagnostic)
+{
+    /* get the diagnostic */
+    if (htu31d_get_diagnostic(&gs_handle, diagnostic) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     basic example start the periodic sampling
+ * @param[in] period_ms sampling period in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 periodic start failed
+ * @note      none
+ */
+uint8_t htu31d_basic_periodic_start(uint32_t period_ms)
+{
+    /* start the periodic sampling */
+    if (htu31d_periodic_start(&gs_handle, &gs_periodic, period_ms * 1000) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      basic example read the next periodic sample
+ * @param[out] *temperature pointer to a converted temperature buffer
+ * @param[out] *humidity pointer to a converted humidity buffer
+ * @param[out] *timestamp_us pointer to a sample timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 periodic read failed
+ * @note       it blocks until the next release time
+ */
+uint8_t htu31d_basic_periodic_read(float *temperature, float *humidity, uint32_t *timestamp_us)
+{
+    htu31d_sample_t sample;
+    
+    /* read the next sample */
+    if (htu31d_periodic_read(&gs_handle, &gs_periodic, &sample) != 0)
+    {
+        return 1;
+    }
+    *temperature = (float)(sample.temperature_centi) / 100.0f;
+    *humidity = (float)(sample.humidity_centi) / 100.0f;
+    *timestamp_us = sample.timestamp_us;
+    
+    return 0;
+}
+
+/**
+ * @brief      basic example read the next periodic raw sample
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *timestamp_us pointer to a sample timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 periodic read failed
+ * @note       it blocks until the next release time
+ */
+uint8_t htu31d_basic_periodic_read_raw(uint16_t *temperature_raw, uint16_t *humidity_raw, uint32_t *timestamp_us)
+{
+    htu31d_sample_t sample;
+    
+    /* read the next sample */
+    if (htu31d_periodic_read(&gs_handle, &gs_periodic, &sample) != 0)
+    {
+        return 1;
+    }
+    *temperature_raw = sample.temperature_raw;
+    *humidity_raw = sample.humidity_raw;
+    *timestamp_us = sample.timestamp_us;
+    
+    return 0;
+}
+
+/**
+ * @brief      basic example get the periodic overrun count
+ * @param[out] *overrun pointer to an overrun buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t htu31d_basic_periodic_get_overrun(uint32_t *overrun)
+{
+    /* get the overrun */
+    *overrun = gs_periodic.overrun;
+    
+    return 0;
+}
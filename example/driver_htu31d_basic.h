@@ -96,6 +96,59 @@ uint8_t htu31d_basic_read(float *temperature, float *humidity);
  */
 uint8_t htu31d_basic_get_serial_number(uint8_t number[3]);
 
+/**
+ * @brief      basic example get the diagnostic
+ * @param[out] *diagnostic pointer to a diagnostic buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get diagnostic failed
+ * @note       none
+ */
+uint8_t htu31d_basic_get_diagnostic(uint8_t *diagnostic);
+
+/**
+ * @brief     basic example start the periodic sampling
+ * @param[in] period_ms sampling period in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 periodic start failed
+ * @note      none
+ */
+uint8_t htu31d_basic_periodic_start(uint32_t period_ms);
+
+/**
+ * @brief      basic example read the next periodic sample
+ * @param[out] *temperature pointer to a converted temperature buffer
+ * @param[out] *humidity pointer to a converted humidity buffer
+ * @param[out] *timestamp_us pointer to a sample timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 periodic read failed
+ * @note       it blocks until the next release time
+ */
+uint8_t htu31d_basic_periodic_read(float *temperature, float *humidity, uint32_t *timestamp_us);
+
+/**
+ * @brief      basic example read the next periodic raw sample
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *timestamp_us pointer to a sample timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 periodic read failed
+ * @note       it blocks until the next release time
+ */
+uint8_t htu31d_basic_periodic_read_raw(uint16_t *temperature_raw, uint16_t *humidity_raw, uint32_t *timestamp_us);
+
+/**
+ * @brief      basic example get the periodic overrun count
+ * @param[out] *overrun pointer to an overrun buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t htu31d_basic_periodic_get_overrun(uint32_t *overrun);
+
 /**
  * @}
  */
@@ -101,6 +101,109 @@ uint8_t htu31d_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint1
  */
 void htu31d_interface_delay_ms(uint32_t ms);
 
+/**
+ * @brief     interface iic bus init with context
+ * @param[in] *user_data points to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      none
+ */
+uint8_t htu31d_interface_iic_init_ctx(void *user_data);
+
+/**
+ * @brief     interface iic bus deinit with context
+ * @param[in] *user_data points to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      none
+ */
+uint8_t htu31d_interface_iic_deinit_ctx(void *user_data);
+
+/**
+ * @brief     interface iic bus write with context
+ * @param[in] *user_data points to a user context
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t htu31d_interface_iic_write_ctx(void *user_data, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      interface iic bus read with context
+ * @param[in]  *user_data points to a user context
+ * @param[in]  addr is the iic device write address
+ * @param[in]  reg is the iic register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t htu31d_interface_iic_read_ctx(void *user_data, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      interface iic bus batch read with context
+ * @param[in]  **user_data points to a user context array with num entries
+ * @param[in]  *addr points to an iic device write address array
+ * @param[in]  num is the device number
+ * @param[in]  reg is the iic register address
+ * @param[out] *buf points to a data buffer with num * len bytes
+ * @param[in]  len is the data length of each device
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       device i is read into buf + i * len with the context user_data[i]
+ */
+uint8_t htu31d_interface_iic_read_batch_ctx(void **user_data, const uint8_t *addr, uint8_t num, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      interface iic bus batch read behind a mux with context
+ * @param[in]  *user_data points to a user context
+ * @param[in]  mux_addr is the mux write address
+ * @param[in]  *select points to a mux control byte array
+ * @param[in]  *addr points to an iic device write address array
+ * @param[in]  num is the device number
+ * @param[in]  reg is the iic register address
+ * @param[out] *buf points to a data buffer with num * len bytes
+ * @param[in]  len is the data length of each device
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       select[i] is written to the mux before device i is read when it is not 0
+ */
+uint8_t htu31d_interface_iic_read_batch_select_ctx(void *user_data, uint8_t mux_addr, const uint8_t *select, const uint8_t *addr,
+                                                   uint8_t num, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     interface delay ms with context
+ * @param[in] *user_data points to a user context
+ * @param[in] ms
+ * @note      none
+ */
+void htu31d_interface_delay_ms_ctx(void *user_data, uint32_t ms);
+
+/**
+ * @brief     interface delay us
+ * @param[in] us
+ * @note      none
+ */
+void htu31d_interface_delay_us(uint32_t us);
+
+/**
+ * @brief  interface timestamp us
+ * @return monotonic timestamp in us
+ * @note   none
+ */
+uint32_t htu31d_interface_timestamp_us(void);
+
 /**
  * @brief     interface print format data
  * @param[in] fmt is the format data
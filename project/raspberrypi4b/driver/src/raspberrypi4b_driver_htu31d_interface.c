@@ -36,6 +36,7 @@
 
 #include "driver_htu31d_interface.h"
 #include "iic.h"
+#include "delay.h"
 #include <stdarg.h>
 
 /**
@@ -44,9 +45,10 @@
 #define IIC_DEVICE_NAME "/dev/i2c-1"        /**< iic device name */
 
 /**
- * @brief iic device handle definition
+ * @brief iic device bus definition
  */
-static int gs_fd;                           /**< iic handle */
+static iic_bus_t gs_bus = IIC_BUS_INITIALIZER(IIC_DEVICE_NAME);        /**< default iic bus */
+static iic_device_t gs_device;                                         /**< default iic device */
 
 /**
  * @brief  interface iic bus init
@@ -57,7 +59,12 @@ static int gs_fd;                           /**< iic handle */
  */
 uint8_t htu31d_interface_iic_init(void)
 {
-    return iic_init(IIC_DEVICE_NAME, &gs_fd);
+    if (gs_device.bus == NULL)
+    {
+        iic_device_init(&gs_device, &gs_bus, 0x00);
+    }
+    
+    return htu31d_interface_iic_init_ctx(&gs_device);
 }
 
 /**
@@ -69,7 +76,7 @@ uint8_t htu31d_interface_iic_init(void)
  */
 uint8_t htu31d_interface_iic_deinit(void)
 {
-    return iic_deinit(gs_fd);
+    return htu31d_interface_iic_deinit_ctx(&gs_device);
 }
 
 /**
@@ -85,7 +92,7 @@ uint8_t htu31d_interface_iic_deinit(void)
  */
 uint8_t htu31d_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    return iic_write(gs_fd, addr, reg, buf , len);
+    return htu31d_interface_iic_write_ctx(&gs_device, addr, reg, buf, len);
 }
 
 /**
@@ -101,7 +108,7 @@ uint8_t htu31d_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint
  */
 uint8_t htu31d_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    return iic_read(gs_fd, addr, reg, buf, len);
+    return htu31d_interface_iic_read_ctx(&gs_device, addr, reg, buf, len);
 }
 
 /**
@@ -111,7 +118,197 @@ uint8_t htu31d_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint1
  */
 void htu31d_interface_delay_ms(uint32_t ms)
 {
-    usleep(1000 * ms);
+    delay_ns((uint64_t)ms * 1000000ULL);
+}
+
+/**
+ * @brief     interface iic bus init with context
+ * @param[in] *user_data pointer to an iic device structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      none
+ */
+uint8_t htu31d_interface_iic_init_ctx(void *user_data)
+{
+    return iic_bus_open(((iic_device_t *)user_data)->bus);
+}
+
+/**
+ * @brief     interface iic bus deinit with context
+ * @param[in] *user_data pointer to an iic device structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      none
+ */
+uint8_t htu31d_interface_iic_deinit_ctx(void *user_data)
+{
+    return iic_bus_close(((iic_device_t *)user_data)->bus);
+}
+
+/**
+ * @brief     interface iic bus write with context
+ * @param[in] *user_data pointer to an iic device structure
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t htu31d_interface_iic_write_ctx(void *user_data, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return iic_device_write((iic_device_t *)user_data, addr, reg, buf, len);
+}
+
+/**
+ * @brief      interface iic bus read with context
+ * @param[in]  *user_data pointer to an iic device structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t htu31d_interface_iic_read_ctx(void *user_data, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return iic_device_read((iic_device_t *)user_data, addr, reg, buf, len);
+}
+
+/**
+ * @brief      interface iic bus batch read with context
+ * @param[in]  **user_data pointer to an iic device structure array, a NULL entry uses the default bus
+ * @param[in]  *addr points to an iic device write address array
+ * @param[in]  num is the device number
+ * @param[in]  reg is the iic register address
+ * @param[out] *buf points to a data buffer with num * len bytes
+ * @param[in]  len is the data length of each device
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       all devices must share the bus of the first one,
+ *             the reads are packed into as few I2C_RDWR ioctls as possible
+ */
+uint8_t htu31d_interface_iic_read_batch_ctx(void **user_data, const uint8_t *addr, uint8_t num, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    iic_device_t *device = (user_data[0] != NULL) ? (iic_device_t *)user_data[0] : &gs_device;
+    iic_batch_t batch;
+    uint8_t i;
+    
+    /* the default bus is only known after htu31d_interface_iic_init */
+    if (device->bus == NULL)
+    {
+        return 1;
+    }
+    
+    iic_batch_init(&batch);
+    for (i = 0; i < num; i++)
+    {
+        /* flush a full batch */
+        if (iic_batch_add_read(&batch, addr[i], reg, buf + i * len, len) != 0)
+        {
+            if (iic_batch_transfer(device->bus->fd, &batch) != 0)
+            {
+                return 1;
+            }
+            iic_batch_init(&batch);
+            (void)iic_batch_add_read(&batch, addr[i], reg, buf + i * len, len);
+        }
+    }
+    
+    return iic_batch_transfer(device->bus->fd, &batch);
+}
+
+/**
+ * @brief      interface iic bus batch read behind a mux with context
+ * @param[in]  *user_data pointer to an iic device structure, NULL uses the default bus
+ * @param[in]  mux_addr is the mux write address
+ * @param[in]  *select points to a mux control byte array
+ * @param[in]  *addr points to an iic device write address array
+ * @param[in]  num is the device number
+ * @param[in]  reg is the iic register address
+ * @param[out] *buf points to a data buffer with num * len bytes
+ * @param[in]  len is the data length of each device
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       select[i] is queued before the read of device i when it is not 0, a select and
+ *             its read always go out in the same I2C_RDWR ioctl
+ */
+uint8_t htu31d_interface_iic_read_batch_select_ctx(void *user_data, uint8_t mux_addr, const uint8_t *select, const uint8_t *addr,
+                                                   uint8_t num, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    iic_device_t *device = (user_data != NULL) ? (iic_device_t *)user_data : &gs_device;
+    iic_batch_t batch;
+    uint32_t need;
+    uint8_t i;
+    
+    /* the default bus is only known after htu31d_interface_iic_init */
+    if (device->bus == NULL)
+    {
+        return 1;
+    }
+    
+    iic_batch_init(&batch);
+    for (i = 0; i < num; i++)
+    {
+        /* flush when the select and the read don't fit */
+        need = (select[i] != 0) ? 3 : 2;
+        if (batch.num + need > I2C_RDWR_IOCTL_MAX_MSGS)
+        {
+            if (iic_batch_transfer(device->bus->fd, &batch) != 0)
+            {
+                return 1;
+            }
+            iic_batch_init(&batch);
+        }
+        if (select[i] != 0)
+        {
+            (void)iic_batch_add_select(&batch, mux_addr, select[i]);
+        }
+        (void)iic_batch_add_read(&batch, addr[i], reg, buf + i * len, len);
+    }
+    
+    return iic_batch_transfer(device->bus->fd, &batch);
+}
+
+/**
+ * @brief     interface delay ms with context
+ * @param[in] *user_data pointer to a user context
+ * @param[in] ms time
+ * @note      none
+ */
+void htu31d_interface_delay_ms_ctx(void *user_data, uint32_t ms)
+{
+    (void)user_data;
+    
+    delay_ns((uint64_t)ms * 1000000ULL);
+}
+
+/**
+ * @brief     interface delay us
+ * @param[in] us time
+ * @note      none
+ */
+void htu31d_interface_delay_us(uint32_t us)
+{
+    delay_ns((uint64_t)us * 1000ULL);
+}
+
+/**
+ * @brief  interface timestamp us
+ * @return monotonic timestamp in us
+ * @note   none
+ */
+uint32_t htu31d_interface_timestamp_us(void)
+{
+    return (uint32_t)(delay_now_ns() / 1000ULL);
 }
 
 /**
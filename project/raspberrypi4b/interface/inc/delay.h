@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      delay.h
+ * @brief     delay header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DELAY_H
+#define DELAY_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup delay delay function
+ * @brief    delay function modules
+ * @{
+ */
+
+/**
+ * @brief delay statistics structure definition
+ */
+typedef struct delay_stats_s
+{
+    uint64_t count;                  /**< finished delays */
+    uint64_t oversleep_total_ns;     /**< sum of the time past the deadlines in ns */
+    uint64_t oversleep_max_ns;       /**< largest time past a deadline in ns */
+    uint64_t spin_ns;                /**< time spent in the spin tail in ns */
+} delay_stats_t;
+
+/**
+ * @brief     set the spin tail
+ * @param[in] spin_ns busy wait before the deadline in ns, 0 disables it
+ * @note      the kernel wakes the thread spin_ns before the deadline and the rest is busy waited,
+ *            a few tens of us hide most of the wake up latency at the cost of cpu time
+ */
+void delay_set_spin(uint32_t spin_ns);
+
+/**
+ * @brief  get the monotonic time
+ * @return CLOCK_MONOTONIC time in ns
+ * @note   none
+ */
+uint64_t delay_now_ns(void);
+
+/**
+ * @brief     delay until an absolute deadline
+ * @param[in] deadline_ns CLOCK_MONOTONIC deadline in ns
+ * @note      a passed deadline returns at once, signals don't shorten the delay
+ */
+void delay_until_ns(uint64_t deadline_ns);
+
+/**
+ * @brief     delay ns
+ * @param[in] ns delay time in ns
+ * @note      the deadline is taken before sleeping, so the call overhead is not added
+ */
+void delay_ns(uint64_t ns);
+
+/**
+ * @brief      get the delay statistics
+ * @param[out] *stats pointer to a delay statistics structure
+ * @param[in]  reset clear the statistics after the copy when it is not 0
+ * @note       the statistics are shared by all threads, every field is read and cleared atomically
+ *             but the fields of one copy can come from different delays
+ */
+void delay_get_stats(delay_stats_t *stats, uint8_t reset);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
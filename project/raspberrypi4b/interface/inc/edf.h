@@ -0,0 +1,193 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      edf.h
+ * @brief     edf header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef EDF_H
+#define EDF_H
+
+#include "driver_htu31d.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup edf edf function
+ * @brief    edf function modules
+ * @{
+ */
+
+/**
+ * @brief edf sensor state enumeration definition
+ */
+typedef enum
+{
+    EDF_STATE_WAIT       = 0x00,        /**< waiting for the release time */
+    EDF_STATE_CONVERTING = 0x01,        /**< conversion started */
+} edf_state_t;
+
+/**
+ * @brief edf sensor structure definition
+ */
+typedef struct edf_sensor_s
+{
+    htu31d_handle_t *handle;                                                           /**< inited handle */
+    uint32_t period_us;                                                                /**< sampling period in us */
+    void (*callback)(struct edf_sensor_s *sensor, uint8_t res, htu31d_sample_t *sample); /**< sample callback */
+    void *user_data;                                                                   /**< user data */
+    uint8_t state;                                                                     /**< edf sensor state */
+    uint64_t release_ns;                                                               /**< release time in ns */
+    uint64_t ready_ns;                                                                 /**< conversion finish time in ns */
+    uint32_t count;                                                                    /**< finished samples */
+    uint32_t miss;                                                                     /**< missed deadlines */
+} edf_sensor_t;
+
+/**
+ * @brief edf report structure definition
+ */
+typedef struct edf_report_s
+{
+    uint32_t count;                     /**< finished samples of all sensors */
+    uint32_t miss;                      /**< missed deadlines of all sensors */
+    uint64_t elapsed_ns;                /**< time since edf_start in ns */
+    uint64_t busy_ns;                   /**< time spent in bus transactions in ns */
+    uint32_t utilization;               /**< busy_ns / elapsed_ns in 0.01% */
+    uint32_t demand;                    /**< estimated bus demand of the periods in 0.01% */
+} edf_report_t;
+
+/**
+ * @brief edf structure definition
+ */
+typedef struct edf_s
+{
+    edf_sensor_t *sensor;               /**< sensor array */
+    uint8_t num;                        /**< sensor number */
+    volatile uint8_t stop;              /**< stop flag */
+    uint64_t start_ns;                  /**< edf_start time in ns */
+    uint64_t busy_ns;                   /**< time spent in bus transactions in ns */
+    uint64_t start_cost_ns;             /**< last start transaction time in ns */
+    uint64_t fetch_cost_ns;             /**< last fetch transaction time in ns */
+    uint64_t (*now_ns)(void);           /**< point to a clock function address */
+    void (*until_ns)(uint64_t ns);      /**< point to a sleep until function address */
+} edf_t;
+
+/**
+ * @brief     init a sensor
+ * @param[in] *sensor pointer to an edf sensor structure
+ * @param[in] *handle pointer to an inited htu31d handle structure
+ * @param[in] period_us sampling period in us, it is also the relative deadline
+ * @param[in] *callback pointer to a sample callback, it can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 1 param is invalid
+ * @note      the conversion time must be shorter than the period
+ */
+uint8_t edf_sensor_init(edf_sensor_t *sensor, htu31d_handle_t *handle, uint32_t period_us,
+                        void (*callback)(edf_sensor_t *sensor, uint8_t res, htu31d_sample_t *sample));
+
+/**
+ * @brief     init the scheduler
+ * @param[in] *edf pointer to an edf structure
+ * @param[in] *sensor pointer to an edf sensor array
+ * @param[in] num sensor number
+ * @return    status code
+ *            - 0 success
+ *            - 1 param is invalid
+ * @note      the handles must link a CLOCK_MONOTONIC timestamp_us unless edf_set_clock links another clock
+ */
+uint8_t edf_init(edf_t *edf, edf_sensor_t *sensor, uint8_t num);
+
+/**
+ * @brief     set the scheduler clock
+ * @param[in] *edf pointer to an edf structure
+ * @param[in] *now_ns pointer to a clock function returning the time in ns
+ * @param[in] *until_ns pointer to a function sleeping until a time of that clock
+ * @return    status code
+ *            - 0 success
+ *            - 1 param is invalid
+ * @note      edf_init links delay_now_ns and delay_until_ns, a virtual clock lets tests run in simulated time,
+ *            the handles must link a timestamp_us of the same clock
+ */
+uint8_t edf_set_clock(edf_t *edf, uint64_t (*now_ns)(void), void (*until_ns)(uint64_t ns));
+
+/**
+ * @brief     release all sensors now and clear the counters
+ * @param[in] *edf pointer to an edf structure
+ * @note      none
+ */
+void edf_start(edf_t *edf);
+
+/**
+ * @brief     run the ready bus transactions
+ * @param[in] *edf pointer to an edf structure
+ * @return    time in ns of the scheduler clock when the next transaction is ready
+ * @note      it never sleeps, of the released sensors and finished conversions the one with
+ *            the earliest deadline gets the bus first, so conversions of slow sensors overlap the fast ones,
+ *            only the jobs ready on entry are run, so an overloaded bus still returns to the caller
+ */
+uint64_t edf_dispatch(edf_t *edf);
+
+/**
+ * @brief     run the scheduler
+ * @param[in] *edf pointer to an edf structure
+ * @param[in] duration_us run time in us, 0 runs until edf_stop
+ * @note      it sleeps between the transactions
+ */
+void edf_run(edf_t *edf, uint64_t duration_us);
+
+/**
+ * @brief     stop edf_run
+ * @param[in] *edf pointer to an edf structure
+ * @note      it can be called from a sample callback or another thread
+ */
+void edf_stop(edf_t *edf);
+
+/**
+ * @brief      get the scheduler report
+ * @param[in]  *edf pointer to an edf structure
+ * @param[out] *report pointer to an edf report structure
+ * @note       none
+ */
+void edf_get_report(edf_t *edf, edf_report_t *report);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
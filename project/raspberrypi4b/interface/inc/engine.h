@@ -0,0 +1,182 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      engine.h
+ * @brief     engine header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include "driver_htu31d.h"
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup engine engine function
+ * @brief    engine function modules
+ * @{
+ */
+
+/**
+ * @brief engine operation enumeration definition
+ */
+typedef enum
+{
+    ENGINE_OP_CONVERT    = 0x00,        /**< start a conversion, value returns the conversion time in us */
+    ENGINE_OP_FETCH      = 0x01,        /**< fetch the finished conversion, waits for its deadline first */
+    ENGINE_OP_RESET      = 0x02,        /**< soft reset */
+    ENGINE_OP_HEATER     = 0x03,        /**< heater on when arg is not 0, else off */
+    ENGINE_OP_DIAGNOSTIC = 0x04,        /**< read the diagnostic, value returns it */
+} engine_op_t;
+
+/**
+ * @brief engine submission queue entry structure definition
+ */
+typedef struct engine_sqe_s
+{
+    uint64_t tag;                       /**< user tag copied into the completion */
+    htu31d_handle_t *handle;            /**< inited handle on the engine bus */
+    uint8_t op;                         /**< engine operation */
+    uint8_t arg;                        /**< operation argument */
+} engine_sqe_t;
+
+/**
+ * @brief engine completion queue entry structure definition
+ */
+typedef struct engine_cqe_s
+{
+    uint64_t tag;                       /**< user tag of the submission */
+    htu31d_handle_t *handle;            /**< handle of the submission */
+    uint8_t op;                         /**< engine operation */
+    uint8_t res;                        /**< driver status code */
+    uint32_t value;                     /**< operation value */
+    htu31d_sample_t sample;             /**< fetched sample */
+} engine_cqe_t;
+
+/**
+ * @brief engine queue structure definition
+ * @note  bounded multi producer multi consumer queue with a sequence number per cell
+ */
+typedef struct engine_queue_s
+{
+    uint32_t head __attribute__((aligned(64)));     /**< dequeue position */
+    uint32_t tail __attribute__((aligned(64)));     /**< enqueue position */
+    uint32_t *seq __attribute__((aligned(64)));     /**< cell sequence numbers */
+    uint8_t *data;                                  /**< cell data */
+    uint32_t size;                                  /**< cell data size */
+    uint32_t mask;                                  /**< depth - 1 */
+} engine_queue_t;
+
+/**
+ * @brief engine structure definition
+ * @note  one engine owns the worker of one iic adapter
+ */
+typedef struct engine_s
+{
+    engine_queue_t sq;                  /**< submission queue */
+    engine_queue_t cq;                  /**< completion queue */
+    uint32_t depth;                     /**< queue depth */
+    uint32_t inflight;                  /**< submitted and not reaped entries */
+    int submit_fd;                      /**< eventfd waking the worker */
+    int complete_fd;                    /**< eventfd signalled after completions */
+    uint8_t stop;                       /**< worker stop flag */
+    pthread_t worker;                   /**< worker thread */
+} engine_t;
+
+/**
+ * @brief     init an engine and start its worker
+ * @param[in] *engine pointer to an engine structure
+ * @param[in] depth queue depth, it must be a power of two
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t engine_init(engine_t *engine, uint32_t depth);
+
+/**
+ * @brief     stop the worker and deinit an engine
+ * @param[in] *engine pointer to an engine structure
+ * @note      the submitted entries are finished before the worker exits
+ */
+void engine_deinit(engine_t *engine);
+
+/**
+ * @brief     submit an operation
+ * @param[in] *engine pointer to an engine structure
+ * @param[in] *sqe pointer to a submission queue entry
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ * @note      any thread can submit, the worker only wakes up after engine_enter,
+ *            so a batch costs one system call, at most depth entries can be in flight until they are reaped
+ */
+uint8_t engine_submit(engine_t *engine, const engine_sqe_t *sqe);
+
+/**
+ * @brief     wake the worker for the submitted entries
+ * @param[in] *engine pointer to an engine structure
+ * @note      none
+ */
+void engine_enter(engine_t *engine);
+
+/**
+ * @brief      reap finished operations
+ * @param[in]  *engine pointer to an engine structure
+ * @param[out] *cqe pointer to a completion queue entry array
+ * @param[in]  len array length
+ * @return     reaped entry number
+ * @note       it never blocks, the operations of one engine finish in submission order
+ */
+uint32_t engine_reap(engine_t *engine, engine_cqe_t *cqe, uint32_t len);
+
+/**
+ * @brief     get the completion file descriptor
+ * @param[in] *engine pointer to an engine structure
+ * @return    eventfd that is readable when completions are queued
+ * @note      read it to clear the event before reaping
+ */
+int engine_get_fd(engine_t *engine);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
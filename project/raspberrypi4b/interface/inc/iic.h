@@ -42,6 +42,9 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <pthread.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -53,6 +56,59 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief iic bus structure definition
+ */
+typedef struct iic_bus_s
+{
+    char *name;                    /**< iic device name */
+    int fd;                        /**< iic handle */
+    uint32_t ref;                  /**< open reference count */
+    pthread_mutex_t mutex;         /**< open and close lock */
+} iic_bus_t;
+
+/**
+ * @brief iic device max write payload definition
+ */
+#ifndef IIC_DEVICE_PAYLOAD_MAX
+    #define IIC_DEVICE_PAYLOAD_MAX 8        /**< 8 bytes */
+#endif
+
+/**
+ * @brief iic device structure definition
+ * @note  the i2c_msg templates are filled once, so a transfer only sets the command,
+ *        the read buffer and the lengths before the ioctl
+ */
+typedef struct iic_device_s
+{
+    iic_bus_t *bus;                                       /**< shared iic bus */
+    uint8_t addr;                                         /**< iic device write address */
+    uint8_t cmd;                                          /**< command byte */
+    uint8_t payload[IIC_DEVICE_PAYLOAD_MAX + 1];          /**< command and payload write buffer */
+    struct i2c_msg msgs[3];                               /**< command, read and payload messages */
+    struct i2c_rdwr_ioctl_data cmd_data;                  /**< command only transfer */
+    struct i2c_rdwr_ioctl_data read_data;                 /**< command and read transfer */
+    struct i2c_rdwr_ioctl_data write_data;                /**< command and payload transfer */
+} iic_device_t;
+
+/**
+ * @brief iic batch structure definition
+ * @note  all messages are sent by one I2C_RDWR ioctl
+ */
+typedef struct iic_batch_s
+{
+    struct i2c_msg msgs[I2C_RDWR_IOCTL_MAX_MSGS];        /**< queued messages */
+    uint8_t cmd[I2C_RDWR_IOCTL_MAX_MSGS];                /**< command and select bytes */
+    uint32_t num;                                        /**< queued message number */
+} iic_batch_t;
+
+/**
+ * @brief     iic bus static initializer
+ * @param[in] NAME iic device name
+ * @note      none
+ */
+#define IIC_BUS_INITIALIZER(NAME)    {NAME, -1, 0, PTHREAD_MUTEX_INITIALIZER}
+
 /**
  * @brief      iic bus init
  * @param[in]  *name pointer to an iic device name buffer
@@ -156,6 +212,109 @@ uint8_t iic_write(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
  */
 uint8_t iic_write_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     iic bus open
+ * @param[in] *bus pointer to an iic bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the device is opened by the first caller and shared by the next ones
+ */
+uint8_t iic_bus_open(iic_bus_t *bus);
+
+/**
+ * @brief     iic bus close
+ * @param[in] *bus pointer to an iic bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      the device is closed when the last user closes it
+ */
+uint8_t iic_bus_close(iic_bus_t *bus);
+
+/**
+ * @brief     iic device init
+ * @param[in] *device pointer to an iic device structure
+ * @param[in] *bus pointer to an iic bus structure
+ * @param[in] addr iic device write address
+ * @note      addr = device_address_7bits << 1, the bus can be opened later
+ */
+void iic_device_init(iic_device_t *device, iic_bus_t *bus, uint8_t addr);
+
+/**
+ * @brief     iic device write
+ * @param[in] *device pointer to an iic device structure
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      a different addr retargets the templates, payloads longer than
+ *            IIC_DEVICE_PAYLOAD_MAX fall back to iic_write
+ */
+uint8_t iic_device_write(iic_device_t *device, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      iic device read
+ * @param[in]  *device pointer to an iic device structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the data is read straight into buf
+ */
+uint8_t iic_device_read(iic_device_t *device, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     iic batch init
+ * @param[in] *batch pointer to an iic batch structure
+ * @note      none
+ */
+void iic_batch_init(iic_batch_t *batch);
+
+/**
+ * @brief     iic batch add a mux channel select
+ * @param[in] *batch pointer to an iic batch structure
+ * @param[in] addr mux write address
+ * @param[in] channel channel mask
+ * @return    status code
+ *            - 0 success
+ *            - 1 batch is full
+ * @note      addr = device_address_7bits << 1, the message ends with a stop so muxes that
+ *            switch on the stop condition see it, this needs I2C_FUNC_PROTOCOL_MANGLING
+ */
+uint8_t iic_batch_add_select(iic_batch_t *batch, uint8_t addr, uint8_t channel);
+
+/**
+ * @brief      iic batch add a command read
+ * @param[in]  *batch pointer to an iic batch structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 batch is full
+ * @note       addr = device_address_7bits << 1
+ */
+uint8_t iic_batch_add_read(iic_batch_t *batch, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     iic batch transfer
+ * @param[in] fd iic handle
+ * @param[in] *batch pointer to an iic batch structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      one nacked message fails the whole batch
+ */
+uint8_t iic_batch_transfer(int fd, iic_batch_t *batch);
+
 /**
  * @}
  */
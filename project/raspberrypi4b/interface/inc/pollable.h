@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      pollable.h
+ * @brief     pollable header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef POLLABLE_H
+#define POLLABLE_H
+
+#include "driver_htu31d.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup pollable pollable function
+ * @brief    pollable function modules
+ * @{
+ */
+
+/**
+ * @brief pollable state enumeration definition
+ */
+typedef enum
+{
+    POLLABLE_STATE_IDLE       = 0x00,        /**< timer is disarmed */
+    POLLABLE_STATE_RELEASE    = 0x01,        /**< timer expires at the next release time */
+    POLLABLE_STATE_CONVERTING = 0x02,        /**< timer expires when the conversions are finished */
+} pollable_state_t;
+
+/**
+ * @brief pollable structure definition
+ */
+typedef struct pollable_s
+{
+    int fd;                                  /**< timerfd */
+    htu31d_handle_t **handle;                /**< sensor group */
+    uint8_t num;                             /**< sensor number */
+    uint8_t state;                           /**< pollable state */
+    uint32_t period_us;                      /**< sampling period in us, 0 means one shot */
+    uint64_t release_ns;                     /**< next release time in CLOCK_MONOTONIC ns */
+    uint32_t overrun;                        /**< missed release times */
+} pollable_t;
+
+/**
+ * @brief     init a pollable sensor group
+ * @param[in] *pollable pointer to a pollable structure
+ * @param[in] **handle pointer to an inited htu31d handle pointer array
+ * @param[in] num sensor number
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the handle array must live until pollable_deinit, the handles must link a CLOCK_MONOTONIC timestamp_us
+ */
+uint8_t pollable_init(pollable_t *pollable, htu31d_handle_t **handle, uint8_t num);
+
+/**
+ * @brief     deinit a pollable sensor group
+ * @param[in] *pollable pointer to a pollable structure
+ * @note      none
+ */
+void pollable_deinit(pollable_t *pollable);
+
+/**
+ * @brief     get the file descriptor
+ * @param[in] *pollable pointer to a pollable structure
+ * @return    timerfd to wait for with poll, select or epoll as readable
+ * @note      none
+ */
+int pollable_get_fd(pollable_t *pollable);
+
+/**
+ * @brief     start the sampling
+ * @param[in] *pollable pointer to a pollable structure
+ * @param[in] period_us sampling period in us, 0 takes one sample
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the first release time is now, so the fd is readable at once
+ */
+uint8_t pollable_start(pollable_t *pollable, uint32_t period_us);
+
+/**
+ * @brief     stop the sampling
+ * @param[in] *pollable pointer to a pollable structure
+ * @note      a running conversion is left to finish in the sensors
+ */
+void pollable_stop(pollable_t *pollable);
+
+/**
+ * @brief      handle a readable fd
+ * @param[in]  *pollable pointer to a pollable structure
+ * @param[out] *sample pointer to a sample array with num entries
+ * @param[out] *status pointer to a status array with num entries
+ * @param[out] *ready pointer to a ready flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 dispatch failed
+ * @note       nothing in it blocks, on a release time the conversions are started and the timer is armed
+ *             for the slowest one, on the conversion deadline the results are fetched, ready is set and
+ *             sample/status are filled with the htu31d_group_fetch results, a spurious wake up returns 0
+ *             with ready cleared
+ */
+uint8_t pollable_dispatch(pollable_t *pollable, htu31d_sample_t *sample, uint8_t *status, uint8_t *ready);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      ring.h
+ * @brief     ring header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RING_H
+#define RING_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup ring ring function
+ * @brief    ring function modules
+ * @{
+ */
+
+/**
+ * @brief ring cache line size definition
+ */
+#ifndef RING_CACHE_LINE
+    #define RING_CACHE_LINE 64        /**< 64 bytes */
+#endif
+
+/**
+ * @brief ring sample structure definition
+ */
+typedef struct ring_sample_s
+{
+    uint64_t timestamp_us;            /**< CLOCK_MONOTONIC timestamp in us */
+    uint16_t temperature_raw;         /**< raw temperature */
+    uint16_t humidity_raw;            /**< raw humidity */
+    uint8_t diagnostic;               /**< diagnostic bits */
+    uint8_t reserved[3];              /**< reserved */
+} ring_sample_t;
+
+/**
+ * @brief ring structure definition
+ * @note  the producer and the consumer indexes live on their own cache lines,
+ *        each side keeps a cached copy of the other index so the shared line is only read when needed
+ */
+typedef struct ring_s
+{
+    struct
+    {
+        uint32_t head;                /**< write index, only stored by the producer */
+        uint32_t tail_cache;          /**< last seen read index */
+        uint64_t dropped;             /**< samples dropped on a full ring */
+    } producer __attribute__((aligned(RING_CACHE_LINE)));
+    struct
+    {
+        uint32_t tail;                /**< read index, only stored by the consumer */
+        uint32_t head_cache;          /**< last seen write index */
+    } consumer __attribute__((aligned(RING_CACHE_LINE)));
+    struct
+    {
+        ring_sample_t *buf;           /**< sample buffer */
+        uint32_t mask;                /**< size - 1 */
+    } storage __attribute__((aligned(RING_CACHE_LINE)));
+} ring_t;
+
+/**
+ * @brief     init the ring
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] *buf pointer to a sample buffer
+ * @param[in] size sample buffer length, it must be a power of two
+ * @return    status code
+ *            - 0 success
+ *            - 1 param is invalid
+ * @note      the caller owns the buffer
+ */
+uint8_t ring_init(ring_t *ring, ring_sample_t *buf, uint32_t size);
+
+/**
+ * @brief     push a sample
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] *sample pointer to a sample structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 ring is full
+ * @note      only one producer thread may call it, a full ring drops the new sample and never blocks
+ */
+uint8_t ring_push(ring_t *ring, const ring_sample_t *sample);
+
+/**
+ * @brief      pop up to len samples
+ * @param[in]  *ring pointer to a ring structure
+ * @param[out] *samples pointer to a sample array
+ * @param[in]  len sample array length
+ * @return     popped sample number
+ * @note       only one consumer thread may call it, it never blocks
+ */
+uint32_t ring_pop_batch(ring_t *ring, ring_sample_t *samples, uint32_t len);
+
+/**
+ * @brief     get the dropped sample number
+ * @param[in] *ring pointer to a ring structure
+ * @return    dropped sample number
+ * @note      it can be called from any thread
+ */
+uint64_t ring_get_dropped(ring_t *ring);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
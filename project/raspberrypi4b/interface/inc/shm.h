@@ -0,0 +1,250 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      shm.h
+ * @brief     shm header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SHM_H
+#define SHM_H
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup shm shm function
+ * @brief    shm function modules
+ * @{
+ */
+
+/**
+ * @brief shm default definition
+ */
+#define SHM_DEFAULT_NAME        "/htu31d"         /**< default shm object name */
+#define SHM_MAGIC               0x31335448U       /**< "HT31" */
+#define SHM_VERSION             1                 /**< region layout version */
+#ifndef SHM_SLOT_MAX
+    #define SHM_SLOT_MAX        8                 /**< max sensor slots */
+#endif
+#ifndef SHM_READ_RETRY_MAX
+    #define SHM_READ_RETRY_MAX  1000              /**< max seq polls of one read */
+#endif
+
+/**
+ * @brief shm reading structure definition
+ */
+typedef struct shm_reading_s
+{
+    uint64_t timestamp_us;          /**< CLOCK_MONOTONIC timestamp in us */
+    uint32_t count;                 /**< published samples of the slot */
+    uint16_t temperature_raw;       /**< raw temperature */
+    uint16_t humidity_raw;          /**< raw humidity */
+    int16_t temperature_centi;      /**< temperature in 0.01C */
+    uint16_t humidity_centi;        /**< humidity in 0.01% */
+    uint8_t diagnostic;             /**< diagnostic bits */
+} shm_reading_t;
+
+/**
+ * @brief shm slot structure definition
+ * @note  seq is odd while the publisher writes the slot, every slot owns its cache lines
+ */
+typedef struct shm_slot_s
+{
+    uint32_t seq;                   /**< sequence counter */
+    shm_reading_t reading;          /**< latest reading */
+} __attribute__((aligned(64))) shm_slot_t;
+
+/**
+ * @brief shm region structure definition
+ */
+typedef struct shm_region_s
+{
+    uint32_t magic;                           /**< SHM_MAGIC when the region is ready */
+    uint32_t version;                         /**< SHM_VERSION */
+    uint32_t slot_num;                        /**< used slots */
+    shm_slot_t slot[SHM_SLOT_MAX];            /**< sensor slots */
+} shm_region_t;
+
+/**
+ * @brief shm publisher structure definition
+ */
+typedef struct shm_publisher_s
+{
+    char name[32];                  /**< shm object name */
+    shm_region_t *region;           /**< mapped region */
+} shm_publisher_t;
+
+/**
+ * @brief     open the publisher
+ * @param[in] *publisher pointer to a shm publisher structure
+ * @param[in] *name pointer to a shm object name, NULL means SHM_DEFAULT_NAME
+ * @param[in] slot_num used slots
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      a stale object of the same name is unlinked and a fresh one is created,
+ *            readers still mapping the stale one must reopen
+ */
+uint8_t shm_publisher_open(shm_publisher_t *publisher, const char *name, uint32_t slot_num);
+
+/**
+ * @brief     publish a reading
+ * @param[in] *publisher pointer to a shm publisher structure
+ * @param[in] slot slot index
+ * @param[in] *reading pointer to a reading structure, its count is ignored
+ * @return    status code
+ *            - 0 success
+ *            - 1 slot is invalid
+ * @note      only one thread may publish into a slot
+ */
+uint8_t shm_publish(shm_publisher_t *publisher, uint32_t slot, const shm_reading_t *reading);
+
+/**
+ * @brief     close the publisher
+ * @param[in] *publisher pointer to a shm publisher structure
+ * @param[in] unlink_name remove the shm object when it is not 0
+ * @note      mapped readers keep the old region until they close it
+ */
+void shm_publisher_close(shm_publisher_t *publisher, uint8_t unlink_name);
+
+/**
+ * @brief     open a reader
+ * @param[in] *name pointer to a shm object name, NULL means SHM_DEFAULT_NAME
+ * @return    pointer to the read only region, NULL on failure
+ * @note      the reader api is header only, reads don't enter the kernel
+ */
+static inline const shm_region_t *shm_reader_open(const char *name)
+{
+    int fd;
+    void *addr;
+    const shm_region_t *region;
+    
+    fd = shm_open((name != NULL) ? name : SHM_DEFAULT_NAME, O_RDONLY, 0);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    addr = mmap(NULL, sizeof(shm_region_t), PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED)
+    {
+        return NULL;
+    }
+    region = (const shm_region_t *)addr;
+    if ((__atomic_load_n(&region->magic, __ATOMIC_ACQUIRE) != SHM_MAGIC) || (region->version != SHM_VERSION))
+    {
+        (void)munmap(addr, sizeof(shm_region_t));
+        
+        return NULL;
+    }
+    
+    return region;
+}
+
+/**
+ * @brief      read the latest reading of a slot
+ * @param[in]  *region pointer to a region returned by shm_reader_open
+ * @param[in]  slot slot index
+ * @param[out] *reading pointer to a reading structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 slot is invalid
+ *             - 2 slot has no reading
+ *             - 3 slot is busy
+ * @note       the copy retries while the publisher writes the slot, so it is always consistent,
+ *             after SHM_READ_RETRY_MAX polls it gives up, e.g. when the publisher died inside a write
+ */
+static inline uint8_t shm_reader_read(const shm_region_t *region, uint32_t slot, shm_reading_t *reading)
+{
+    const shm_slot_t *s;
+    uint32_t seq;
+    uint32_t retry;
+    
+    if (slot >= region->slot_num)
+    {
+        return 1;
+    }
+    s = &region->slot[slot];
+    retry = 0;
+    do
+    {
+        while (((seq = __atomic_load_n(&s->seq, __ATOMIC_ACQUIRE)) & 1) != 0)
+        {
+            /* the publisher is writing */
+            if (++retry >= SHM_READ_RETRY_MAX)
+            {
+                return 3;
+            }
+        }
+        if (++retry > SHM_READ_RETRY_MAX)
+        {
+            return 3;
+        }
+        reading->timestamp_us = __atomic_load_n(&s->reading.timestamp_us, __ATOMIC_RELAXED);
+        reading->count = __atomic_load_n(&s->reading.count, __ATOMIC_RELAXED);
+        reading->temperature_raw = __atomic_load_n(&s->reading.temperature_raw, __ATOMIC_RELAXED);
+        reading->humidity_raw = __atomic_load_n(&s->reading.humidity_raw, __ATOMIC_RELAXED);
+        reading->temperature_centi = __atomic_load_n(&s->reading.temperature_centi, __ATOMIC_RELAXED);
+        reading->humidity_centi = __atomic_load_n(&s->reading.humidity_centi, __ATOMIC_RELAXED);
+        reading->diagnostic = __atomic_load_n(&s->reading.diagnostic, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while (__atomic_load_n(&s->seq, __ATOMIC_RELAXED) != seq);
+    
+    return (reading->count != 0) ? 0 : 2;
+}
+
+/**
+ * @brief     close a reader
+ * @param[in] *region pointer to a region returned by shm_reader_open
+ * @note      none
+ */
+static inline void shm_reader_close(const shm_region_t *region)
+{
+    (void)munmap((void *)region, sizeof(shm_region_t));
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,157 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      delay.c
+ * @brief     delay source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "delay.h"
+#include <errno.h>
+#include <time.h>
+
+/**
+ * @brief delay global variables definition
+ */
+static uint32_t gs_spin_ns = 0;           /**< spin tail in ns */
+static delay_stats_t gs_stats;            /**< delay statistics */
+
+/**
+ * @brief     set the spin tail
+ * @param[in] spin_ns busy wait before the deadline in ns, 0 disables it
+ * @note      the kernel wakes the thread spin_ns before the deadline and the rest is busy waited,
+ *            a few tens of us hide most of the wake up latency at the cost of cpu time
+ */
+void delay_set_spin(uint32_t spin_ns)
+{
+    __atomic_store_n(&gs_spin_ns, spin_ns, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief  get the monotonic time
+ * @return CLOCK_MONOTONIC time in ns
+ * @note   none
+ */
+uint64_t delay_now_ns(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief     delay until an absolute deadline
+ * @param[in] deadline_ns CLOCK_MONOTONIC deadline in ns
+ * @note      a passed deadline returns at once, signals don't shorten the delay
+ */
+void delay_until_ns(uint64_t deadline_ns)
+{
+    struct timespec ts;
+    uint64_t wake;
+    uint64_t now;
+    uint64_t spin;
+    uint64_t late;
+    uint64_t max;
+    uint32_t spin_ns;
+    
+    /* sleep until the spin tail */
+    spin_ns = __atomic_load_n(&gs_spin_ns, __ATOMIC_RELAXED);
+    wake = (deadline_ns > spin_ns) ? (deadline_ns - spin_ns) : 0;
+    ts.tv_sec = (time_t)(wake / 1000000000ULL);
+    ts.tv_nsec = (long)(wake % 1000000000ULL);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+    {
+        /* restart after a signal */
+    }
+    
+    /* spin the tail */
+    now = delay_now_ns();
+    spin = now;
+    while (now < deadline_ns)
+    {
+        now = delay_now_ns();
+    }
+    
+    /* update the statistics, every delaying thread shares them */
+    (void)__atomic_fetch_add(&gs_stats.count, 1, __ATOMIC_RELAXED);
+    (void)__atomic_fetch_add(&gs_stats.spin_ns, now - spin, __ATOMIC_RELAXED);
+    if (now > deadline_ns)
+    {
+        late = now - deadline_ns;
+        (void)__atomic_fetch_add(&gs_stats.oversleep_total_ns, late, __ATOMIC_RELAXED);
+        max = __atomic_load_n(&gs_stats.oversleep_max_ns, __ATOMIC_RELAXED);
+        while ((late > max) &&
+               (__atomic_compare_exchange_n(&gs_stats.oversleep_max_ns, &max, late, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED) == 0))
+        {
+            /* max is reloaded by the failed exchange */
+        }
+    }
+}
+
+/**
+ * @brief     delay ns
+ * @param[in] ns delay time in ns
+ * @note      the deadline is taken before sleeping, so the call overhead is not added
+ */
+void delay_ns(uint64_t ns)
+{
+    delay_until_ns(delay_now_ns() + ns);
+}
+
+/**
+ * @brief      get the delay statistics
+ * @param[out] *stats pointer to a delay statistics structure
+ * @param[in]  reset clear the statistics after the copy when it is not 0
+ * @note       the statistics are shared by all threads, every field is read and cleared atomically
+ *             but the fields of one copy can come from different delays
+ */
+void delay_get_stats(delay_stats_t *stats, uint8_t reset)
+{
+    if (reset != 0)
+    {
+        stats->count = __atomic_exchange_n(&gs_stats.count, 0, __ATOMIC_RELAXED);
+        stats->oversleep_total_ns = __atomic_exchange_n(&gs_stats.oversleep_total_ns, 0, __ATOMIC_RELAXED);
+        stats->oversleep_max_ns = __atomic_exchange_n(&gs_stats.oversleep_max_ns, 0, __ATOMIC_RELAXED);
+        stats->spin_ns = __atomic_exchange_n(&gs_stats.spin_ns, 0, __ATOMIC_RELAXED);
+    }
+    else
+    {
+        stats->count = __atomic_load_n(&gs_stats.count, __ATOMIC_RELAXED);
+        stats->oversleep_total_ns = __atomic_load_n(&gs_stats.oversleep_total_ns, __ATOMIC_RELAXED);
+        stats->oversleep_max_ns = __atomic_load_n(&gs_stats.oversleep_max_ns, __ATOMIC_RELAXED);
+        stats->spin_ns = __atomic_load_n(&gs_stats.spin_ns, __ATOMIC_RELAXED);
+    }
+}
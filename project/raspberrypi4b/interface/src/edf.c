@@ -0,0 +1,340 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      edf.c
+ * @brief     edf source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "edf.h"
+#include "delay.h"
+#include <string.h>
+
+/**
+ * @brief edf job definition
+ */
+#define EDF_JOB_NONE         0        /**< no job */
+#define EDF_JOB_START        1        /**< start a conversion */
+#define EDF_JOB_FETCH        2        /**< fetch a finished conversion */
+
+/**
+ * @brief     init a sensor
+ * @param[in] *sensor pointer to an edf sensor structure
+ * @param[in] *handle pointer to an inited htu31d handle structure
+ * @param[in] period_us sampling period in us, it is also the relative deadline
+ * @param[in] *callback pointer to a sample callback, it can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 1 param is invalid
+ * @note      the conversion time must be shorter than the period
+ */
+uint8_t edf_sensor_init(edf_sensor_t *sensor, htu31d_handle_t *handle, uint32_t period_us,
+                        void (*callback)(edf_sensor_t *sensor, uint8_t res, htu31d_sample_t *sample))
+{
+    uint32_t conversion_time;
+    
+    if ((sensor == NULL) || (handle == NULL))
+    {
+        return 1;
+    }
+    if (htu31d_get_conversion_time(handle, &conversion_time) != 0)
+    {
+        return 1;
+    }
+    if (period_us <= conversion_time)
+    {
+        return 1;
+    }
+    
+    memset(sensor, 0, sizeof(edf_sensor_t));
+    sensor->handle = handle;
+    sensor->period_us = period_us;
+    sensor->callback = callback;
+    sensor->state = EDF_STATE_WAIT;
+    
+    return 0;
+}
+
+/**
+ * @brief     init the scheduler
+ * @param[in] *edf pointer to an edf structure
+ * @param[in] *sensor pointer to an edf sensor array
+ * @param[in] num sensor number
+ * @return    status code
+ *            - 0 success
+ *            - 1 param is invalid
+ * @note      the handles must link a CLOCK_MONOTONIC timestamp_us unless edf_set_clock links another clock
+ */
+uint8_t edf_init(edf_t *edf, edf_sensor_t *sensor, uint8_t num)
+{
+    if ((edf == NULL) || (sensor == NULL) || (num == 0))
+    {
+        return 1;
+    }
+    
+    memset(edf, 0, sizeof(edf_t));
+    edf->sensor = sensor;
+    edf->num = num;
+    edf->now_ns = delay_now_ns;
+    edf->until_ns = delay_until_ns;
+    
+    return 0;
+}
+
+/**
+ * @brief     set the scheduler clock
+ * @param[in] *edf pointer to an edf structure
+ * @param[in] *now_ns pointer to a clock function returning the time in ns
+ * @param[in] *until_ns pointer to a function sleeping until a time of that clock
+ * @return    status code
+ *            - 0 success
+ *            - 1 param is invalid
+ * @note      edf_init links delay_now_ns and delay_until_ns, a virtual clock lets tests run in simulated time,
+ *            the handles must link a timestamp_us of the same clock
+ */
+uint8_t edf_set_clock(edf_t *edf, uint64_t (*now_ns)(void), void (*until_ns)(uint64_t ns))
+{
+    if ((edf == NULL) || (now_ns == NULL) || (until_ns == NULL))
+    {
+        return 1;
+    }
+    
+    edf->now_ns = now_ns;
+    edf->until_ns = until_ns;
+    
+    return 0;
+}
+
+/**
+ * @brief     release all sensors now and clear the counters
+ * @param[in] *edf pointer to an edf structure
+ * @note      none
+ */
+void edf_start(edf_t *edf)
+{
+    uint8_t i;
+    
+    edf->stop = 0;
+    edf->start_ns = edf->now_ns();
+    edf->busy_ns = 0;
+    for (i = 0; i < edf->num; i++)
+    {
+        edf->sensor[i].state = EDF_STATE_WAIT;
+        edf->sensor[i].release_ns = edf->start_ns;
+        edf->sensor[i].count = 0;
+        edf->sensor[i].miss = 0;
+    }
+}
+
+/**
+ * @brief     finish the job of a sensor and release the next one
+ * @param[in] *sensor pointer to an edf sensor structure
+ * @param[in] now current time in ns
+ * @note      releases that can't be started before their deadline any more are counted as missed
+ */
+static void a_edf_next_release(edf_sensor_t *sensor, uint64_t now)
+{
+    uint64_t period_ns;
+    uint64_t missed;
+    
+    period_ns = (uint64_t)sensor->period_us * 1000ULL;
+    sensor->release_ns += period_ns;
+    if (now >= sensor->release_ns + period_ns)
+    {
+        missed = (now - sensor->release_ns) / period_ns;
+        sensor->miss += (uint32_t)missed;
+        sensor->release_ns += missed * period_ns;
+    }
+    sensor->state = EDF_STATE_WAIT;
+}
+
+/**
+ * @brief     run the ready bus transactions
+ * @param[in] *edf pointer to an edf structure
+ * @return    time in ns of the scheduler clock when the next transaction is ready
+ * @note      it never sleeps, of the released sensors and finished conversions the one with
+ *            the earliest deadline gets the bus first, so conversions of slow sensors overlap the fast ones,
+ *            only the jobs ready on entry are run, so an overloaded bus still returns to the caller
+ */
+uint64_t edf_dispatch(edf_t *edf)
+{
+    uint8_t i;
+    uint8_t job;
+    uint8_t best;
+    uint8_t res;
+    uint64_t now;
+    uint64_t end;
+    uint64_t entry;
+    uint64_t deadline;
+    uint64_t best_deadline;
+    uint64_t next;
+    uint64_t at;
+    edf_sensor_t *sensor;
+    htu31d_sample_t sample;
+    
+    entry = edf->now_ns();
+    while (edf->stop == 0)
+    {
+        /* pick the job ready at the entry with the earliest deadline, so an overload can't keep it here */
+        now = edf->now_ns();
+        job = EDF_JOB_NONE;
+        best = 0;
+        best_deadline = UINT64_MAX;
+        next = UINT64_MAX;
+        for (i = 0; i < edf->num; i++)
+        {
+            sensor = &edf->sensor[i];
+            at = (sensor->state == EDF_STATE_WAIT) ? sensor->release_ns : sensor->ready_ns;
+            if (at > entry)
+            {
+                next = (at < next) ? at : next;
+                
+                continue;
+            }
+            deadline = sensor->release_ns + (uint64_t)sensor->period_us * 1000ULL;
+            if (deadline < best_deadline)
+            {
+                best_deadline = deadline;
+                best = i;
+                job = (sensor->state == EDF_STATE_WAIT) ? EDF_JOB_START : EDF_JOB_FETCH;
+            }
+        }
+        if (job == EDF_JOB_NONE)
+        {
+            return next;
+        }
+        
+        /* run it */
+        sensor = &edf->sensor[best];
+        if (job == EDF_JOB_START)
+        {
+            res = htu31d_start_conversion(sensor->handle);
+            end = edf->now_ns();
+            edf->start_cost_ns = end - now;
+            if (res != 0)
+            {
+                if (sensor->callback != NULL)
+                {
+                    sensor->callback(sensor, res, NULL);
+                }
+                a_edf_next_release(sensor, end);
+            }
+            else
+            {
+                sensor->ready_ns = end + (uint64_t)sensor->handle->conversion_time * 1000ULL;
+                sensor->state = EDF_STATE_CONVERTING;
+            }
+        }
+        else
+        {
+            res = htu31d_fetch_temperature_humidity_fixed(sensor->handle,
+                                                          &sample.temperature_raw, &sample.temperature_centi,
+                                                          &sample.humidity_raw, &sample.humidity_centi);
+            end = edf->now_ns();
+            edf->fetch_cost_ns = end - now;
+            sample.timestamp_us = sensor->handle->conversion_start + sensor->handle->conversion_time / 2;
+            if (end > best_deadline)
+            {
+                sensor->miss++;
+            }
+            if (res == 0)
+            {
+                sensor->count++;
+            }
+            if (sensor->callback != NULL)
+            {
+                sensor->callback(sensor, res, (res == 0) ? &sample : NULL);
+            }
+            a_edf_next_release(sensor, end);
+        }
+        edf->busy_ns += end - now;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run the scheduler
+ * @param[in] *edf pointer to an edf structure
+ * @param[in] duration_us run time in us, 0 runs until edf_stop
+ * @note      it sleeps between the transactions
+ */
+void edf_run(edf_t *edf, uint64_t duration_us)
+{
+    uint64_t end;
+    uint64_t next;
+    
+    end = (duration_us != 0) ? (edf->now_ns() + duration_us * 1000ULL) : UINT64_MAX;
+    while ((edf->stop == 0) && (edf->now_ns() < end))
+    {
+        next = edf_dispatch(edf);
+        if (edf->stop != 0)
+        {
+            break;
+        }
+        edf->until_ns((next < end) ? next : end);
+    }
+}
+
+/**
+ * @brief     stop edf_run
+ * @param[in] *edf pointer to an edf structure
+ * @note      it can be called from a sample callback or another thread
+ */
+void edf_stop(edf_t *edf)
+{
+    edf->stop = 1;
+}
+
+/**
+ * @brief      get the scheduler report
+ * @param[in]  *edf pointer to an edf structure
+ * @param[out] *report pointer to an edf report structure
+ * @note       none
+ */
+void edf_get_report(edf_t *edf, edf_report_t *report)
+{
+    uint8_t i;
+    uint64_t demand;
+    
+    memset(report, 0, sizeof(edf_report_t));
+    demand = 0;
+    for (i = 0; i < edf->num; i++)
+    {
+        report->count += edf->sensor[i].count;
+        report->miss += edf->sensor[i].miss;
+        demand += (edf->start_cost_ns + edf->fetch_cost_ns) * 10000ULL / ((uint64_t)edf->sensor[i].period_us * 1000ULL);
+    }
+    report->elapsed_ns = edf->now_ns() - edf->start_ns;
+    report->busy_ns = edf->busy_ns;
+    report->utilization = (report->elapsed_ns != 0) ? (uint32_t)(report->busy_ns * 10000ULL / report->elapsed_ns) : 0;
+    report->demand = (uint32_t)demand;
+}
@@ -0,0 +1,459 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      engine.c
+ * @brief     engine source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "engine.h"
+#include "delay.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+/**
+ * @brief     init a queue
+ * @param[in] *queue pointer to an engine queue structure
+ * @param[in] depth queue depth
+ * @param[in] size cell data size
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+static uint8_t a_engine_queue_init(engine_queue_t *queue, uint32_t depth, uint32_t size)
+{
+    uint32_t i;
+    
+    memset(queue, 0, sizeof(engine_queue_t));
+    queue->seq = (uint32_t *)malloc(sizeof(uint32_t) * depth);
+    queue->data = (uint8_t *)malloc((size_t)size * depth);
+    if ((queue->seq == NULL) || (queue->data == NULL))
+    {
+        free(queue->seq);
+        free(queue->data);
+        
+        return 1;
+    }
+    for (i = 0; i < depth; i++)
+    {
+        queue->seq[i] = i;
+    }
+    queue->size = size;
+    queue->mask = depth - 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     deinit a queue
+ * @param[in] *queue pointer to an engine queue structure
+ * @note      none
+ */
+static void a_engine_queue_deinit(engine_queue_t *queue)
+{
+    free(queue->seq);
+    free(queue->data);
+    queue->seq = NULL;
+    queue->data = NULL;
+}
+
+/**
+ * @brief     push a cell
+ * @param[in] *queue pointer to an engine queue structure
+ * @param[in] *data pointer to the cell data
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ * @note      a producer claims a cell with one cas and publishes it with its sequence number
+ */
+static uint8_t a_engine_queue_push(engine_queue_t *queue, const void *data)
+{
+    uint32_t pos;
+    uint32_t seq;
+    int32_t dif;
+    
+    pos = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+    while (1)
+    {
+        seq = __atomic_load_n(&queue->seq[pos & queue->mask], __ATOMIC_ACQUIRE);
+        dif = (int32_t)(seq - pos);
+        if (dif == 0)
+        {
+            if (__atomic_compare_exchange_n(&queue->tail, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (dif < 0)
+        {
+            return 1;
+        }
+        else
+        {
+            pos = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+        }
+    }
+    memcpy(queue->data + (size_t)(pos & queue->mask) * queue->size, data, queue->size);
+    __atomic_store_n(&queue->seq[pos & queue->mask], pos + 1, __ATOMIC_RELEASE);
+    
+    return 0;
+}
+
+/**
+ * @brief      pop a cell
+ * @param[in]  *queue pointer to an engine queue structure
+ * @param[out] *data pointer to a cell data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 queue is empty
+ * @note       a consumer claims a cell with one cas and frees it for the next lap
+ */
+static uint8_t a_engine_queue_pop(engine_queue_t *queue, void *data)
+{
+    uint32_t pos;
+    uint32_t seq;
+    int32_t dif;
+    
+    pos = __atomic_load_n(&queue->head, __ATOMIC_RELAXED);
+    while (1)
+    {
+        seq = __atomic_load_n(&queue->seq[pos & queue->mask], __ATOMIC_ACQUIRE);
+        dif = (int32_t)(seq - (pos + 1));
+        if (dif == 0)
+        {
+            if (__atomic_compare_exchange_n(&queue->head, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (dif < 0)
+        {
+            return 1;
+        }
+        else
+        {
+            pos = __atomic_load_n(&queue->head, __ATOMIC_RELAXED);
+        }
+    }
+    memcpy(data, queue->data + (size_t)(pos & queue->mask) * queue->size, queue->size);
+    __atomic_store_n(&queue->seq[pos & queue->mask], pos + queue->mask + 1, __ATOMIC_RELEASE);
+    
+    return 0;
+}
+
+/**
+ * @brief      run one operation
+ * @param[in]  *sqe pointer to a submission queue entry
+ * @param[out] *cqe pointer to a completion queue entry
+ * @note       none
+ */
+static void a_engine_run(const engine_sqe_t *sqe, engine_cqe_t *cqe)
+{
+    htu31d_handle_t *handle;
+    uint32_t elapsed;
+    
+    memset(cqe, 0, sizeof(engine_cqe_t));
+    cqe->tag = sqe->tag;
+    cqe->handle = sqe->handle;
+    cqe->op = sqe->op;
+    handle = sqe->handle;
+    switch (sqe->op)
+    {
+        case ENGINE_OP_CONVERT :
+        {
+            cqe->res = htu31d_start_conversion(handle);
+            if (cqe->res == 0)
+            {
+                cqe->value = handle->conversion_time;
+            }
+            
+            break;
+        }
+        case ENGINE_OP_FETCH :
+        {
+            /* wait the rest of the conversion, the following fetches of a group are ready by then */
+            if ((handle != NULL) && (handle->conversion == 1) && (handle->timestamp_us != NULL))
+            {
+                elapsed = handle->timestamp_us() - handle->conversion_start;
+                if (elapsed < handle->conversion_time)
+                {
+                    delay_ns((uint64_t)(handle->conversion_time - elapsed) * 1000ULL);
+                }
+            }
+            cqe->res = htu31d_fetch_temperature_humidity_fixed(handle,
+                                                               &cqe->sample.temperature_raw, &cqe->sample.temperature_centi,
+                                                               &cqe->sample.humidity_raw, &cqe->sample.humidity_centi);
+            if (cqe->res == 0)
+            {
+                cqe->sample.timestamp_us = handle->conversion_start + handle->conversion_time / 2;
+            }
+            
+            break;
+        }
+        case ENGINE_OP_RESET :
+        {
+            cqe->res = htu31d_soft_reset(handle);
+            
+            break;
+        }
+        case ENGINE_OP_HEATER :
+        {
+            cqe->res = (sqe->arg != 0) ? htu31d_set_heater_on(handle) : htu31d_set_heater_off(handle);
+            
+            break;
+        }
+        case ENGINE_OP_DIAGNOSTIC :
+        {
+            uint8_t diagnostic = 0;
+            
+            cqe->res = htu31d_get_diagnostic(handle, &diagnostic);
+            cqe->value = diagnostic;
+            
+            break;
+        }
+        default :
+        {
+            cqe->res = 5;
+            
+            break;
+        }
+    }
+}
+
+/**
+ * @brief     engine worker thread
+ * @param[in] *arg pointer to an engine structure
+ * @return    NULL
+ * @note      the worker drains the submission queue and signals the completions once per batch
+ */
+static void *a_engine_worker(void *arg)
+{
+    engine_t *engine = (engine_t *)arg;
+    engine_sqe_t sqe;
+    engine_cqe_t cqe;
+    uint64_t count;
+    
+    while (1)
+    {
+        count = 0;
+        while (a_engine_queue_pop(&engine->sq, &sqe) == 0)
+        {
+            a_engine_run(&sqe, &cqe);
+            
+            /* the inflight limit keeps a free completion cell for every submission */
+            (void)a_engine_queue_push(&engine->cq, &cqe);
+            count++;
+        }
+        if (count != 0)
+        {
+            (void)write(engine->complete_fd, &count, sizeof(count));
+        }
+        if (__atomic_load_n(&engine->stop, __ATOMIC_ACQUIRE) != 0)
+        {
+            break;
+        }
+        
+        /* sleep until engine_enter */
+        if ((read(engine->submit_fd, &count, sizeof(count)) < 0) && (errno != EINTR))
+        {
+            perror("engine: read failed");
+            
+            break;
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     init an engine and start its worker
+ * @param[in] *engine pointer to an engine structure
+ * @param[in] depth queue depth, it must be a power of two
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t engine_init(engine_t *engine, uint32_t depth)
+{
+    if ((engine == NULL) || (depth < 2) || ((depth & (depth - 1)) != 0))
+    {
+        return 1;
+    }
+    
+    memset(engine, 0, sizeof(engine_t));
+    engine->depth = depth;
+    engine->submit_fd = -1;
+    engine->complete_fd = -1;
+    if (a_engine_queue_init(&engine->sq, depth, sizeof(engine_sqe_t)) != 0)
+    {
+        return 1;
+    }
+    if (a_engine_queue_init(&engine->cq, depth, sizeof(engine_cqe_t)) != 0)
+    {
+        a_engine_queue_deinit(&engine->sq);
+        
+        return 1;
+    }
+    engine->submit_fd = eventfd(0, EFD_CLOEXEC);
+    engine->complete_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if ((engine->submit_fd < 0) || (engine->complete_fd < 0))
+    {
+        perror("engine: eventfd failed");
+        
+        goto failed;
+    }
+    if (pthread_create(&engine->worker, NULL, a_engine_worker, engine) != 0)
+    {
+        perror("engine: create worker failed");
+        
+        goto failed;
+    }
+    
+    return 0;
+    
+    failed:
+    if (engine->submit_fd >= 0)
+    {
+        (void)close(engine->submit_fd);
+    }
+    if (engine->complete_fd >= 0)
+    {
+        (void)close(engine->complete_fd);
+    }
+    a_engine_queue_deinit(&engine->sq);
+    a_engine_queue_deinit(&engine->cq);
+    
+    return 1;
+}
+
+/**
+ * @brief     stop the worker and deinit an engine
+ * @param[in] *engine pointer to an engine structure
+ * @note      the submitted entries are finished before the worker exits
+ */
+void engine_deinit(engine_t *engine)
+{
+    __atomic_store_n(&engine->stop, 1, __ATOMIC_RELEASE);
+    engine_enter(engine);
+    (void)pthread_join(engine->worker, NULL);
+    (void)close(engine->submit_fd);
+    (void)close(engine->complete_fd);
+    a_engine_queue_deinit(&engine->sq);
+    a_engine_queue_deinit(&engine->cq);
+}
+
+/**
+ * @brief     submit an operation
+ * @param[in] *engine pointer to an engine structure
+ * @param[in] *sqe pointer to a submission queue entry
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ * @note      any thread can submit, the worker only wakes up after engine_enter,
+ *            so a batch costs one system call, at most depth entries can be in flight until they are reaped
+ */
+uint8_t engine_submit(engine_t *engine, const engine_sqe_t *sqe)
+{
+    uint32_t inflight;
+    
+    /* reserve a completion cell before the submission is visible */
+    inflight = __atomic_load_n(&engine->inflight, __ATOMIC_RELAXED);
+    do
+    {
+        if (inflight >= engine->depth)
+        {
+            return 1;
+        }
+    } while (!__atomic_compare_exchange_n(&engine->inflight, &inflight, inflight + 1, 1,
+                                          __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+    if (a_engine_queue_push(&engine->sq, sqe) != 0)
+    {
+        __atomic_fetch_sub(&engine->inflight, 1, __ATOMIC_RELAXED);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     wake the worker for the submitted entries
+ * @param[in] *engine pointer to an engine structure
+ * @note      none
+ */
+void engine_enter(engine_t *engine)
+{
+    uint64_t one = 1;
+    
+    (void)write(engine->submit_fd, &one, sizeof(one));
+}
+
+/**
+ * @brief      reap finished operations
+ * @param[in]  *engine pointer to an engine structure
+ * @param[out] *cqe pointer to a completion queue entry array
+ * @param[in]  len array length
+ * @return     reaped entry number
+ * @note       it never blocks, the operations of one engine finish in submission order
+ */
+uint32_t engine_reap(engine_t *engine, engine_cqe_t *cqe, uint32_t len)
+{
+    uint32_t num;
+    
+    num = 0;
+    while ((num < len) && (a_engine_queue_pop(&engine->cq, &cqe[num]) == 0))
+    {
+        num++;
+    }
+    if (num != 0)
+    {
+        __atomic_fetch_sub(&engine->inflight, num, __ATOMIC_RELAXED);
+    }
+    
+    return num;
+}
+
+/**
+ * @brief     get the completion file descriptor
+ * @param[in] *engine pointer to an engine structure
+ * @return    eventfd that is readable when completions are queued
+ * @note      read it to clear the event before reaping
+ */
+int engine_get_fd(engine_t *engine)
+{
+    return engine->complete_fd;
+}
@@ -35,8 +35,6 @@
  */
 
 #include "iic.h"
-#include <linux/i2c.h>
-#include <linux/i2c-dev.h>
 #include <sys/ioctl.h>
 #include <fcntl.h>
 
@@ -363,3 +361,329 @@ uint8_t iic_write_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, ui
      
     return 0;
 }
+
+/**
+ * @brief     iic bus open
+ * @param[in] *bus pointer to an iic bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the device is opened by the first caller and shared by the next ones
+ */
+uint8_t iic_bus_open(iic_bus_t *bus)
+{
+    uint8_t res;
+    
+    /* lock the bus */
+    (void)pthread_mutex_lock(&bus->mutex);
+    
+    /* open the device on first use */
+    res = 0;
+    if (bus->ref == 0)
+    {
+        res = iic_init(bus->name, &bus->fd);
+    }
+    if (res == 0)
+    {
+        bus->ref++;
+    }
+    
+    /* unlock the bus */
+    (void)pthread_mutex_unlock(&bus->mutex);
+    
+    return res;
+}
+
+/**
+ * @brief     iic bus close
+ * @param[in] *bus pointer to an iic bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      the device is closed when the last user closes it
+ */
+uint8_t iic_bus_close(iic_bus_t *bus)
+{
+    uint8_t res;
+    
+    /* lock the bus */
+    (void)pthread_mutex_lock(&bus->mutex);
+    
+    /* check the reference */
+    if (bus->ref == 0)
+    {
+        (void)pthread_mutex_unlock(&bus->mutex);
+        
+        return 1;
+    }
+    
+    /* close the device on last use */
+    res = 0;
+    bus->ref--;
+    if (bus->ref == 0)
+    {
+        res = iic_deinit(bus->fd);
+        bus->fd = -1;
+    }
+    
+    /* unlock the bus */
+    (void)pthread_mutex_unlock(&bus->mutex);
+    
+    return res;
+}
+
+/**
+ * @brief     iic device set the address of the templates
+ * @param[in] *device pointer to an iic device structure
+ * @param[in] addr iic device write address
+ * @note      none
+ */
+static void a_iic_device_set_addr(iic_device_t *device, uint8_t addr)
+{
+    device->addr = addr;
+    device->msgs[0].addr = addr >> 1;
+    device->msgs[1].addr = addr >> 1;
+    device->msgs[2].addr = addr >> 1;
+}
+
+/**
+ * @brief     iic device init
+ * @param[in] *device pointer to an iic device structure
+ * @param[in] *bus pointer to an iic bus structure
+ * @param[in] addr iic device write address
+ * @note      addr = device_address_7bits << 1, the bus can be opened later
+ */
+void iic_device_init(iic_device_t *device, iic_bus_t *bus, uint8_t addr)
+{
+    /* clear the device */
+    memset(device, 0, sizeof(iic_device_t));
+    
+    /* command message */
+    device->bus = bus;
+    device->msgs[0].flags = 0;
+    device->msgs[0].buf = &device->cmd;
+    device->msgs[0].len = 1;
+    
+    /* read message */
+    device->msgs[1].flags = I2C_M_RD;
+    
+    /* payload message */
+    device->msgs[2].flags = 0;
+    device->msgs[2].buf = device->payload;
+    
+    /* transfers */
+    device->cmd_data.msgs = &device->msgs[0];
+    device->cmd_data.nmsgs = 1;
+    device->read_data.msgs = &device->msgs[0];
+    device->read_data.nmsgs = 2;
+    device->write_data.msgs = &device->msgs[2];
+    device->write_data.nmsgs = 1;
+    
+    /* set the address */
+    a_iic_device_set_addr(device, addr);
+}
+
+/**
+ * @brief     iic device write
+ * @param[in] *device pointer to an iic device structure
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      a different addr retargets the templates, payloads longer than
+ *            IIC_DEVICE_PAYLOAD_MAX fall back to iic_write
+ */
+uint8_t iic_device_write(iic_device_t *device, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    struct i2c_rdwr_ioctl_data *data;
+    
+    /* check the address */
+    if (addr != device->addr)
+    {
+        a_iic_device_set_addr(device, addr);
+    }
+    
+    /* select the transfer */
+    if (len == 0)
+    {
+        device->cmd = reg;
+        data = &device->cmd_data;
+    }
+    else if (len <= IIC_DEVICE_PAYLOAD_MAX)
+    {
+        device->payload[0] = reg;
+        memcpy(&device->payload[1], buf, len);
+        device->msgs[2].len = len + 1;
+        data = &device->write_data;
+    }
+    else
+    {
+        return iic_write(device->bus->fd, addr, reg, buf, len);
+    }
+    
+    /* transmit */
+    if (ioctl(device->bus->fd, I2C_RDWR, data) < 0)
+    {
+        perror("iic: write failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      iic device read
+ * @param[in]  *device pointer to an iic device structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the data is read straight into buf
+ */
+uint8_t iic_device_read(iic_device_t *device, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    /* check the address */
+    if (addr != device->addr)
+    {
+        a_iic_device_set_addr(device, addr);
+    }
+    
+    /* set the param */
+    device->cmd = reg;
+    device->msgs[1].buf = buf;
+    device->msgs[1].len = len;
+    
+    /* transmit */
+    if (ioctl(device->bus->fd, I2C_RDWR, &device->read_data) < 0)
+    {
+        perror("iic: read failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     iic batch init
+ * @param[in] *batch pointer to an iic batch structure
+ * @note      none
+ */
+void iic_batch_init(iic_batch_t *batch)
+{
+    batch->num = 0;
+}
+
+/**
+ * @brief     iic batch add a mux channel select
+ * @param[in] *batch pointer to an iic batch structure
+ * @param[in] addr mux write address
+ * @param[in] channel channel mask
+ * @return    status code
+ *            - 0 success
+ *            - 1 batch is full
+ * @note      addr = device_address_7bits << 1, the message ends with a stop so muxes that
+ *            switch on the stop condition see it, this needs I2C_FUNC_PROTOCOL_MANGLING
+ */
+uint8_t iic_batch_add_select(iic_batch_t *batch, uint8_t addr, uint8_t channel)
+{
+    struct i2c_msg *msg;
+    
+    /* check the space */
+    if (batch->num + 1 > I2C_RDWR_IOCTL_MAX_MSGS)
+    {
+        return 1;
+    }
+    
+    /* set the param */
+    msg = &batch->msgs[batch->num];
+    batch->cmd[batch->num] = channel;
+    msg->addr = addr >> 1;
+    msg->flags = I2C_M_STOP;
+    msg->buf = &batch->cmd[batch->num];
+    msg->len = 1;
+    batch->num++;
+    
+    return 0;
+}
+
+/**
+ * @brief      iic batch add a command read
+ * @param[in]  *batch pointer to an iic batch structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 batch is full
+ * @note       addr = device_address_7bits << 1
+ */
+uint8_t iic_batch_add_read(iic_batch_t *batch, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    struct i2c_msg *msg;
+    
+    /* check the space */
+    if (batch->num + 2 > I2C_RDWR_IOCTL_MAX_MSGS)
+    {
+        return 1;
+    }
+    
+    /* set the command */
+    msg = &batch->msgs[batch->num];
+    batch->cmd[batch->num] = reg;
+    msg[0].addr = addr >> 1;
+    msg[0].flags = 0;
+    msg[0].buf = &batch->cmd[batch->num];
+    msg[0].len = 1;
+    
+    /* set the read */
+    msg[1].addr = addr >> 1;
+    msg[1].flags = I2C_M_RD;
+    msg[1].buf = buf;
+    msg[1].len = len;
+    batch->num += 2;
+    
+    return 0;
+}
+
+/**
+ * @brief     iic batch transfer
+ * @param[in] fd iic handle
+ * @param[in] *batch pointer to an iic batch structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      one nacked message fails the whole batch
+ */
+uint8_t iic_batch_transfer(int fd, iic_batch_t *batch)
+{
+    struct i2c_rdwr_ioctl_data i2c_rdwr_data;
+    
+    /* check the batch */
+    if (batch->num == 0)
+    {
+        return 0;
+    }
+    
+    /* set the param */
+    i2c_rdwr_data.msgs = batch->msgs;
+    i2c_rdwr_data.nmsgs = batch->num;
+    
+    /* transmit */
+    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+    {
+        perror("iic: batch transfer failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,265 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      pollable.c
+ * @brief     pollable source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "pollable.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief     arm the timer at an absolute time
+ * @param[in] *pollable pointer to a pollable structure
+ * @param[in] ns CLOCK_MONOTONIC expiration time in ns, 0 disarms the timer
+ * @return    status code
+ *            - 0 success
+ *            - 1 arm failed
+ * @note      none
+ */
+static uint8_t a_pollable_arm(pollable_t *pollable, uint64_t ns)
+{
+    struct itimerspec spec;
+    
+    memset(&spec, 0, sizeof(spec));
+    spec.it_value.tv_sec = (time_t)(ns / 1000000000ULL);
+    spec.it_value.tv_nsec = (long)(ns % 1000000000ULL);
+    if (timerfd_settime(pollable->fd, TFD_TIMER_ABSTIME, &spec, NULL) != 0)
+    {
+        perror("pollable: settime failed");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  get the monotonic time
+ * @return CLOCK_MONOTONIC time in ns, never 0
+ * @note   none
+ */
+static uint64_t a_pollable_now(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec + 1;
+}
+
+/**
+ * @brief     init a pollable sensor group
+ * @param[in] *pollable pointer to a pollable structure
+ * @param[in] **handle pointer to an inited htu31d handle pointer array
+ * @param[in] num sensor number
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the handle array must live until pollable_deinit, the handles must link a CLOCK_MONOTONIC timestamp_us
+ */
+uint8_t pollable_init(pollable_t *pollable, htu31d_handle_t **handle, uint8_t num)
+{
+    if ((pollable == NULL) || (handle == NULL) || (num == 0))
+    {
+        return 1;
+    }
+    
+    memset(pollable, 0, sizeof(pollable_t));
+    pollable->fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (pollable->fd < 0)
+    {
+        perror("pollable: create failed");
+        
+        return 1;
+    }
+    pollable->handle = handle;
+    pollable->num = num;
+    pollable->state = POLLABLE_STATE_IDLE;
+    
+    return 0;
+}
+
+/**
+ * @brief     deinit a pollable sensor group
+ * @param[in] *pollable pointer to a pollable structure
+ * @note      none
+ */
+void pollable_deinit(pollable_t *pollable)
+{
+    if (pollable->fd >= 0)
+    {
+        (void)close(pollable->fd);
+        pollable->fd = -1;
+    }
+    pollable->state = POLLABLE_STATE_IDLE;
+}
+
+/**
+ * @brief     get the file descriptor
+ * @param[in] *pollable pointer to a pollable structure
+ * @return    timerfd to wait for with poll, select or epoll as readable
+ * @note      none
+ */
+int pollable_get_fd(pollable_t *pollable)
+{
+    return pollable->fd;
+}
+
+/**
+ * @brief     start the sampling
+ * @param[in] *pollable pointer to a pollable structure
+ * @param[in] period_us sampling period in us, 0 takes one sample
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the first release time is now, so the fd is readable at once
+ */
+uint8_t pollable_start(pollable_t *pollable, uint32_t period_us)
+{
+    pollable->period_us = period_us;
+    pollable->overrun = 0;
+    pollable->release_ns = a_pollable_now();
+    if (a_pollable_arm(pollable, pollable->release_ns) != 0)
+    {
+        return 1;
+    }
+    pollable->state = POLLABLE_STATE_RELEASE;
+    
+    return 0;
+}
+
+/**
+ * @brief     stop the sampling
+ * @param[in] *pollable pointer to a pollable structure
+ * @note      a running conversion is left to finish in the sensors
+ */
+void pollable_stop(pollable_t *pollable)
+{
+    (void)a_pollable_arm(pollable, 0);
+    pollable->state = POLLABLE_STATE_IDLE;
+}
+
+/**
+ * @brief      handle a readable fd
+ * @param[in]  *pollable pointer to a pollable structure
+ * @param[out] *sample pointer to a sample array with num entries
+ * @param[out] *status pointer to a status array with num entries
+ * @param[out] *ready pointer to a ready flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 dispatch failed
+ * @note       nothing in it blocks, on a release time the conversions are started and the timer is armed
+ *             for the slowest one, on the conversion deadline the results are fetched, ready is set and
+ *             sample/status are filled with the htu31d_group_fetch results, a spurious wake up returns 0
+ *             with ready cleared
+ */
+uint8_t pollable_dispatch(pollable_t *pollable, htu31d_sample_t *sample, uint8_t *status, uint8_t *ready)
+{
+    uint64_t expirations;
+    uint64_t now;
+    uint64_t period_ns;
+    uint64_t missed;
+    uint32_t wait_us;
+    
+    *ready = 0;
+    if (read(pollable->fd, &expirations, sizeof(expirations)) != (ssize_t)sizeof(expirations))
+    {
+        if (errno == EAGAIN)
+        {
+            return 0;
+        }
+        perror("pollable: read failed");
+        
+        return 1;
+    }
+    
+    if (pollable->state == POLLABLE_STATE_RELEASE)
+    {
+        /* start the conversions and wake up when the slowest one is finished */
+        if (htu31d_group_start_conversion(pollable->handle, pollable->num, status, &wait_us) == 2)
+        {
+            return 1;
+        }
+        if (a_pollable_arm(pollable, a_pollable_now() + (uint64_t)wait_us * 1000ULL) != 0)
+        {
+            return 1;
+        }
+        pollable->state = POLLABLE_STATE_CONVERTING;
+        
+        return 0;
+    }
+    else if (pollable->state == POLLABLE_STATE_CONVERTING)
+    {
+        /* the deadline has passed, so the fetch doesn't wait */
+        if (htu31d_group_fetch(pollable->handle, pollable->num, sample, status) == 2)
+        {
+            return 1;
+        }
+        *ready = 1;
+        if (pollable->period_us == 0)
+        {
+            pollable->state = POLLABLE_STATE_IDLE;
+            
+            return 0;
+        }
+        
+        /* arm the next release time and skip the passed ones */
+        period_ns = (uint64_t)pollable->period_us * 1000ULL;
+        pollable->release_ns += period_ns;
+        now = a_pollable_now();
+        if (now >= pollable->release_ns + period_ns)
+        {
+            missed = (now - pollable->release_ns) / period_ns;
+            pollable->overrun += (uint32_t)missed;
+            pollable->release_ns += missed * period_ns;
+        }
+        if (a_pollable_arm(pollable, pollable->release_ns) != 0)
+        {
+            return 1;
+        }
+        pollable->state = POLLABLE_STATE_RELEASE;
+        
+        return 0;
+    }
+    else
+    {
+        return 0;
+    }
+}
@@ -0,0 +1,139 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      ring.c
+ * @brief     ring source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "ring.h"
+#include <string.h>
+
+/**
+ * @brief     init the ring
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] *buf pointer to a sample buffer
+ * @param[in] size sample buffer length, it must be a power of two
+ * @return    status code
+ *            - 0 success
+ *            - 1 param is invalid
+ * @note      the caller owns the buffer
+ */
+uint8_t ring_init(ring_t *ring, ring_sample_t *buf, uint32_t size)
+{
+    if ((ring == NULL) || (buf == NULL) || (size < 2) || ((size & (size - 1)) != 0))
+    {
+        return 1;
+    }
+    
+    memset(ring, 0, sizeof(ring_t));
+    ring->storage.buf = buf;
+    ring->storage.mask = size - 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     push a sample
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] *sample pointer to a sample structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 ring is full
+ * @note      only one producer thread may call it, a full ring drops the new sample and never blocks
+ */
+uint8_t ring_push(ring_t *ring, const ring_sample_t *sample)
+{
+    uint32_t head;
+    
+    head = ring->producer.head;
+    if ((head - ring->producer.tail_cache) > ring->storage.mask)
+    {
+        /* refresh the consumer index only when the cached one says full */
+        ring->producer.tail_cache = __atomic_load_n(&ring->consumer.tail, __ATOMIC_ACQUIRE);
+        if ((head - ring->producer.tail_cache) > ring->storage.mask)
+        {
+            __atomic_store_n(&ring->producer.dropped, ring->producer.dropped + 1, __ATOMIC_RELAXED);
+            
+            return 1;
+        }
+    }
+    ring->storage.buf[head & ring->storage.mask] = *sample;
+    __atomic_store_n(&ring->producer.head, head + 1, __ATOMIC_RELEASE);
+    
+    return 0;
+}
+
+/**
+ * @brief      pop up to len samples
+ * @param[in]  *ring pointer to a ring structure
+ * @param[out] *samples pointer to a sample array
+ * @param[in]  len sample array length
+ * @return     popped sample number
+ * @note       only one consumer thread may call it, it never blocks
+ */
+uint32_t ring_pop_batch(ring_t *ring, ring_sample_t *samples, uint32_t len)
+{
+    uint32_t tail;
+    uint32_t num;
+    uint32_t i;
+    
+    tail = ring->consumer.tail;
+    num = ring->consumer.head_cache - tail;
+    if (num < len)
+    {
+        /* refresh the producer index only when the cached one can't fill the batch */
+        ring->consumer.head_cache = __atomic_load_n(&ring->producer.head, __ATOMIC_ACQUIRE);
+        num = ring->consumer.head_cache - tail;
+    }
+    if (num > len)
+    {
+        num = len;
+    }
+    for (i = 0; i < num; i++)
+    {
+        samples[i] = ring->storage.buf[(tail + i) & ring->storage.mask];
+    }
+    __atomic_store_n(&ring->consumer.tail, tail + num, __ATOMIC_RELEASE);
+    
+    return num;
+}
+
+/**
+ * @brief     get the dropped sample number
+ * @param[in] *ring pointer to a ring structure
+ * @return    dropped sample number
+ * @note      it can be called from any thread
+ */
+uint64_t ring_get_dropped(ring_t *ring)
+{
+    return __atomic_load_n(&ring->producer.dropped, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,156 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      shm.c
+ * @brief     shm source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "shm.h"
+#include <stdio.h>
+#include <sys/stat.h>
+
+/**
+ * @brief     open the publisher
+ * @param[in] *publisher pointer to a shm publisher structure
+ * @param[in] *name pointer to a shm object name, NULL means SHM_DEFAULT_NAME
+ * @param[in] slot_num used slots
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      a stale object of the same name is unlinked and a fresh one is created,
+ *            readers still mapping the stale one must reopen
+ */
+uint8_t shm_publisher_open(shm_publisher_t *publisher, const char *name, uint32_t slot_num)
+{
+    int fd;
+    void *addr;
+    
+    if ((publisher == NULL) || (slot_num == 0) || (slot_num > SHM_SLOT_MAX))
+    {
+        return 1;
+    }
+    
+    memset(publisher, 0, sizeof(shm_publisher_t));
+    (void)snprintf(publisher->name, sizeof(publisher->name), "%s", (name != NULL) ? name : SHM_DEFAULT_NAME);
+    
+    /* never rewrite an object that old readers may map, a dead publisher can leave odd seqs there */
+    (void)shm_unlink(publisher->name);
+    fd = shm_open(publisher->name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0)
+    {
+        perror("shm: open failed");
+        
+        return 1;
+    }
+    if (ftruncate(fd, sizeof(shm_region_t)) != 0)
+    {
+        perror("shm: truncate failed");
+        (void)close(fd);
+        (void)shm_unlink(publisher->name);
+        
+        return 1;
+    }
+    addr = mmap(NULL, sizeof(shm_region_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED)
+    {
+        perror("shm: map failed");
+        (void)shm_unlink(publisher->name);
+        
+        return 1;
+    }
+    publisher->region = (shm_region_t *)addr;
+    
+    /* the fresh object is zero filled, publish the layout last */
+    publisher->region->version = SHM_VERSION;
+    publisher->region->slot_num = slot_num;
+    __atomic_store_n(&publisher->region->magic, SHM_MAGIC, __ATOMIC_RELEASE);
+    
+    return 0;
+}
+
+/**
+ * @brief     publish a reading
+ * @param[in] *publisher pointer to a shm publisher structure
+ * @param[in] slot slot index
+ * @param[in] *reading pointer to a reading structure, its count is ignored
+ * @return    status code
+ *            - 0 success
+ *            - 1 slot is invalid
+ * @note      only one thread may publish into a slot
+ */
+uint8_t shm_publish(shm_publisher_t *publisher, uint32_t slot, const shm_reading_t *reading)
+{
+    shm_slot_t *s;
+    uint32_t seq;
+    
+    if ((publisher->region == NULL) || (slot >= publisher->region->slot_num))
+    {
+        return 1;
+    }
+    
+    s = &publisher->region->slot[slot];
+    seq = s->seq;
+    __atomic_store_n(&s->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&s->reading.timestamp_us, reading->timestamp_us, __ATOMIC_RELAXED);
+    __atomic_store_n(&s->reading.count, s->reading.count + 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&s->reading.temperature_raw, reading->temperature_raw, __ATOMIC_RELAXED);
+    __atomic_store_n(&s->reading.humidity_raw, reading->humidity_raw, __ATOMIC_RELAXED);
+    __atomic_store_n(&s->reading.temperature_centi, reading->temperature_centi, __ATOMIC_RELAXED);
+    __atomic_store_n(&s->reading.humidity_centi, reading->humidity_centi, __ATOMIC_RELAXED);
+    __atomic_store_n(&s->reading.diagnostic, reading->diagnostic, __ATOMIC_RELAXED);
+    __atomic_store_n(&s->seq, seq + 2, __ATOMIC_RELEASE);
+    
+    return 0;
+}
+
+/**
+ * @brief     close the publisher
+ * @param[in] *publisher pointer to a shm publisher structure
+ * @param[in] unlink_name remove the shm object when it is not 0
+ * @note      mapped readers keep the old region until they close it
+ */
+void shm_publisher_close(shm_publisher_t *publisher, uint8_t unlink_name)
+{
+    if (publisher->region != NULL)
+    {
+        (void)munmap(publisher->region, sizeof(shm_region_t));
+        publisher->region = NULL;
+    }
+    if (unlink_name != 0)
+    {
+        (void)shm_unlink(publisher->name);
+    }
+}
@@ -36,10 +36,85 @@
 
 #include "driver_htu31d_register_test.h"
 #include "driver_htu31d_read_test.h"
+#include "driver_htu31d_simulator_test.h"
+#include "driver_htu31d_soak_test.h"
+#include "ring_test.h"
+#include "shm_test.h"
+#include "pollable_test.h"
+#include "engine_test.h"
+#include "edf_test.h"
 #include "driver_htu31d_basic.h"
+#include "delay.h"
+#include "iic.h"
+#include "ring.h"
+#include "shm.h"
 #include <getopt.h>
+#include <pthread.h>
 #include <stdlib.h>
 
+/**
+ * @brief ring example definition
+ */
+#define RING_EXAMPLE_SIZE         16        /**< 16 samples */
+#define RING_EXAMPLE_BATCH        4         /**< 4 samples */
+
+/**
+ * @brief ring example global variables definition
+ */
+static ring_t gs_ring;                                                                    /**< sample ring */
+static ring_sample_t gs_ring_buf[RING_EXAMPLE_SIZE] __attribute__((aligned(RING_CACHE_LINE)));    /**< sample buffer */
+static uint32_t gs_ring_times;                                                            /**< producer sample number */
+static volatile uint8_t gs_ring_res;                                                      /**< producer result */
+static volatile uint8_t gs_ring_done;                                                     /**< producer finished flag */
+
+/**
+ * @brief group example global variables definition
+ */
+static iic_bus_t gs_group_bus = IIC_BUS_INITIALIZER("/dev/i2c-1");                       /**< shared iic bus */
+static iic_device_t gs_group_device[2];                                                   /**< iic devices */
+static htu31d_handle_t gs_group_handle[2];                                                /**< htu31d handles */
+
+/**
+ * @brief     ring example producer thread
+ * @param[in] *arg unused
+ * @return    NULL
+ * @note      the thread only samples and pushes, a full ring drops the sample instead of waiting
+ */
+static void *a_ring_producer(void *arg)
+{
+    uint32_t i;
+    uint32_t timestamp;
+    uint64_t now;
+    ring_sample_t sample;
+    
+    (void)arg;
+    memset(&sample, 0, sizeof(ring_sample_t));
+    for (i = 0; i < gs_ring_times; i++)
+    {
+        /* read the next raw sample */
+        if (htu31d_basic_periodic_read_raw(&sample.temperature_raw, &sample.humidity_raw, &timestamp) != 0)
+        {
+            gs_ring_res = 1;
+            
+            break;
+        }
+        if (htu31d_basic_get_diagnostic(&sample.diagnostic) != 0)
+        {
+            gs_ring_res = 1;
+            
+            break;
+        }
+        
+        /* widen the 32 bits driver timestamp with the 64 bits monotonic clock */
+        now = delay_now_ns() / 1000;
+        sample.timestamp_us = now - (uint32_t)((uint32_t)now - timestamp);
+        (void)ring_push(&gs_ring, &sample);
+    }
+    __atomic_store_n(&gs_ring_done, 1, __ATOMIC_RELEASE);
+    
+    return NULL;
+}
+
 /**
  * @brief     htu31d full function
  * @param[in] argc arg numbers
@@ -64,11 +139,14 @@ uint8_t htu31d(uint8_t argc, char **argv)
         {"test", required_argument, NULL, 't'},
         {"addr", required_argument, NULL, 1},
         {"times", required_argument, NULL, 2},
+        {"sim", no_argument, NULL, 3},
+        {"spin", required_argument, NULL, 4},
         {NULL, 0, NULL, 0},
     };
     char type[33] = "unknown";
     htu31d_addr_pin_t addr = HTU31D_ADDR_PIN_LOW;
     uint32_t times = 3;
+    uint8_t sim = 0;
     
     /* if no params */
     if (argc == 1)
@@ -167,6 +245,24 @@ uint8_t htu31d(uint8_t argc, char **argv)
                 break;
             } 
             
+            /* simulator */
+            case 3 :
+            {
+                /* use the simulator */
+                sim = 1;
+                
+                break;
+            } 
+            
+            /* spin tail */
+            case 4 :
+            {
+                /* busy wait the last ns of every delay */
+                delay_set_spin(atol(optarg));
+                
+                break;
+            } 
+            
             /* the end */
             case -1 :
             {
@@ -196,11 +292,124 @@ uint8_t htu31d(uint8_t argc, char **argv)
     }
     else if (strcmp("t_read", type) == 0)
     {
+        static htu31d_simulator_t simulator;
+        
+        /* link the simulator */
+        if (sim != 0)
+        {
+            htu31d_simulator_init(&simulator, addr);
+            simulator.temperature.amplitude = 5.0f;
+            simulator.temperature.period_s = 60.0f;
+            simulator.temperature.noise = 0.05f;
+            simulator.humidity.amplitude = 10.0f;
+            simulator.humidity.period_s = 90.0f;
+            simulator.humidity.noise = 0.5f;
+            htu31d_read_test_set_simulator(&simulator);
+        }
+        
         /* run read test */
         if (htu31d_read_test(addr, times) != 0)
         {
             return 1;
         }
+        
+        /* output the oversleep */
+        if (sim == 0)
+        {
+            delay_stats_t stats;
+            
+            delay_get_stats(&stats, 0);
+            if (stats.count != 0)
+            {
+                htu31d_interface_debug_print("htu31d: %d delays, mean oversleep %dus, max oversleep %dus, mean spin %dus.\n",
+                                             (uint32_t)stats.count,
+                                             (uint32_t)(stats.oversleep_total_ns / stats.count / 1000),
+                                             (uint32_t)(stats.oversleep_max_ns / 1000),
+                                             (uint32_t)(stats.spin_ns / stats.count / 1000));
+            }
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_sim", type) == 0)
+    {
+        /* run simulator test */
+        if (htu31d_simulator_test() != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_soak", type) == 0)
+    {
+        /* run soak test */
+        if (htu31d_soak_test(times) != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_ring", type) == 0)
+    {
+        /* run ring test */
+        if (ring_test() != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_shm", type) == 0)
+    {
+        /* run shm test */
+        if (shm_test() != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_pollable", type) == 0)
+    {
+        /* run pollable test */
+        if (pollable_test() != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_engine", type) == 0)
+    {
+        /* run engine test */
+        if (engine_test() != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_edf", type) == 0)
+    {
+        /* run edf test */
+        if (edf_test() != 0)
+        {
+            return 1;
+        }
         else
         {
             return 0;
@@ -210,6 +419,8 @@ uint8_t htu31d(uint8_t argc, char **argv)
     {
         uint8_t res;
         uint32_t i;
+        uint32_t timestamp;
+        uint32_t overrun;
         float temperature;
         float humidity;
         
@@ -220,14 +431,20 @@ uint8_t htu31d(uint8_t argc, char **argv)
             return 1;
         }
         
+        /* sample every 1000ms */
+        res = htu31d_basic_periodic_start(1000);
+        if (res != 0)
+        {
+            (void)htu31d_basic_deinit();
+            
+            return 1;
+        }
+        
         /* loop */
         for (i = 0; i < times; i++)
         {
-            /* delay 1000ms */
-            htu31d_interface_delay_ms(1000);
-            
             /* read data */
-            res = htu31d_basic_read((float *)&temperature, (float *)&humidity);
+            res = htu31d_basic_periodic_read((float *)&temperature, (float *)&humidity, (uint32_t *)&timestamp);
             if (res != 0)
             {
                 (void)htu31d_basic_deinit();
@@ -237,10 +454,238 @@ uint8_t htu31d(uint8_t argc, char **argv)
             
             /* output */
             htu31d_interface_debug_print("htu31d: %d/%d.\n", (uint32_t)(i + 1), (uint32_t)times);
+            htu31d_interface_debug_print("htu31d: timestamp is %uus.\n", timestamp);
             htu31d_interface_debug_print("htu31d: temperature is %0.2fC.\n", temperature);
             htu31d_interface_debug_print("htu31d: humidity is %0.2f%%.\n", humidity);
         }
         
+        /* output the overrun */
+        (void)htu31d_basic_periodic_get_overrun((uint32_t *)&overrun);
+        htu31d_interface_debug_print("htu31d: periodic overrun is %d.\n", overrun);
+        
+        /* basic deinit */
+        (void)htu31d_basic_deinit();
+        
+        return 0;
+    }
+    else if (strcmp("e_group", type) == 0)
+    {
+        uint8_t res;
+        uint8_t i;
+        uint32_t t;
+        uint8_t status[2];
+        htu31d_handle_t *handle[2];
+        htu31d_sample_t sample[2];
+        
+        /* link the sensors at both addresses to one bus, their results are read in one ioctl */
+        for (i = 0; i < 2; i++)
+        {
+            iic_device_init(&gs_group_device[i], &gs_group_bus, 0x00);
+            DRIVER_HTU31D_LINK_INIT(&gs_group_handle[i], htu31d_handle_t);
+            DRIVER_HTU31D_LINK_IIC_INIT(&gs_group_handle[i], htu31d_interface_iic_init);
+            DRIVER_HTU31D_LINK_IIC_DEINIT(&gs_group_handle[i], htu31d_interface_iic_deinit);
+            DRIVER_HTU31D_LINK_IIC_WRITE(&gs_group_handle[i], htu31d_interface_iic_write);
+            DRIVER_HTU31D_LINK_IIC_READ(&gs_group_handle[i], htu31d_interface_iic_read);
+            DRIVER_HTU31D_LINK_DELAY_MS(&gs_group_handle[i], htu31d_interface_delay_ms);
+            DRIVER_HTU31D_LINK_DELAY_US(&gs_group_handle[i], htu31d_interface_delay_us);
+            DRIVER_HTU31D_LINK_TIMESTAMP_US(&gs_group_handle[i], htu31d_interface_timestamp_us);
+            DRIVER_HTU31D_LINK_DEBUG_PRINT(&gs_group_handle[i], htu31d_interface_debug_print);
+            DRIVER_HTU31D_LINK_USER_DATA(&gs_group_handle[i], &gs_group_device[i]);
+            DRIVER_HTU31D_LINK_IIC_INIT_CTX(&gs_group_handle[i], htu31d_interface_iic_init_ctx);
+            DRIVER_HTU31D_LINK_IIC_DEINIT_CTX(&gs_group_handle[i], htu31d_interface_iic_deinit_ctx);
+            DRIVER_HTU31D_LINK_IIC_WRITE_CTX(&gs_group_handle[i], htu31d_interface_iic_write_ctx);
+            DRIVER_HTU31D_LINK_IIC_READ_CTX(&gs_group_handle[i], htu31d_interface_iic_read_ctx);
+            DRIVER_HTU31D_LINK_IIC_READ_BATCH_CTX(&gs_group_handle[i], htu31d_interface_iic_read_batch_ctx);
+            (void)htu31d_set_addr_pin(&gs_group_handle[i], (i == 0) ? HTU31D_ADDR_PIN_LOW : HTU31D_ADDR_PIN_HIGH);
+            handle[i] = &gs_group_handle[i];
+        }
+        
+        /* init the group */
+        res = htu31d_group_init(handle, 2, status);
+        if (res != 0)
+        {
+            htu31d_interface_debug_print("htu31d: group init failed %d %d.\n", status[0], status[1]);
+            (void)htu31d_group_deinit(handle, 2, status);
+            
+            return 1;
+        }
+        
+        /* loop */
+        for (t = 0; t < times; t++)
+        {
+            /* read the group */
+            res = htu31d_group_read(handle, 2, sample, status);
+            htu31d_interface_debug_print("htu31d: %d/%d.\n", (uint32_t)(t + 1), (uint32_t)times);
+            for (i = 0; i < 2; i++)
+            {
+                if (status[i] != 0)
+                {
+                    htu31d_interface_debug_print("htu31d: sensor %d read failed %d.\n", i, status[i]);
+                    
+                    continue;
+                }
+                htu31d_interface_debug_print("htu31d: sensor %d temperature is %0.2fC.\n", i, (float)sample[i].temperature_centi / 100.0f);
+                htu31d_interface_debug_print("htu31d: sensor %d humidity is %0.2f%%.\n", i, (float)sample[i].humidity_centi / 100.0f);
+            }
+            if (res != 0)
+            {
+                (void)htu31d_group_deinit(handle, 2, status);
+                
+                return 1;
+            }
+            htu31d_interface_delay_ms(1000);
+        }
+        
+        /* deinit the group */
+        (void)htu31d_group_deinit(handle, 2, status);
+        
+        return 0;
+    }
+    else if (strcmp("e_ring", type) == 0)
+    {
+        uint8_t res;
+        uint8_t done;
+        uint32_t i;
+        uint32_t num;
+        uint32_t total;
+        pthread_t producer;
+        ring_sample_t samples[RING_EXAMPLE_BATCH];
+        
+        /* basic */
+        res = htu31d_basic_init(addr);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* sample every 1000ms */
+        res = htu31d_basic_periodic_start(1000);
+        if (res != 0)
+        {
+            (void)htu31d_basic_deinit();
+            
+            return 1;
+        }
+        
+        /* start the producer */
+        (void)ring_init(&gs_ring, gs_ring_buf, RING_EXAMPLE_SIZE);
+        gs_ring_times = times;
+        gs_ring_res = 0;
+        gs_ring_done = 0;
+        if (pthread_create(&producer, NULL, a_ring_producer, NULL) != 0)
+        {
+            (void)htu31d_basic_deinit();
+            
+            return 1;
+        }
+        
+        /* consume in batches at a slower pace than the producer */
+        total = 0;
+        do
+        {
+            htu31d_interface_delay_ms(2500);
+            done = __atomic_load_n(&gs_ring_done, __ATOMIC_ACQUIRE);
+            while ((num = ring_pop_batch(&gs_ring, samples, RING_EXAMPLE_BATCH)) != 0)
+            {
+                for (i = 0; i < num; i++)
+                {
+                    int16_t temperature;
+                    uint16_t humidity;
+                    
+                    htu31d_convert_batch_fixed(1, &samples[i].temperature_raw, &samples[i].humidity_raw,
+                                               &temperature, &humidity);
+                    total++;
+                    htu31d_interface_debug_print("htu31d: %d/%d.\n", total, times);
+                    htu31d_interface_debug_print("htu31d: timestamp is %lluus.\n",
+                                                 (unsigned long long)samples[i].timestamp_us);
+                    htu31d_interface_debug_print("htu31d: temperature is %0.2fC.\n", (float)temperature / 100.0f);
+                    htu31d_interface_debug_print("htu31d: humidity is %0.2f%%.\n", (float)humidity / 100.0f);
+                    htu31d_interface_debug_print("htu31d: diagnostic is 0x%02X.\n", samples[i].diagnostic);
+                }
+            }
+        } while (done == 0);
+        (void)pthread_join(producer, NULL);
+        htu31d_interface_debug_print("htu31d: ring dropped %d samples.\n", (uint32_t)ring_get_dropped(&gs_ring));
+        
+        /* basic deinit */
+        (void)htu31d_basic_deinit();
+        
+        return gs_ring_res;
+    }
+    else if (strcmp("e_shm", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        uint32_t timestamp;
+        uint64_t now;
+        shm_publisher_t publisher;
+        shm_reading_t reading;
+        
+        /* basic */
+        res = htu31d_basic_init(addr);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* open the publisher */
+        res = shm_publisher_open(&publisher, SHM_DEFAULT_NAME, 1);
+        if (res != 0)
+        {
+            (void)htu31d_basic_deinit();
+            
+            return 1;
+        }
+        
+        /* sample every 1000ms */
+        res = htu31d_basic_periodic_start(1000);
+        if (res != 0)
+        {
+            shm_publisher_close(&publisher, 1);
+            (void)htu31d_basic_deinit();
+            
+            return 1;
+        }
+        htu31d_interface_debug_print("htu31d: publishing to %s.\n", SHM_DEFAULT_NAME);
+        
+        /* loop */
+        memset(&reading, 0, sizeof(shm_reading_t));
+        for (i = 0; i < times; i++)
+        {
+            /* read data */
+            res = htu31d_basic_periodic_read_raw(&reading.temperature_raw, &reading.humidity_raw, &timestamp);
+            if (res != 0)
+            {
+                shm_publisher_close(&publisher, 1);
+                (void)htu31d_basic_deinit();
+                
+                return 1;
+            }
+            res = htu31d_basic_get_diagnostic(&reading.diagnostic);
+            if (res != 0)
+            {
+                shm_publisher_close(&publisher, 1);
+                (void)htu31d_basic_deinit();
+                
+                return 1;
+            }
+            htu31d_convert_batch_fixed(1, &reading.temperature_raw, &reading.humidity_raw,
+                                       &reading.temperature_centi, &reading.humidity_centi);
+            
+            /* widen the 32 bits driver timestamp with the 64 bits monotonic clock */
+            now = delay_now_ns() / 1000;
+            reading.timestamp_us = now - (uint32_t)((uint32_t)now - timestamp);
+            (void)shm_publish(&publisher, 0, &reading);
+            
+            /* output */
+            htu31d_interface_debug_print("htu31d: %d/%d.\n", (uint32_t)(i + 1), (uint32_t)times);
+            htu31d_interface_debug_print("htu31d: temperature is %0.2fC.\n", (float)reading.temperature_centi / 100.0f);
+            htu31d_interface_debug_print("htu31d: humidity is %0.2f%%.\n", (float)reading.humidity_centi / 100.0f);
+        }
+        
+        /* close the publisher */
+        shm_publisher_close(&publisher, 1);
+        
         /* basic deinit */
         (void)htu31d_basic_deinit();
         
@@ -254,16 +699,30 @@ uint8_t htu31d(uint8_t argc, char **argv)
         htu31d_interface_debug_print("  htu31d (-h | --help)\n");
         htu31d_interface_debug_print("  htu31d (-p | --port)\n");
         htu31d_interface_debug_print("  htu31d (-t reg | --test=reg) [--addr=<0 | 1>]\n");
-        htu31d_interface_debug_print("  htu31d (-t read | --test=read) [--addr=<0 | 1>] [--times=<num>]\n");
-        htu31d_interface_debug_print("  htu31d (-e read | --example=read) [--addr=<0 | 1>] [--times=<num>]\n");
+        htu31d_interface_debug_print("  htu31d (-t read | --test=read) [--addr=<0 | 1>] [--times=<num>] [--sim] [--spin=<ns>]\n");
+        htu31d_interface_debug_print("  htu31d (-t sim | --test=sim)\n");
+        htu31d_interface_debug_print("  htu31d (-t soak | --test=soak) [--times=<num>]\n");
+        htu31d_interface_debug_print("  htu31d (-t ring | --test=ring)\n");
+        htu31d_interface_debug_print("  htu31d (-t shm | --test=shm)\n");
+        htu31d_interface_debug_print("  htu31d (-t pollable | --test=pollable)\n");
+        htu31d_interface_debug_print("  htu31d (-t engine | --test=engine)\n");
+        htu31d_interface_debug_print("  htu31d (-t edf | --test=edf)\n");
+        htu31d_interface_debug_print("  htu31d (-e read | --example=read) [--addr=<0 | 1>] [--times=<num>] [--spin=<ns>]\n");
+        htu31d_interface_debug_print("  htu31d (-e group | --example=group) [--times=<num>] [--spin=<ns>]\n");
+        htu31d_interface_debug_print("  htu31d (-e ring | --example=ring) [--addr=<0 | 1>] [--times=<num>] [--spin=<ns>]\n");
+        htu31d_interface_debug_print("  htu31d (-e shm | --example=shm) [--addr=<0 | 1>] [--times=<num>] [--spin=<ns>]\n");
         htu31d_interface_debug_print("\n");
         htu31d_interface_debug_print("Options:\n");
         htu31d_interface_debug_print("  --addr=<0 | 1>                 Set the chip address.([default: 0]).\n");
-        htu31d_interface_debug_print("  -e <read>, --example=<read>    Run the driver example.\n");
+        htu31d_interface_debug_print("  -e <read | group | ring | shm>, --example=<read | group | ring | shm>\n");
+        htu31d_interface_debug_print("                                 Run the driver example.\n");
         htu31d_interface_debug_print("  -h, --help                     Show the help.\n");
         htu31d_interface_debug_print("  -i, --information              Show the chip information.\n");
         htu31d_interface_debug_print("  -p, --port                     Display the pin connections of the current board.\n");
-        htu31d_interface_debug_print("  -t <reg | read>, --test=<reg | read>\n");
+        htu31d_interface_debug_print("      --sim                      Run the read test against the simulator in virtual time.\n");
+        htu31d_interface_debug_print("      --spin=<ns>                Busy wait the last ns of every delay to hide the wake up latency.([default: 0])\n");
+        htu31d_interface_debug_print("  -t <reg | read | sim | soak | ring | shm | pollable | engine | edf>,\n");
+        htu31d_interface_debug_print("      --test=<reg | read | sim | soak | ring | shm | pollable | engine | edf>\n");
         htu31d_interface_debug_print("                                 Run the driver test.\n");
         htu31d_interface_debug_print("      --times=<num>              Set the running times.([default: 3])\n");
         
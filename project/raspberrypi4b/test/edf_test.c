@@ -0,0 +1,275 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      edf_test.c
+ * @brief     edf test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "edf_test.h"
+#include "driver_htu31d_interface.h"
+#include "driver_htu31d_simulator.h"
+
+/**
+ * @brief edf test definition
+ */
+#define EDF_TEST_SENSORS    4        /**< simulated sensor number */
+
+/**
+ * @brief edf test global variables definition
+ */
+static htu31d_simulator_t gs_sim[EDF_TEST_SENSORS];                            /**< simulators */
+static htu31d_handle_t gs_handle[EDF_TEST_SENSORS];                            /**< htu31d handles */
+static edf_sensor_t gs_sensor[EDF_TEST_SENSORS];                               /**< edf sensors */
+static uint32_t gs_bus_us;                                                     /**< virtual time of one transaction */
+static uint32_t gs_bus_count;                                                  /**< transaction number */
+
+/**
+ * @brief  virtual clock in ns
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_edf_test_now_ns(void)
+{
+    return htu31d_simulator_clock_get_us() * 1000ULL;
+}
+
+/**
+ * @brief     sleep until a virtual time
+ * @param[in] ns time in ns
+ * @note      the clock jumps to the time
+ */
+static void a_edf_test_until_ns(uint64_t ns)
+{
+    uint64_t now;
+    
+    now = a_edf_test_now_ns();
+    if (ns > now)
+    {
+        htu31d_simulator_clock_advance((uint32_t)((ns - now + 999) / 1000));
+    }
+}
+
+/**
+ * @brief     timed simulator iic bus write
+ * @param[in] *user_data pointer to a simulator structure
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      every transaction takes gs_bus_us of virtual time
+ */
+static uint8_t a_edf_test_iic_write(void *user_data, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    htu31d_simulator_clock_advance(gs_bus_us);
+    gs_bus_count++;
+    
+    return htu31d_simulator_iic_write(user_data, addr, reg, buf, len);
+}
+
+/**
+ * @brief      timed simulator iic bus read
+ * @param[in]  *user_data pointer to a simulator structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       every transaction takes gs_bus_us of virtual time
+ */
+static uint8_t a_edf_test_iic_read(void *user_data, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    htu31d_simulator_clock_advance(gs_bus_us);
+    gs_bus_count++;
+    
+    return htu31d_simulator_iic_read(user_data, addr, reg, buf, len);
+}
+
+/**
+ * @brief     init a simulated sensor
+ * @param[in] i sensor index
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the simulator converts on the virtual clock
+ */
+static uint8_t a_edf_test_init(uint8_t i)
+{
+    htu31d_simulator_init(&gs_sim[i], HTU31D_ADDR_PIN_LOW);
+    gs_sim[i].timestamp_us = htu31d_simulator_clock_timestamp_us;
+    DRIVER_HTU31D_LINK_INIT(&gs_handle[i], htu31d_handle_t);
+    DRIVER_HTU31D_LINK_IIC_INIT(&gs_handle[i], htu31d_interface_iic_init);
+    DRIVER_HTU31D_LINK_IIC_DEINIT(&gs_handle[i], htu31d_interface_iic_deinit);
+    DRIVER_HTU31D_LINK_IIC_WRITE(&gs_handle[i], htu31d_interface_iic_write);
+    DRIVER_HTU31D_LINK_IIC_READ(&gs_handle[i], htu31d_interface_iic_read);
+    DRIVER_HTU31D_LINK_DELAY_MS(&gs_handle[i], htu31d_simulator_clock_delay_ms);
+    DRIVER_HTU31D_LINK_DELAY_US(&gs_handle[i], htu31d_simulator_clock_delay_us);
+    DRIVER_HTU31D_LINK_TIMESTAMP_US(&gs_handle[i], htu31d_simulator_clock_timestamp_us);
+    DRIVER_HTU31D_LINK_DEBUG_PRINT(&gs_handle[i], htu31d_interface_debug_print);
+    DRIVER_HTU31D_LINK_USER_DATA(&gs_handle[i], &gs_sim[i]);
+    DRIVER_HTU31D_LINK_IIC_INIT_CTX(&gs_handle[i], htu31d_simulator_iic_init);
+    DRIVER_HTU31D_LINK_IIC_DEINIT_CTX(&gs_handle[i], htu31d_simulator_iic_deinit);
+    DRIVER_HTU31D_LINK_IIC_WRITE_CTX(&gs_handle[i], a_edf_test_iic_write);
+    DRIVER_HTU31D_LINK_IIC_READ_CTX(&gs_handle[i], a_edf_test_iic_read);
+    (void)htu31d_set_addr_pin(&gs_handle[i], HTU31D_ADDR_PIN_LOW);
+    
+    return htu31d_init(&gs_handle[i]);
+}
+
+/**
+ * @brief     run the scheduler on the virtual clock
+ * @param[in] *period_us pointer to a period array, one per sensor
+ * @param[in] num sensor number
+ * @param[in] bus_us virtual time of one transaction
+ * @param[in] duration_us run time in us
+ * @param[out] *report pointer to an edf report structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the bus time must be reported exactly, every transaction is a fixed step of the clock
+ */
+static uint8_t a_edf_test_run(const uint32_t *period_us, uint8_t num, uint32_t bus_us,
+                              uint32_t duration_us, edf_report_t *report)
+{
+    uint8_t i;
+    uint32_t utilization;
+    uint64_t busy_ns;
+    edf_t edf;
+    
+    gs_bus_us = 0;
+    for (i = 0; i < num; i++)
+    {
+        if (a_edf_test_init(i) != 0)
+        {
+            htu31d_interface_debug_print("edf: init sensor %d failed.\n", i);
+            
+            return 1;
+        }
+        if (edf_sensor_init(&gs_sensor[i], &gs_handle[i], period_us[i], NULL) != 0)
+        {
+            htu31d_interface_debug_print("edf: sensor %d init failed.\n", i);
+            
+            return 1;
+        }
+    }
+    if ((edf_init(&edf, gs_sensor, num) != 0) || (edf_set_clock(&edf, a_edf_test_now_ns, a_edf_test_until_ns) != 0))
+    {
+        htu31d_interface_debug_print("edf: init failed.\n");
+        
+        return 1;
+    }
+    gs_bus_us = bus_us;
+    gs_bus_count = 0;
+    edf_start(&edf);
+    edf_run(&edf, duration_us);
+    edf_get_report(&edf, report);
+    busy_ns = (uint64_t)gs_bus_count * bus_us * 1000ULL;
+    for (i = 0; i < num; i++)
+    {
+        (void)htu31d_deinit(&gs_handle[i]);
+    }
+    utilization = (uint32_t)(busy_ns * 10000ULL / report->elapsed_ns);
+    if ((report->busy_ns != busy_ns) || (report->utilization != utilization))
+    {
+        htu31d_interface_debug_print("edf: reported %dus busy but the bus was busy %dus.\n",
+                                     (uint32_t)(report->busy_ns / 1000ULL), (uint32_t)(busy_ns / 1000ULL));
+        
+        return 1;
+    }
+    htu31d_interface_debug_print("edf: %d samples, %d misses, %d.%02d percent utilization, %d.%02d percent demand.\n",
+                                 report->count, report->miss, report->utilization / 100, report->utilization % 100,
+                                 report->demand / 100, report->demand % 100);
+    
+    return 0;
+}
+
+/**
+ * @brief  edf test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   it schedules simulated sensors on the virtual clock, a feasible mix of fast and slow periods
+ *         must not miss and must report the bus time it used, an overloaded bus must count the misses
+ */
+uint8_t edf_test(void)
+{
+    const uint32_t mix[2] = {100000, 10000000};
+    const uint32_t overload[EDF_TEST_SENSORS] = {4000, 4000, 4000, 4000};
+    edf_report_t report;
+    
+    /* start edf test */
+    htu31d_interface_debug_print("edf: start edf test.\n");
+    htu31d_simulator_clock_init(0);
+    
+    /* 10Hz and 0.1Hz for 20s */
+    htu31d_interface_debug_print("edf: 10Hz and 0.1Hz mix test.\n");
+    if (a_edf_test_run(mix, 2, 200, 20000000, &report) != 0)
+    {
+        return 1;
+    }
+    if ((report.miss != 0) || (gs_sensor[0].count < 200) || (gs_sensor[0].count > 201) ||
+        (gs_sensor[1].count < 2) || (gs_sensor[1].count > 3))
+    {
+        htu31d_interface_debug_print("edf: %d misses with %d fast and %d slow samples.\n",
+                                     report.miss, gs_sensor[0].count, gs_sensor[1].count);
+        
+        return 1;
+    }
+    if ((report.utilization + 1 < report.demand) || (report.utilization > report.demand + 1))
+    {
+        htu31d_interface_debug_print("edf: utilization doesn't match the demand of the periods.\n");
+        
+        return 1;
+    }
+    
+    /* four sensors needing twice the bus */
+    htu31d_interface_debug_print("edf: overload test.\n");
+    if (a_edf_test_run(overload, EDF_TEST_SENSORS, 1000, 1000000, &report) != 0)
+    {
+        return 1;
+    }
+    if ((report.miss == 0) || (report.demand <= 10000) || (report.utilization > 10000))
+    {
+        htu31d_interface_debug_print("edf: overload is not reported.\n");
+        
+        return 1;
+    }
+    
+    /* finish edf test */
+    htu31d_interface_debug_print("edf: finish edf test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,535 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      engine_test.c
+ * @brief     engine test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "engine_test.h"
+#include "driver_htu31d_interface.h"
+#include "driver_htu31d_simulator.h"
+#include "delay.h"
+#include <poll.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * @brief engine test definition
+ */
+#define ENGINE_TEST_SENSORS    2         /**< simulated sensor number, one per submitter thread */
+#define ENGINE_TEST_DEPTH      8         /**< queue depth */
+#define ENGINE_TEST_TIMES      50        /**< conversions per submitter thread */
+
+/**
+ * @brief engine test submitter structure definition
+ */
+typedef struct engine_test_submitter_s
+{
+    engine_t *engine;                    /**< engine */
+    uint32_t index;                      /**< submitter and sensor index */
+    uint32_t full;                       /**< queue full retries */
+    pthread_t thread;                    /**< submitter thread */
+} engine_test_submitter_t;
+
+/**
+ * @brief engine test global variables definition
+ */
+static htu31d_simulator_t gs_sim[ENGINE_TEST_SENSORS];                         /**< simulators */
+static htu31d_handle_t gs_handle[ENGINE_TEST_SENSORS];                         /**< htu31d handles */
+
+/**
+ * @brief     init a simulated sensor
+ * @param[in] i sensor index
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the simulator converts in real CLOCK_MONOTONIC time with a 20C + i, 50% environment
+ */
+static uint8_t a_engine_test_init(uint8_t i)
+{
+    htu31d_simulator_init(&gs_sim[i], HTU31D_ADDR_PIN_LOW);
+    gs_sim[i].timestamp_us = htu31d_interface_timestamp_us;
+    gs_sim[i].temperature.mean = 20.0f + (float)i;
+    DRIVER_HTU31D_LINK_INIT(&gs_handle[i], htu31d_handle_t);
+    DRIVER_HTU31D_LINK_IIC_INIT(&gs_handle[i], htu31d_interface_iic_init);
+    DRIVER_HTU31D_LINK_IIC_DEINIT(&gs_handle[i], htu31d_interface_iic_deinit);
+    DRIVER_HTU31D_LINK_IIC_WRITE(&gs_handle[i], htu31d_interface_iic_write);
+    DRIVER_HTU31D_LINK_IIC_READ(&gs_handle[i], htu31d_interface_iic_read);
+    DRIVER_HTU31D_LINK_DELAY_MS(&gs_handle[i], htu31d_interface_delay_ms);
+    DRIVER_HTU31D_LINK_DELAY_US(&gs_handle[i], htu31d_interface_delay_us);
+    DRIVER_HTU31D_LINK_TIMESTAMP_US(&gs_handle[i], htu31d_interface_timestamp_us);
+    DRIVER_HTU31D_LINK_DEBUG_PRINT(&gs_handle[i], htu31d_interface_debug_print);
+    DRIVER_HTU31D_LINK_USER_DATA(&gs_handle[i], &gs_sim[i]);
+    DRIVER_HTU31D_LINK_IIC_INIT_CTX(&gs_handle[i], htu31d_simulator_iic_init);
+    DRIVER_HTU31D_LINK_IIC_DEINIT_CTX(&gs_handle[i], htu31d_simulator_iic_deinit);
+    DRIVER_HTU31D_LINK_IIC_WRITE_CTX(&gs_handle[i], htu31d_simulator_iic_write);
+    DRIVER_HTU31D_LINK_IIC_READ_CTX(&gs_handle[i], htu31d_simulator_iic_read);
+    (void)htu31d_set_addr_pin(&gs_handle[i], HTU31D_ADDR_PIN_LOW);
+    
+    return htu31d_init(&gs_handle[i]);
+}
+
+/**
+ * @brief     deinit the simulated sensors
+ * @param[in] num inited sensor number
+ * @note      none
+ */
+static void a_engine_test_deinit(uint8_t num)
+{
+    uint8_t i;
+    
+    for (i = 0; i < num; i++)
+    {
+        (void)htu31d_deinit(&gs_handle[i]);
+    }
+}
+
+/**
+ * @brief      wait for completions and reap them
+ * @param[in]  *engine pointer to an engine structure
+ * @param[out] *cqe pointer to a completion queue entry array
+ * @param[in]  len array length
+ * @return     reaped entry number, 0 after a second without completions
+ * @note       none
+ */
+static uint32_t a_engine_test_reap(engine_t *engine, engine_cqe_t *cqe, uint32_t len)
+{
+    uint32_t num;
+    uint64_t count;
+    struct pollfd fds;
+    
+    fds.fd = engine_get_fd(engine);
+    fds.events = POLLIN;
+    while ((num = engine_reap(engine, cqe, len)) == 0)
+    {
+        /* the event may be left from completions that were already reaped, so check again after it */
+        fds.revents = 0;
+        if (poll(&fds, 1, 1000) != 1)
+        {
+            return 0;
+        }
+        (void)read(engine_get_fd(engine), &count, sizeof(count));
+    }
+    
+    return num;
+}
+
+/**
+ * @brief     check a completion
+ * @param[in] *cqe pointer to a completion queue entry
+ * @param[in] i submitter index
+ * @param[in] k submission index of the submitter
+ * @return    status code
+ *            - 0 success
+ *            - 1 completion is wrong
+ * @note      even submissions convert and odd ones fetch the sensor of the submitter
+ */
+static uint8_t a_engine_test_check(const engine_cqe_t *cqe, uint32_t i, uint32_t k)
+{
+    if ((cqe->res != 0) || (cqe->handle != &gs_handle[i]) ||
+        (cqe->op != (((k & 1) == 0) ? ENGINE_OP_CONVERT : ENGINE_OP_FETCH)))
+    {
+        return 1;
+    }
+    if ((cqe->op == ENGINE_OP_FETCH) &&
+        ((abs(cqe->sample.temperature_centi - (int32_t)(2000 + 100 * i)) > 2) ||
+         (abs((int32_t)cqe->sample.humidity_centi - 5000) > 2)))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     submitter thread
+ * @param[in] *arg pointer to an engine test submitter structure
+ * @return    NULL
+ * @note      it submits convert and fetch pairs of its own sensor, the tag holds the submitter and
+ *            the submission index, a full queue is retried after the reaper had a chance to run
+ */
+static void *a_engine_test_submitter(void *arg)
+{
+    engine_test_submitter_t *submitter = (engine_test_submitter_t *)arg;
+    engine_sqe_t sqe;
+    uint32_t k;
+    
+    memset(&sqe, 0, sizeof(engine_sqe_t));
+    sqe.handle = &gs_handle[submitter->index];
+    for (k = 0; k < 2 * ENGINE_TEST_TIMES; k++)
+    {
+        sqe.tag = ((uint64_t)submitter->index << 32) | k;
+        sqe.op = ((k & 1) == 0) ? ENGINE_OP_CONVERT : ENGINE_OP_FETCH;
+        while (engine_submit(submitter->engine, &sqe) != 0)
+        {
+            submitter->full++;
+            sched_yield();
+        }
+        engine_enter(submitter->engine);
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief  queue full test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   depth entries can be in flight, the next submission is refused until the completions are reaped
+ */
+static uint8_t a_engine_test_full(void)
+{
+    uint32_t k;
+    uint32_t num;
+    engine_t engine;
+    engine_sqe_t sqe;
+    engine_cqe_t cqe[ENGINE_TEST_DEPTH];
+    
+    if (engine_init(&engine, ENGINE_TEST_DEPTH) != 0)
+    {
+        return 1;
+    }
+    memset(&sqe, 0, sizeof(engine_sqe_t));
+    sqe.handle = &gs_handle[0];
+    sqe.op = ENGINE_OP_DIAGNOSTIC;
+    for (k = 0; k <= ENGINE_TEST_DEPTH; k++)
+    {
+        sqe.tag = k;
+        if (engine_submit(&engine, &sqe) != ((k < ENGINE_TEST_DEPTH) ? 0 : 1))
+        {
+            htu31d_interface_debug_print("engine: submission %d returned a wrong status.\n", k);
+            engine_deinit(&engine);
+            
+            return 1;
+        }
+    }
+    engine_enter(&engine);
+    num = 0;
+    while (num < ENGINE_TEST_DEPTH)
+    {
+        k = a_engine_test_reap(&engine, cqe + num, ENGINE_TEST_DEPTH - num);
+        if (k == 0)
+        {
+            htu31d_interface_debug_print("engine: completions timed out.\n");
+            engine_deinit(&engine);
+            
+            return 1;
+        }
+        num += k;
+    }
+    for (k = 0; k < ENGINE_TEST_DEPTH; k++)
+    {
+        if ((cqe[k].tag != k) || (cqe[k].res != 0) || (cqe[k].op != ENGINE_OP_DIAGNOSTIC) || (cqe[k].value != 0))
+        {
+            htu31d_interface_debug_print("engine: completion %d is wrong.\n", k);
+            engine_deinit(&engine);
+            
+            return 1;
+        }
+    }
+    
+    /* the reaped cells are free again */
+    if (engine_submit(&engine, &sqe) != 0)
+    {
+        htu31d_interface_debug_print("engine: reaped cells are not reused.\n");
+        engine_deinit(&engine);
+        
+        return 1;
+    }
+    engine_deinit(&engine);
+    
+    return 0;
+}
+
+/**
+ * @brief  multi thread test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the completions of every submitter must come back in its submission order
+ */
+static uint8_t a_engine_test_threads(void)
+{
+    uint32_t i;
+    uint32_t k;
+    uint32_t num;
+    uint32_t total;
+    uint32_t next[ENGINE_TEST_SENSORS];
+    engine_t engine;
+    engine_cqe_t cqe[ENGINE_TEST_DEPTH];
+    engine_test_submitter_t submitter[ENGINE_TEST_SENSORS];
+    
+    if (engine_init(&engine, ENGINE_TEST_DEPTH) != 0)
+    {
+        return 1;
+    }
+    for (i = 0; i < ENGINE_TEST_SENSORS; i++)
+    {
+        submitter[i].engine = &engine;
+        submitter[i].index = i;
+        submitter[i].full = 0;
+        next[i] = 0;
+        if (pthread_create(&submitter[i].thread, NULL, a_engine_test_submitter, &submitter[i]) != 0)
+        {
+            htu31d_interface_debug_print("engine: create thread failed.\n");
+            while (i != 0)
+            {
+                i--;
+                (void)pthread_join(submitter[i].thread, NULL);
+            }
+            engine_deinit(&engine);
+            
+            return 1;
+        }
+    }
+    total = 0;
+    while (total < ENGINE_TEST_SENSORS * 2 * ENGINE_TEST_TIMES)
+    {
+        num = a_engine_test_reap(&engine, cqe, ENGINE_TEST_DEPTH);
+        if (num == 0)
+        {
+            htu31d_interface_debug_print("engine: completions timed out.\n");
+            
+            break;
+        }
+        for (k = 0; k < num; k++)
+        {
+            i = (uint32_t)(cqe[k].tag >> 32);
+            if ((i >= ENGINE_TEST_SENSORS) || ((uint32_t)cqe[k].tag != next[i]) ||
+                (a_engine_test_check(&cqe[k], i, next[i]) != 0))
+            {
+                htu31d_interface_debug_print("engine: completion 0x%08X%08X is wrong or out of order.\n",
+                                             (uint32_t)(cqe[k].tag >> 32), (uint32_t)cqe[k].tag);
+                
+                break;
+            }
+            next[i]++;
+        }
+        if (k != num)
+        {
+            break;
+        }
+        total += num;
+    }
+    for (i = 0; i < ENGINE_TEST_SENSORS; i++)
+    {
+        (void)pthread_join(submitter[i].thread, NULL);
+    }
+    engine_deinit(&engine);
+    if (total != ENGINE_TEST_SENSORS * 2 * ENGINE_TEST_TIMES)
+    {
+        return 1;
+    }
+    htu31d_interface_debug_print("engine: %d completions in order, %d and %d full queue retries.\n",
+                                 total, submitter[0].full, submitter[1].full);
+    
+    return 0;
+}
+
+/**
+ * @brief      run convert and fetch pairs
+ * @param[in]  *engine pointer to an engine array
+ * @param[in]  engines engine number, sensor i runs on engine i % engines
+ * @param[out] *elapsed_us pointer to an elapsed time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       every round submits one pair per sensor and reaps all of them, the fetch of a shared
+ *             engine blocks its worker, so only separate engines overlap the conversions
+ */
+static uint8_t a_engine_test_pairs(engine_t *engine, uint32_t engines, uint64_t *elapsed_us)
+{
+    uint32_t i;
+    uint32_t k;
+    uint32_t num;
+    uint32_t left;
+    uint64_t start;
+    engine_sqe_t sqe;
+    engine_cqe_t cqe[ENGINE_TEST_DEPTH];
+    
+    memset(&sqe, 0, sizeof(engine_sqe_t));
+    start = delay_now_ns();
+    for (k = 0; k < ENGINE_TEST_TIMES; k++)
+    {
+        for (i = 0; i < ENGINE_TEST_SENSORS; i++)
+        {
+            sqe.handle = &gs_handle[i];
+            sqe.tag = i;
+            sqe.op = ENGINE_OP_CONVERT;
+            (void)engine_submit(&engine[i % engines], &sqe);
+            sqe.op = ENGINE_OP_FETCH;
+            (void)engine_submit(&engine[i % engines], &sqe);
+        }
+        for (i = 0; i < engines; i++)
+        {
+            engine_enter(&engine[i]);
+        }
+        for (i = 0; i < engines; i++)
+        {
+            left = 2 * ENGINE_TEST_SENSORS / engines;
+            while (left != 0)
+            {
+                num = a_engine_test_reap(&engine[i], cqe, left);
+                if (num == 0)
+                {
+                    htu31d_interface_debug_print("engine: completions timed out.\n");
+                    
+                    return 1;
+                }
+                while (num != 0)
+                {
+                    num--;
+                    left--;
+                    if (a_engine_test_check(&cqe[num], (uint32_t)cqe[num].tag,
+                                            (cqe[num].op == ENGINE_OP_CONVERT) ? 0 : 1) != 0)
+                    {
+                        htu31d_interface_debug_print("engine: sensor %d completion is wrong.\n", (uint32_t)cqe[num].tag);
+                        
+                        return 1;
+                    }
+                }
+            }
+        }
+    }
+    *elapsed_us = (delay_now_ns() - start) / 1000ULL;
+    
+    return 0;
+}
+
+/**
+ * @brief  throughput test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   two sensors on two engines must finish clearly faster than on one engine
+ */
+static uint8_t a_engine_test_throughput(void)
+{
+    uint8_t res;
+    uint64_t one_us;
+    uint64_t two_us;
+    engine_t engine[2];
+    
+    if (engine_init(&engine[0], ENGINE_TEST_DEPTH) != 0)
+    {
+        return 1;
+    }
+    if (engine_init(&engine[1], ENGINE_TEST_DEPTH) != 0)
+    {
+        engine_deinit(&engine[0]);
+        
+        return 1;
+    }
+    res = a_engine_test_pairs(engine, 1, &one_us);
+    if (res == 0)
+    {
+        res = a_engine_test_pairs(engine, 2, &two_us);
+    }
+    engine_deinit(&engine[0]);
+    engine_deinit(&engine[1]);
+    if (res != 0)
+    {
+        return 1;
+    }
+    htu31d_interface_debug_print("engine: %d conversions took %dus on one engine and %dus on two engines.\n",
+                                 ENGINE_TEST_SENSORS * ENGINE_TEST_TIMES, (uint32_t)one_us, (uint32_t)two_us);
+    if (two_us * 4 > one_us * 3)
+    {
+        htu31d_interface_debug_print("engine: two engines don't overlap the conversions.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  engine test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   it runs simulated sensors in real time and checks the queue full handling, the tags and the order
+ *         of completions submitted from several threads, and that two engines overlap their conversions
+ */
+uint8_t engine_test(void)
+{
+    uint8_t i;
+    
+    /* start engine test */
+    htu31d_interface_debug_print("engine: start engine test.\n");
+    
+    for (i = 0; i < ENGINE_TEST_SENSORS; i++)
+    {
+        if (a_engine_test_init(i) != 0)
+        {
+            htu31d_interface_debug_print("engine: init sensor %d failed.\n", i);
+            a_engine_test_deinit(i);
+            
+            return 1;
+        }
+    }
+    
+    /* queue full */
+    htu31d_interface_debug_print("engine: queue full test.\n");
+    if (a_engine_test_full() != 0)
+    {
+        a_engine_test_deinit(ENGINE_TEST_SENSORS);
+        
+        return 1;
+    }
+    
+    /* submitter threads */
+    htu31d_interface_debug_print("engine: submitter threads test.\n");
+    if (a_engine_test_threads() != 0)
+    {
+        a_engine_test_deinit(ENGINE_TEST_SENSORS);
+        
+        return 1;
+    }
+    
+    /* two engines */
+    htu31d_interface_debug_print("engine: throughput test.\n");
+    if (a_engine_test_throughput() != 0)
+    {
+        a_engine_test_deinit(ENGINE_TEST_SENSORS);
+        
+        return 1;
+    }
+    a_engine_test_deinit(ENGINE_TEST_SENSORS);
+    
+    /* finish engine test */
+    htu31d_interface_debug_print("engine: finish engine test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,340 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      pollable_test.c
+ * @brief     pollable test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "pollable_test.h"
+#include "driver_htu31d_interface.h"
+#include "driver_htu31d_simulator.h"
+#include <stdlib.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+/**
+ * @brief pollable test definition
+ */
+#define POLLABLE_TEST_SENSORS    2            /**< simulated sensor number */
+#define POLLABLE_TEST_PERIOD     20000        /**< sampling period in us */
+#define POLLABLE_TEST_TIMES      10           /**< periodic sample number */
+#define POLLABLE_TEST_JITTER     5000         /**< allowed wake up jitter in us */
+
+/**
+ * @brief pollable test global variables definition
+ */
+static htu31d_simulator_t gs_sim[POLLABLE_TEST_SENSORS];                       /**< simulators */
+static htu31d_handle_t gs_handle[POLLABLE_TEST_SENSORS];                       /**< htu31d handles */
+static htu31d_handle_t *gs_group[POLLABLE_TEST_SENSORS];                       /**< htu31d handle group */
+static htu31d_sample_t gs_sample[POLLABLE_TEST_SENSORS];                       /**< samples */
+static uint8_t gs_status[POLLABLE_TEST_SENSORS];                               /**< sample status */
+
+/**
+ * @brief     init a simulated sensor
+ * @param[in] i sensor index
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the simulator converts in real CLOCK_MONOTONIC time with a 20C + i, 50% environment
+ */
+static uint8_t a_pollable_test_init(uint8_t i)
+{
+    htu31d_simulator_init(&gs_sim[i], HTU31D_ADDR_PIN_LOW);
+    gs_sim[i].timestamp_us = htu31d_interface_timestamp_us;
+    gs_sim[i].temperature.mean = 20.0f + (float)i;
+    DRIVER_HTU31D_LINK_INIT(&gs_handle[i], htu31d_handle_t);
+    DRIVER_HTU31D_LINK_IIC_INIT(&gs_handle[i], htu31d_interface_iic_init);
+    DRIVER_HTU31D_LINK_IIC_DEINIT(&gs_handle[i], htu31d_interface_iic_deinit);
+    DRIVER_HTU31D_LINK_IIC_WRITE(&gs_handle[i], htu31d_interface_iic_write);
+    DRIVER_HTU31D_LINK_IIC_READ(&gs_handle[i], htu31d_interface_iic_read);
+    DRIVER_HTU31D_LINK_DELAY_MS(&gs_handle[i], htu31d_interface_delay_ms);
+    DRIVER_HTU31D_LINK_DELAY_US(&gs_handle[i], htu31d_interface_delay_us);
+    DRIVER_HTU31D_LINK_TIMESTAMP_US(&gs_handle[i], htu31d_interface_timestamp_us);
+    DRIVER_HTU31D_LINK_DEBUG_PRINT(&gs_handle[i], htu31d_interface_debug_print);
+    DRIVER_HTU31D_LINK_USER_DATA(&gs_handle[i], &gs_sim[i]);
+    DRIVER_HTU31D_LINK_IIC_INIT_CTX(&gs_handle[i], htu31d_simulator_iic_init);
+    DRIVER_HTU31D_LINK_IIC_DEINIT_CTX(&gs_handle[i], htu31d_simulator_iic_deinit);
+    DRIVER_HTU31D_LINK_IIC_WRITE_CTX(&gs_handle[i], htu31d_simulator_iic_write);
+    DRIVER_HTU31D_LINK_IIC_READ_CTX(&gs_handle[i], htu31d_simulator_iic_read);
+    (void)htu31d_set_addr_pin(&gs_handle[i], HTU31D_ADDR_PIN_LOW);
+    gs_group[i] = &gs_handle[i];
+    
+    return htu31d_init(&gs_handle[i]);
+}
+
+/**
+ * @brief     deinit the simulated sensors
+ * @param[in] num inited sensor number
+ * @note      none
+ */
+static void a_pollable_test_deinit(uint8_t num)
+{
+    uint8_t i;
+    
+    for (i = 0; i < num; i++)
+    {
+        (void)htu31d_deinit(&gs_handle[i]);
+    }
+}
+
+/**
+ * @brief     wait for the next group result
+ * @param[in] *pollable pointer to a pollable structure
+ * @param[in] epfd epoll file descriptor
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed, timed out or a sample is wrong
+ * @note      every sensor must report status 0 and the constant simulated environment
+ */
+static uint8_t a_pollable_test_wait(pollable_t *pollable, int epfd)
+{
+    uint8_t i;
+    uint8_t ready;
+    struct epoll_event event;
+    
+    do
+    {
+        if (epoll_wait(epfd, &event, 1, 1000) != 1)
+        {
+            htu31d_interface_debug_print("pollable: wait timed out.\n");
+            
+            return 1;
+        }
+        if (pollable_dispatch(pollable, gs_sample, gs_status, &ready) != 0)
+        {
+            htu31d_interface_debug_print("pollable: dispatch failed.\n");
+            
+            return 1;
+        }
+    } while (ready == 0);
+    for (i = 0; i < POLLABLE_TEST_SENSORS; i++)
+    {
+        if ((gs_status[i] != 0) || (abs(gs_sample[i].temperature_centi - (2000 + 100 * i)) > 2) ||
+            (abs((int32_t)gs_sample[i].humidity_centi - 5000) > 2))
+        {
+            htu31d_interface_debug_print("pollable: sensor %d returned %d with %d centi C %d centi %%.\n",
+                                         i, gs_status[i], gs_sample[i].temperature_centi, gs_sample[i].humidity_centi);
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run the pollable cases
+ * @param[in] *pollable pointer to a pollable structure
+ * @param[in] epfd epoll file descriptor
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+static uint8_t a_pollable_test_run(pollable_t *pollable, int epfd)
+{
+    uint8_t ready;
+    uint32_t i;
+    uint32_t last;
+    uint32_t spacing;
+    struct epoll_event event;
+    
+    /* one shot */
+    htu31d_interface_debug_print("pollable: one shot test.\n");
+    if (pollable_start(pollable, 0) != 0)
+    {
+        return 1;
+    }
+    if ((epoll_wait(epfd, &event, 1, 1000) != 1) || (pollable_dispatch(pollable, gs_sample, gs_status, &ready) != 0) ||
+        (ready != 0) || (pollable->state != POLLABLE_STATE_CONVERTING))
+    {
+        htu31d_interface_debug_print("pollable: release didn't start the conversions.\n");
+        
+        return 1;
+    }
+    if ((pollable_dispatch(pollable, gs_sample, gs_status, &ready) != 0) || (ready != 0) ||
+        (pollable->state != POLLABLE_STATE_CONVERTING))
+    {
+        htu31d_interface_debug_print("pollable: spurious wake up is not ignored.\n");
+        
+        return 1;
+    }
+    if (a_pollable_test_wait(pollable, epfd) != 0)
+    {
+        return 1;
+    }
+    if ((pollable->state != POLLABLE_STATE_IDLE) || (epoll_wait(epfd, &event, 1, POLLABLE_TEST_PERIOD / 1000) != 0))
+    {
+        htu31d_interface_debug_print("pollable: one shot is still armed.\n");
+        
+        return 1;
+    }
+    
+    /* periodic */
+    htu31d_interface_debug_print("pollable: periodic test.\n");
+    if (pollable_start(pollable, POLLABLE_TEST_PERIOD) != 0)
+    {
+        return 1;
+    }
+    last = 0;
+    for (i = 0; i < POLLABLE_TEST_TIMES; i++)
+    {
+        if (a_pollable_test_wait(pollable, epfd) != 0)
+        {
+            return 1;
+        }
+        spacing = gs_sample[0].timestamp_us - last;
+        if ((i != 0) && ((spacing + POLLABLE_TEST_JITTER < POLLABLE_TEST_PERIOD) ||
+                         (spacing > POLLABLE_TEST_PERIOD + POLLABLE_TEST_JITTER)))
+        {
+            htu31d_interface_debug_print("pollable: samples are %dus apart but the period is %dus.\n",
+                                         spacing, POLLABLE_TEST_PERIOD);
+            
+            return 1;
+        }
+        last = gs_sample[0].timestamp_us;
+    }
+    if (pollable->overrun != 0)
+    {
+        htu31d_interface_debug_print("pollable: %d overruns without a stall.\n", pollable->overrun);
+        
+        return 1;
+    }
+    
+    /* stalled loop */
+    htu31d_interface_debug_print("pollable: stalled loop test.\n");
+    (void)usleep(POLLABLE_TEST_PERIOD * 7 / 2);
+    if (a_pollable_test_wait(pollable, epfd) != 0)
+    {
+        return 1;
+    }
+    if ((pollable->overrun == 0) || (pollable->overrun > 3))
+    {
+        htu31d_interface_debug_print("pollable: %d overruns after a 3.5 period stall.\n", pollable->overrun);
+        
+        return 1;
+    }
+    htu31d_interface_debug_print("pollable: %d overruns after a 3.5 period stall.\n", pollable->overrun);
+    
+    /* the schedule goes on after the stall */
+    last = gs_sample[0].timestamp_us;
+    if (a_pollable_test_wait(pollable, epfd) != 0)
+    {
+        return 1;
+    }
+    spacing = gs_sample[0].timestamp_us - last;
+    if (spacing > 2 * POLLABLE_TEST_PERIOD + POLLABLE_TEST_JITTER)
+    {
+        htu31d_interface_debug_print("pollable: schedule didn't recover after the stall.\n");
+        
+        return 1;
+    }
+    pollable_stop(pollable);
+    if (epoll_wait(epfd, &event, 1, 2 * POLLABLE_TEST_PERIOD / 1000) != 0)
+    {
+        htu31d_interface_debug_print("pollable: stopped timer is still armed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  pollable test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   it waits for a simulated sensor group with epoll in real time and checks the one shot,
+ *         the spurious wake up, the periodic release times and the overrun of a stalled loop
+ */
+uint8_t pollable_test(void)
+{
+    uint8_t i;
+    uint8_t res;
+    int epfd;
+    pollable_t pollable;
+    struct epoll_event event;
+    
+    /* start pollable test */
+    htu31d_interface_debug_print("pollable: start pollable test.\n");
+    
+    for (i = 0; i < POLLABLE_TEST_SENSORS; i++)
+    {
+        if (a_pollable_test_init(i) != 0)
+        {
+            htu31d_interface_debug_print("pollable: init sensor %d failed.\n", i);
+            a_pollable_test_deinit(i);
+            
+            return 1;
+        }
+    }
+    if (pollable_init(&pollable, gs_group, POLLABLE_TEST_SENSORS) != 0)
+    {
+        a_pollable_test_deinit(POLLABLE_TEST_SENSORS);
+        
+        return 1;
+    }
+    epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (epfd < 0)
+    {
+        htu31d_interface_debug_print("pollable: epoll create failed.\n");
+        pollable_deinit(&pollable);
+        a_pollable_test_deinit(POLLABLE_TEST_SENSORS);
+        
+        return 1;
+    }
+    event.events = EPOLLIN;
+    event.data.ptr = &pollable;
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, pollable_get_fd(&pollable), &event) != 0)
+    {
+        htu31d_interface_debug_print("pollable: epoll add failed.\n");
+        (void)close(epfd);
+        pollable_deinit(&pollable);
+        a_pollable_test_deinit(POLLABLE_TEST_SENSORS);
+        
+        return 1;
+    }
+    res = a_pollable_test_run(&pollable, epfd);
+    (void)close(epfd);
+    pollable_deinit(&pollable);
+    a_pollable_test_deinit(POLLABLE_TEST_SENSORS);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* finish pollable test */
+    htu31d_interface_debug_print("pollable: finish pollable test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,251 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      ring_test.c
+ * @brief     ring test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "ring_test.h"
+#include "driver_htu31d_interface.h"
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+/**
+ * @brief ring test definition
+ */
+#define RING_TEST_SIZE     8              /**< ring size, small enough to wrap and fill */
+#define RING_TEST_BATCH    3              /**< pop batch, not a divisor of the ring size */
+#define RING_TEST_TIMES    1000000        /**< pushed sample number of the threaded part */
+
+/**
+ * @brief ring test global variables definition
+ */
+static ring_t gs_ring;                                                          /**< ring */
+static ring_sample_t gs_ring_buf[RING_TEST_SIZE];                               /**< ring buffer */
+static uint64_t gs_ring_pushed;                                                 /**< accepted sample number */
+static volatile uint8_t gs_ring_done;                                           /**< producer finished flag */
+
+/**
+ * @brief     ring test producer thread
+ * @param[in] *arg pointer to the thread argument
+ * @return    NULL
+ * @note      the timestamp carries the sequence number and the raw fields are derived from it
+ */
+static void *a_ring_test_producer(void *arg)
+{
+    uint32_t i;
+    ring_sample_t sample;
+    
+    (void)arg;
+    memset(&sample, 0, sizeof(ring_sample_t));
+    for (i = 0; i < RING_TEST_TIMES; i++)
+    {
+        sample.timestamp_us = i;
+        sample.temperature_raw = (uint16_t)i;
+        sample.humidity_raw = (uint16_t)~i;
+        if (ring_push(&gs_ring, &sample) == 0)
+        {
+            gs_ring_pushed++;
+        }
+        else
+        {
+            /* let the consumer catch up after a drop */
+            sched_yield();
+        }
+    }
+    __atomic_store_n(&gs_ring_done, 1, __ATOMIC_RELEASE);
+    
+    return NULL;
+}
+
+/**
+ * @brief  single thread ring test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   a full ring must refuse and count the new sample, a batch pop must return the oldest samples in order
+ */
+static uint8_t a_ring_test_full(void)
+{
+    uint32_t i;
+    uint32_t num;
+    ring_sample_t sample;
+    ring_sample_t samples[RING_TEST_SIZE + 1];
+    
+    if ((ring_init(&gs_ring, gs_ring_buf, 0) != 1) || (ring_init(&gs_ring, gs_ring_buf, 6) != 1) ||
+        (ring_init(&gs_ring, NULL, RING_TEST_SIZE) != 1))
+    {
+        htu31d_interface_debug_print("ring: invalid size is not rejected.\n");
+        
+        return 1;
+    }
+    (void)ring_init(&gs_ring, gs_ring_buf, RING_TEST_SIZE);
+    memset(&sample, 0, sizeof(ring_sample_t));
+    
+    /* wrap the indexes once before filling */
+    for (i = 0; i < RING_TEST_SIZE / 2 + 1; i++)
+    {
+        (void)ring_push(&gs_ring, &sample);
+    }
+    if (ring_pop_batch(&gs_ring, samples, RING_TEST_SIZE + 1) != RING_TEST_SIZE / 2 + 1)
+    {
+        htu31d_interface_debug_print("ring: pop returned a wrong number.\n");
+        
+        return 1;
+    }
+    for (i = 0; i < RING_TEST_SIZE + 2; i++)
+    {
+        sample.timestamp_us = i;
+        if (ring_push(&gs_ring, &sample) != ((i < RING_TEST_SIZE) ? 0 : 1))
+        {
+            htu31d_interface_debug_print("ring: push %d returned a wrong status.\n", i);
+            
+            return 1;
+        }
+    }
+    if (ring_get_dropped(&gs_ring) != 2)
+    {
+        htu31d_interface_debug_print("ring: dropped %d but expect 2.\n", (uint32_t)ring_get_dropped(&gs_ring));
+        
+        return 1;
+    }
+    num = ring_pop_batch(&gs_ring, samples, RING_TEST_BATCH);
+    num += ring_pop_batch(&gs_ring, samples + num, RING_TEST_SIZE + 1 - num);
+    if (num != RING_TEST_SIZE)
+    {
+        htu31d_interface_debug_print("ring: popped %d but expect %d.\n", num, RING_TEST_SIZE);
+        
+        return 1;
+    }
+    for (i = 0; i < num; i++)
+    {
+        if (samples[i].timestamp_us != i)
+        {
+            htu31d_interface_debug_print("ring: sample %d is out of order.\n", i);
+            
+            return 1;
+        }
+    }
+    if (ring_pop_batch(&gs_ring, samples, RING_TEST_SIZE) != 0)
+    {
+        htu31d_interface_debug_print("ring: empty ring returned samples.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  ring test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   it checks the full ring drop counting in one thread, then runs a producer and a consumer thread
+ *         over a small ring so the indexes wrap many times
+ */
+uint8_t ring_test(void)
+{
+    uint8_t done;
+    uint32_t i;
+    uint32_t num;
+    uint64_t popped;
+    uint64_t next;
+    pthread_t producer;
+    ring_sample_t samples[RING_TEST_BATCH];
+    
+    /* start ring test */
+    htu31d_interface_debug_print("ring: start ring test.\n");
+    
+    /* full ring */
+    htu31d_interface_debug_print("ring: full ring test.\n");
+    if (a_ring_test_full() != 0)
+    {
+        return 1;
+    }
+    
+    /* producer and consumer threads */
+    htu31d_interface_debug_print("ring: two threads test.\n");
+    (void)ring_init(&gs_ring, gs_ring_buf, RING_TEST_SIZE);
+    gs_ring_pushed = 0;
+    gs_ring_done = 0;
+    if (pthread_create(&producer, NULL, a_ring_test_producer, NULL) != 0)
+    {
+        htu31d_interface_debug_print("ring: create thread failed.\n");
+        
+        return 1;
+    }
+    popped = 0;
+    next = 0;
+    do
+    {
+        done = __atomic_load_n(&gs_ring_done, __ATOMIC_ACQUIRE);
+        while ((num = ring_pop_batch(&gs_ring, samples, RING_TEST_BATCH)) != 0)
+        {
+            for (i = 0; i < num; i++)
+            {
+                /* dropped samples leave gaps, but the order must never go back */
+                if ((samples[i].timestamp_us < next) ||
+                    (samples[i].temperature_raw != (uint16_t)samples[i].timestamp_us) ||
+                    (samples[i].humidity_raw != (uint16_t)~samples[i].timestamp_us))
+                {
+                    htu31d_interface_debug_print("ring: sample %d is out of order or torn.\n",
+                                                 (uint32_t)samples[i].timestamp_us);
+                    (void)pthread_join(producer, NULL);
+                    
+                    return 1;
+                }
+                next = samples[i].timestamp_us + 1;
+            }
+            popped += num;
+        }
+        
+        /* let the producer refill the ring */
+        sched_yield();
+    } while (done == 0);
+    (void)pthread_join(producer, NULL);
+    if ((popped != gs_ring_pushed) || (popped + ring_get_dropped(&gs_ring) != RING_TEST_TIMES))
+    {
+        htu31d_interface_debug_print("ring: popped %d and dropped %d of %d samples.\n",
+                                     (uint32_t)popped, (uint32_t)ring_get_dropped(&gs_ring), RING_TEST_TIMES);
+        
+        return 1;
+    }
+    htu31d_interface_debug_print("ring: popped %d and dropped %d of %d samples.\n",
+                                 (uint32_t)popped, (uint32_t)ring_get_dropped(&gs_ring), RING_TEST_TIMES);
+    
+    /* finish ring test */
+    htu31d_interface_debug_print("ring: finish ring test.\n");
+    
+    return 0;
+}
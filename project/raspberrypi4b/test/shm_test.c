@@ -0,0 +1,245 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      shm_test.c
+ * @brief     shm test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "shm_test.h"
+#include "driver_htu31d_interface.h"
+#include <pthread.h>
+#include <sched.h>
+
+/**
+ * @brief shm test definition
+ */
+#define SHM_TEST_NAME     "/htu31d_test"        /**< shm object name */
+#define SHM_TEST_TIMES    100000                /**< published reading number */
+
+/**
+ * @brief shm test global variables definition
+ */
+static shm_publisher_t gs_publisher;                                            /**< publisher */
+static volatile uint8_t gs_shm_done;                                            /**< publisher finished flag */
+
+/**
+ * @brief     shm test publisher thread
+ * @param[in] *arg pointer to the thread argument
+ * @return    NULL
+ * @note      every field is derived from the timestamp, so a torn copy can be detected
+ */
+static void *a_shm_test_publisher(void *arg)
+{
+    uint32_t i;
+    shm_reading_t reading;
+    
+    (void)arg;
+    memset(&reading, 0, sizeof(shm_reading_t));
+    for (i = 0; i < SHM_TEST_TIMES; i++)
+    {
+        reading.timestamp_us = i;
+        reading.temperature_raw = (uint16_t)i;
+        reading.humidity_raw = (uint16_t)~i;
+        reading.temperature_centi = (int16_t)i;
+        reading.humidity_centi = (uint16_t)(i * 3);
+        reading.diagnostic = (uint8_t)i;
+        (void)shm_publish(&gs_publisher, 0, &reading);
+        if ((i & 0x3F) == 0)
+        {
+            /* let the reader run */
+            sched_yield();
+        }
+    }
+    __atomic_store_n(&gs_shm_done, 1, __ATOMIC_RELEASE);
+    
+    return NULL;
+}
+
+/**
+ * @brief     check a reading
+ * @param[in] *reading pointer to a reading structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 reading is torn
+ * @note      none
+ */
+static uint8_t a_shm_test_check(const shm_reading_t *reading)
+{
+    uint32_t i;
+    
+    i = (uint32_t)reading->timestamp_us;
+    if ((reading->count != i + 1) || (reading->temperature_raw != (uint16_t)i) ||
+        (reading->humidity_raw != (uint16_t)~i) || (reading->temperature_centi != (int16_t)i) ||
+        (reading->humidity_centi != (uint16_t)(i * 3)) || (reading->diagnostic != (uint8_t)i))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  shm test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   it reads a slot while a publisher thread writes it, then checks the busy slot a dead publisher
+ *         leaves behind and that reopening the publisher doesn't touch the stale region
+ */
+uint8_t shm_test(void)
+{
+    uint8_t res;
+    uint8_t done;
+    uint32_t reads;
+    uint32_t last;
+    pthread_t publisher;
+    shm_reading_t reading;
+    const shm_region_t *region;
+    const shm_region_t *stale;
+    
+    /* start shm test */
+    htu31d_interface_debug_print("shm: start shm test.\n");
+    
+    /* reader and publisher thread */
+    htu31d_interface_debug_print("shm: concurrent read test.\n");
+    if (shm_publisher_open(&gs_publisher, SHM_TEST_NAME, 2) != 0)
+    {
+        return 1;
+    }
+    region = shm_reader_open(SHM_TEST_NAME);
+    if (region == NULL)
+    {
+        htu31d_interface_debug_print("shm: reader open failed.\n");
+        shm_publisher_close(&gs_publisher, 1);
+        
+        return 1;
+    }
+    if ((shm_reader_read(region, 0, &reading) != 2) || (shm_reader_read(region, 2, &reading) != 1))
+    {
+        htu31d_interface_debug_print("shm: empty or invalid slot is not reported.\n");
+        shm_reader_close(region);
+        shm_publisher_close(&gs_publisher, 1);
+        
+        return 1;
+    }
+    gs_shm_done = 0;
+    if (pthread_create(&publisher, NULL, a_shm_test_publisher, NULL) != 0)
+    {
+        htu31d_interface_debug_print("shm: create thread failed.\n");
+        shm_reader_close(region);
+        shm_publisher_close(&gs_publisher, 1);
+        
+        return 1;
+    }
+    reads = 0;
+    last = 0;
+    do
+    {
+        done = __atomic_load_n(&gs_shm_done, __ATOMIC_ACQUIRE);
+        res = shm_reader_read(region, 0, &reading);
+        if (res == 0)
+        {
+            if ((a_shm_test_check(&reading) != 0) || (reading.count < last))
+            {
+                htu31d_interface_debug_print("shm: reading %d is torn or older than %d.\n", reading.count, last);
+                (void)pthread_join(publisher, NULL);
+                shm_reader_close(region);
+                shm_publisher_close(&gs_publisher, 1);
+                
+                return 1;
+            }
+            last = reading.count;
+            reads++;
+        }
+        sched_yield();
+    } while (done == 0);
+    (void)pthread_join(publisher, NULL);
+    if ((shm_reader_read(region, 0, &reading) != 0) || (reading.count != SHM_TEST_TIMES))
+    {
+        htu31d_interface_debug_print("shm: last reading is %d but expect %d.\n", reading.count, SHM_TEST_TIMES);
+        shm_reader_close(region);
+        shm_publisher_close(&gs_publisher, 1);
+        
+        return 1;
+    }
+    htu31d_interface_debug_print("shm: %d consistent reads of %d readings.\n", reads, SHM_TEST_TIMES);
+    
+    /* dead publisher */
+    htu31d_interface_debug_print("shm: dead publisher test.\n");
+    __atomic_store_n(&gs_publisher.region->slot[1].seq, 1, __ATOMIC_RELEASE);
+    if (shm_reader_read(region, 1, &reading) != 3)
+    {
+        htu31d_interface_debug_print("shm: slot left in a write is not reported busy.\n");
+        shm_reader_close(region);
+        shm_publisher_close(&gs_publisher, 1);
+        
+        return 1;
+    }
+    
+    /* reopen the publisher */
+    htu31d_interface_debug_print("shm: reopen test.\n");
+    stale = region;
+    shm_publisher_close(&gs_publisher, 0);
+    if (shm_publisher_open(&gs_publisher, SHM_TEST_NAME, 2) != 0)
+    {
+        shm_reader_close(stale);
+        
+        return 1;
+    }
+    region = shm_reader_open(SHM_TEST_NAME);
+    if (region == NULL)
+    {
+        htu31d_interface_debug_print("shm: reader open failed.\n");
+        shm_reader_close(stale);
+        shm_publisher_close(&gs_publisher, 1);
+        
+        return 1;
+    }
+    if ((region == stale) || (shm_reader_read(stale, 0, &reading) != 0) || (reading.count != SHM_TEST_TIMES) ||
+        (shm_reader_read(region, 0, &reading) != 2) || (shm_reader_read(region, 1, &reading) != 2))
+    {
+        htu31d_interface_debug_print("shm: reopen touched the stale region.\n");
+        shm_reader_close(region);
+        shm_reader_close(stale);
+        shm_publisher_close(&gs_publisher, 1);
+        
+        return 1;
+    }
+    shm_reader_close(region);
+    shm_reader_close(stale);
+    shm_publisher_close(&gs_publisher, 1);
+    
+    /* finish shm test */
+    htu31d_interface_debug_print("shm: finish shm test.\n");
+    
+    return 0;
+}
@@ -71,6 +71,14 @@ void delay_us(uint32_t us);
  */
 void delay_ms(uint32_t ms);
 
+/**
+ * @brief  get the time
+ * @return monotonic timestamp in us
+ * @note   it combines the 1 ms hal tick with the systick counter, so the resolution is 1 us
+ *         and the value wraps at 2^32 us like a free running counter
+ */
+uint32_t delay_get_us(void);
+
 /**
  * @}
  */
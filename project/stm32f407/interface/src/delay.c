@@ -107,3 +107,32 @@ void delay_ms(uint32_t ms)
     /* use the hal delay */
     HAL_Delay(ms);
 }
+
+/**
+ * @brief  get the time
+ * @return monotonic timestamp in us
+ * @note   it combines the 1 ms hal tick with the systick counter, so the resolution is 1 us
+ *         and the value wraps at 2^32 us like a free running counter
+ */
+uint32_t delay_get_us(void)
+{
+    uint32_t tick;
+    uint32_t val;
+    uint32_t pending;
+    
+    /* read the tick and the counter without a tick in between */
+    do
+    {
+        tick = HAL_GetTick();
+        val = SysTick->VAL;
+        pending = SCB->ICSR & SCB_ICSR_PENDSTSET_Msk;
+    } while (tick != HAL_GetTick());
+    
+    /* a reload whose interrupt is not served yet is one more tick */
+    if ((pending != 0) && (val > SysTick->LOAD / 2))
+    {
+        tick++;
+    }
+    
+    return tick * 1000 + (SysTick->LOAD - val) / gs_fac_us;
+}
@@ -60,6 +60,119 @@
 #define HTU31D_COMMAND_READ_SERIAL_NUMBER      (0x0A)            /**< read serial number command */
 #define HTU31D_COMMAND_READ_DIAGNOSTIC         (1 << 3)          /**< read diagnostic command */
 
+/**
+ * @brief crc table size definition
+ * @note  256 uses the byte table, 16 uses the nibble table when the flash is tight
+ */
+#ifndef HTU31D_CRC_TABLE_SIZE
+    #define HTU31D_CRC_TABLE_SIZE 256        /**< 256 entries */
+#endif
+
+/**
+ * @brief statistics atomic access definition
+ * @note  1 updates and resets the counters with relaxed gcc atomics so another thread can scrape them,
+ *        0 uses plain accesses and the statistics must be read from the sampling context
+ */
+#ifndef HTU31D_STATISTICS_ATOMIC
+    #if defined(__GCC_ATOMIC_INT_LOCK_FREE) && (__GCC_ATOMIC_INT_LOCK_FREE == 2)
+        #define HTU31D_STATISTICS_ATOMIC 1        /**< atomic */
+    #else
+        #define HTU31D_STATISTICS_ATOMIC 0        /**< plain */
+    #endif
+#endif
+
+/**
+ * @brief         add to a statistics counter
+ * @param[in,out] *counter pointer to a counter
+ * @param[in]     value added value
+ * @note          none
+ */
+static void a_htu31d_statistics_add(uint32_t *counter, uint32_t value)
+{
+#if (HTU31D_STATISTICS_ATOMIC == 1)
+    (void)__atomic_fetch_add(counter, value, __ATOMIC_RELAXED);       /* atomic add */
+#else
+    *counter += value;                                                /* add */
+#endif
+}
+
+/**
+ * @brief         add to a 64 bits statistics counter
+ * @param[in,out] *counter pointer to a counter
+ * @param[in]     value added value
+ * @note          targets without lock free 64 bits atomics use a plain add
+ */
+static void a_htu31d_statistics_add_64(uint64_t *counter, uint32_t value)
+{
+#if (HTU31D_STATISTICS_ATOMIC == 1) && defined(__GCC_ATOMIC_LLONG_LOCK_FREE) && (__GCC_ATOMIC_LLONG_LOCK_FREE == 2)
+    (void)__atomic_fetch_add(counter, (uint64_t)value, __ATOMIC_RELAXED);   /* atomic add */
+#else
+    *counter += value;                                                      /* add */
+#endif
+}
+
+/**
+ * @brief         read a statistics counter
+ * @param[in,out] *counter pointer to a counter
+ * @param[in]     reset clear the counter in the same step
+ * @return        counter value
+ * @note          none
+ */
+static uint32_t a_htu31d_statistics_take(uint32_t *counter, htu31d_bool_t reset)
+{
+    uint32_t value;
+    
+#if (HTU31D_STATISTICS_ATOMIC == 1)
+    if (reset == HTU31D_BOOL_TRUE)                                    /* check reset */
+    {
+        value = __atomic_exchange_n(counter, 0, __ATOMIC_RELAXED);    /* atomic read and clear */
+    }
+    else
+    {
+        value = __atomic_load_n(counter, __ATOMIC_RELAXED);           /* atomic read */
+    }
+#else
+    value = *counter;                                                 /* read */
+    if (reset == HTU31D_BOOL_TRUE)                                    /* check reset */
+    {
+        *counter = 0;                                                 /* clear */
+    }
+#endif
+    
+    return value;                                                     /* return the value */
+}
+
+/**
+ * @brief         read a 64 bits statistics counter
+ * @param[in,out] *counter pointer to a counter
+ * @param[in]     reset clear the counter in the same step
+ * @return        counter value
+ * @note          targets without lock free 64 bits atomics use a plain access
+ */
+static uint64_t a_htu31d_statistics_take_64(uint64_t *counter, htu31d_bool_t reset)
+{
+    uint64_t value;
+    
+#if (HTU31D_STATISTICS_ATOMIC == 1) && defined(__GCC_ATOMIC_LLONG_LOCK_FREE) && (__GCC_ATOMIC_LLONG_LOCK_FREE == 2)
+    if (reset == HTU31D_BOOL_TRUE)                                    /* check reset */
+    {
+        value = __atomic_exchange_n(counter, 0, __ATOMIC_RELAXED);    /* atomic read and clear */
+    }
+    else
+    {
+        value = __atomic_load_n(counter, __ATOMIC_RELAXED);           /* atomic read */
+    }
+#else
+    value = *counter;                                                 /* read */
+    if (reset == HTU31D_BOOL_TRUE)                                    /* check reset */
+    {
+        *counter = 0;                                                 /* clear */
+    }
+#endif
+    
+    return value;                                                     /* return the value */
+}
+
 /**
  * @brief     write bytes
  * @param[in] *handle pointer to an htu31d handle structure
@@ -73,12 +186,31 @@
  */
 static uint8_t a_htu31d_write(htu31d_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    if (handle->iic_write(handle->iic_addr, reg, buf, len) != 0)        /* iic write */
+    uint8_t res;
+    
+    if (handle->iic_write_ctx != NULL)                                                    /* check iic_write_ctx */
     {
-        return 1;                                                       /* return error */
+        res = handle->iic_write_ctx(handle->user_data, handle->iic_addr, reg, buf, len);  /* iic write with context */
+    }
+    else
+    {
+        res = handle->iic_write(handle->iic_addr, reg, buf, len);                         /* iic write */
+    }
+    if (handle->statistics != NULL)                                                       /* check statistics */
+    {
+        a_htu31d_statistics_add(&handle->statistics->write_count, 1);                     /* count the write */
+        a_htu31d_statistics_add(&handle->statistics->write_bytes, 1 + len);               /* count the bytes */
+        if (res != 0)                                                                     /* check the result */
+        {
+            a_htu31d_statistics_add(&handle->statistics->write_failed, 1);                /* count the failure */
+        }
+    }
+    if (res != 0)                                                                         /* check the result */
+    {
+        return 1;                                                                         /* return error */
     }
     
-    return 0;                                                           /* success return 0 */
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
@@ -94,64 +226,236 @@ static uint8_t a_htu31d_write(htu31d_handle_t *handle, uint8_t reg, uint8_t *buf
  */
 static uint8_t a_htu31d_read(htu31d_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    if (handle->iic_read(handle->iic_addr, reg, buf, len) != 0)        /* iic read */
+    uint8_t res;
+    
+    if (handle->iic_read_ctx != NULL)                                                     /* check iic_read_ctx */
+    {
+        res = handle->iic_read_ctx(handle->user_data, handle->iic_addr, reg, buf, len);   /* iic read with context */
+    }
+    else
+    {
+        res = handle->iic_read(handle->iic_addr, reg, buf, len);                          /* iic read */
+    }
+    if (handle->statistics != NULL)                                                       /* check statistics */
+    {
+        a_htu31d_statistics_add(&handle->statistics->read_count, 1);                      /* count the read */
+        a_htu31d_statistics_add(&handle->statistics->read_bytes, len);                    /* count the bytes */
+        if (res != 0)                                                                     /* check the result */
+        {
+            a_htu31d_statistics_add(&handle->statistics->read_failed, 1);                 /* count the failure */
+        }
+    }
+    if (res != 0)                                                                         /* check the result */
+    {
+        return 1;                                                                         /* return error */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief  iic bus init
+ * @param  *handle pointer to an htu31d handle structure
+ * @return status code
+ *         - 0 success
+ *         - 1 iic init failed
+ * @note   none
+ */
+static uint8_t a_htu31d_iic_init(htu31d_handle_t *handle)
+{
+    if (handle->iic_init_ctx != NULL)                          /* check iic_init_ctx */
     {
-        return 1;                                                      /* return error */
+        return handle->iic_init_ctx(handle->user_data);        /* iic init with context */
     }
     
-    return 0;                                                          /* success return 0 */
+    return handle->iic_init();                                 /* iic init */
 }
 
 /**
- * @brief     check the crc
- * @param[in] *buf pointer to a data buffer
- * @param[in] len buffer length
- * @param[in] crc checked crc
- * @return    status code
- *            - 0 pass
- *            - 1 error
+ * @brief  iic bus deinit
+ * @param  *handle pointer to an htu31d handle structure
+ * @return status code
+ *         - 0 success
+ *         - 1 iic deinit failed
+ * @note   none
+ */
+static uint8_t a_htu31d_iic_deinit(htu31d_handle_t *handle)
+{
+    if (handle->iic_deinit_ctx != NULL)                        /* check iic_deinit_ctx */
+    {
+        return handle->iic_deinit_ctx(handle->user_data);      /* iic deinit with context */
+    }
+    
+    return handle->iic_deinit();                               /* iic deinit */
+}
+
+/**
+ * @brief     delay ms
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] ms delay time in ms
+ * @note      none
+ */
+static void a_htu31d_delay_ms(htu31d_handle_t *handle, uint32_t ms)
+{
+    if (handle->delay_ms_ctx != NULL)                          /* check delay_ms_ctx */
+    {
+        handle->delay_ms_ctx(handle->user_data, ms);           /* delay with context */
+    }
+    else
+    {
+        handle->delay_ms(ms);                                  /* delay */
+    }
+}
+
+/**
+ * @brief     get the start timestamp of a measured api call
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @return    timestamp in us
+ * @note      the clock is only read when the statistics and timestamp_us are linked
+ */
+static uint32_t a_htu31d_statistics_start(htu31d_handle_t *handle)
+{
+    if ((handle->statistics == NULL) || (handle->timestamp_us == NULL))      /* check statistics */
+    {
+        return 0;                                                            /* no clock */
+    }
+    
+    return handle->timestamp_us();                                           /* return the timestamp */
+}
+
+/**
+ * @brief     record the latency of an api call
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] api measured api
+ * @param[in] start start timestamp in us
  * @note      none
  */
-static uint8_t a_htu31d_crc(uint8_t *buf, uint8_t len, uint32_t crc)
+static void a_htu31d_statistics_latency(htu31d_handle_t *handle, htu31d_statistics_api_t api, uint32_t start)
 {
-    uint32_t polynom = 0x98800000UL;
-    uint32_t msb = 0x80000000UL;
-    uint32_t mask = 0xFF800000UL;
-    uint32_t result = 0;
+    uint32_t us;
+    uint8_t bucket;
     
-    if (len == 1)                                                             /* if len == 1 */
+    if ((handle->statistics == NULL) || (handle->timestamp_us == NULL))      /* check statistics */
     {
-        result = (uint32_t)buf[0] << 8;                                       /* set to buffer */
+        return;                                                              /* no clock */
     }
-    else if (len == 2)                                                        /* if len == 2 */
+    us = handle->timestamp_us() - start;                                     /* get the latency */
+    bucket = 0;                                                              /* init 0 */
+    while (((us >> 1) != 0) && (bucket < (HTU31D_STATISTICS_BUCKETS - 1)))   /* find the log2 bucket */
     {
-        result = (uint32_t)buf[0] << 16;                                      /* set part 0 */
-        result |= (uint32_t)buf[1] << 8;                                      /* set part 1 */
+        us >>= 1;                                                            /* next power */
+        bucket++;                                                            /* next bucket */
     }
-    else if (len == 3)                                                        /* if len == 3 */
+    a_htu31d_statistics_add(&handle->statistics->latency[api][bucket], 1);   /* count the latency */
+}
+
+/**
+ * @brief     record a crc error
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] command failed read command
+ * @note      none
+ */
+static void a_htu31d_statistics_crc_error(htu31d_handle_t *handle, htu31d_statistics_command_t command)
+{
+    if (handle->statistics != NULL)                                          /* check statistics */
     {
-        result = buf[0];                                                      /* set buf 0 */
-        result <<= 8;                                                         /* left shift 8 */
-        result |= buf[1];                                                     /* set buf 1 */
-        result <<= 8;                                                         /* left shift 8 */
-        result |= buf[2];                                                     /* set buf 2 */
-        result <<= 8;                                                         /* left shift 8 */
+        a_htu31d_statistics_add(&handle->statistics->crc_error[command], 1); /* count the error */
     }
-    else
+}
+
+/**
+ * @brief     record a conversion wait
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] us waited time in us
+ * @note      none
+ */
+static void a_htu31d_statistics_wait(htu31d_handle_t *handle, uint32_t us)
+{
+    if (handle->statistics != NULL)                                          /* check statistics */
     {
-        return 1;                                                             /* return error */
+        a_htu31d_statistics_add(&handle->statistics->wait_count, 1);         /* count the wait */
+        a_htu31d_statistics_add_64(&handle->statistics->wait_us, us);        /* add the time */
     }
-    while (msb != 0x80)                                                       /* check the msb */
+}
+
+#if (HTU31D_CRC_TABLE_SIZE == 256)
+/**
+ * @brief crc8 byte table definition
+ */
+static const uint8_t gsc_htu31d_crc_table[256] =
+{
+    0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97, 0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F, 0x2E,
+    0x43, 0x72, 0x21, 0x10, 0x87, 0xB6, 0xE5, 0xD4, 0xFA, 0xCB, 0x98, 0xA9, 0x3E, 0x0F, 0x5C, 0x6D,
+    0x86, 0xB7, 0xE4, 0xD5, 0x42, 0x73, 0x20, 0x11, 0x3F, 0x0E, 0x5D, 0x6C, 0xFB, 0xCA, 0x99, 0xA8,
+    0xC5, 0xF4, 0xA7, 0x96, 0x01, 0x30, 0x63, 0x52, 0x7C, 0x4D, 0x1E, 0x2F, 0xB8, 0x89, 0xDA, 0xEB,
+    0x3D, 0x0C, 0x5F, 0x6E, 0xF9, 0xC8, 0x9B, 0xAA, 0x84, 0xB5, 0xE6, 0xD7, 0x40, 0x71, 0x22, 0x13,
+    0x7E, 0x4F, 0x1C, 0x2D, 0xBA, 0x8B, 0xD8, 0xE9, 0xC7, 0xF6, 0xA5, 0x94, 0x03, 0x32, 0x61, 0x50,
+    0xBB, 0x8A, 0xD9, 0xE8, 0x7F, 0x4E, 0x1D, 0x2C, 0x02, 0x33, 0x60, 0x51, 0xC6, 0xF7, 0xA4, 0x95,
+    0xF8, 0xC9, 0x9A, 0xAB, 0x3C, 0x0D, 0x5E, 0x6F, 0x41, 0x70, 0x23, 0x12, 0x85, 0xB4, 0xE7, 0xD6,
+    0x7A, 0x4B, 0x18, 0x29, 0xBE, 0x8F, 0xDC, 0xED, 0xC3, 0xF2, 0xA1, 0x90, 0x07, 0x36, 0x65, 0x54,
+    0x39, 0x08, 0x5B, 0x6A, 0xFD, 0xCC, 0x9F, 0xAE, 0x80, 0xB1, 0xE2, 0xD3, 0x44, 0x75, 0x26, 0x17,
+    0xFC, 0xCD, 0x9E, 0xAF, 0x38, 0x09, 0x5A, 0x6B, 0x45, 0x74, 0x27, 0x16, 0x81, 0xB0, 0xE3, 0xD2,
+    0xBF, 0x8E, 0xDD, 0xEC, 0x7B, 0x4A, 0x19, 0x28, 0x06, 0x37, 0x64, 0x55, 0xC2, 0xF3, 0xA0, 0x91,
+    0x47, 0x76, 0x25, 0x14, 0x83, 0xB2, 0xE1, 0xD0, 0xFE, 0xCF, 0x9C, 0xAD, 0x3A, 0x0B, 0x58, 0x69,
+    0x04, 0x35, 0x66, 0x57, 0xC0, 0xF1, 0xA2, 0x93, 0xBD, 0x8C, 0xDF, 0xEE, 0x79, 0x48, 0x1B, 0x2A,
+    0xC1, 0xF0, 0xA3, 0x92, 0x05, 0x34, 0x67, 0x56, 0x78, 0x49, 0x1A, 0x2B, 0xBC, 0x8D, 0xDE, 0xEF,
+    0x82, 0xB3, 0xE0, 0xD1, 0x46, 0x77, 0x24, 0x15, 0x3B, 0x0A, 0x59, 0x68, 0xFF, 0xCE, 0x9D, 0xAC
+};
+#elif (HTU31D_CRC_TABLE_SIZE == 16)
+/**
+ * @brief crc8 nibble table definition
+ */
+static const uint8_t gsc_htu31d_crc_table[16] =
+{
+    0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97, 0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F, 0x2E
+};
+#else
+    #error "HTU31D_CRC_TABLE_SIZE must be 256 or 16"
+#endif
+
+/**
+ * @brief     calculate the crc8
+ * @param[in] crc initial crc
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len buffer length
+ * @return    crc8
+ * @note      polynomial is 0x31 and initial value is 0x00
+ */
+static uint8_t a_htu31d_crc8(uint8_t crc, const uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    
+    for (i = 0; i < len; i++)                                                 /* loop all bytes */
     {
-        if ((result & msb) != 0)                                              /* check the result */
-        {
-            result = ((result ^ polynom) & mask) | (result & (~mask));        /* get the new result */
-        }
-        msb >>= 1;                                                            /* right shift 1 */
-        mask >>= 1;                                                           /* right shift 1 */
-        polynom >>= 1;                                                        /* right shift 1 */
+#if (HTU31D_CRC_TABLE_SIZE == 256)
+        crc = gsc_htu31d_crc_table[crc ^ buf[i]];                             /* byte step */
+#else
+        crc ^= buf[i];                                                        /* xor the byte */
+        crc = (uint8_t)(crc << 4) ^ gsc_htu31d_crc_table[crc >> 4];           /* high nibble step */
+        crc = (uint8_t)(crc << 4) ^ gsc_htu31d_crc_table[crc >> 4];           /* low nibble step */
+#endif
+    }
+    
+    return crc;                                                               /* return the crc */
+}
+
+/**
+ * @brief     check the crc
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len buffer length
+ * @param[in] crc checked crc
+ * @return    status code
+ *            - 0 pass
+ *            - 1 error
+ * @note      none
+ */
+static uint8_t a_htu31d_crc(uint8_t *buf, uint8_t len, uint8_t crc)
+{
+    if ((len == 0) || (len > 3))                                              /* check the length */
+    {
+        return 1;                                                             /* return error */
     }
-    if ((result & 0xFF) == (crc & 0xFF))                                      /* check the result */
+    if (a_htu31d_crc8(0x00, buf, len) == crc)                                 /* check the result */
     {
         return 0;                                                             /* success return 0 */
     }
@@ -161,6 +465,24 @@ static uint8_t a_htu31d_crc(uint8_t *buf, uint8_t len, uint32_t crc)
     }
 }
 
+/**
+ * @brief     check the crc of a t && rh frame
+ * @param[in] *buf pointer to a 6 bytes frame buffer
+ * @return    status code
+ *            - 0 pass
+ *            - 1 error
+ * @note      a valid data + crc field always leaves a zero remainder
+ */
+static uint8_t a_htu31d_crc_frame(const uint8_t *buf)
+{
+    if ((a_htu31d_crc8(0x00, buf, 3) | a_htu31d_crc8(0x00, buf + 3, 3)) != 0)  /* check both fields */
+    {
+        return 1;                                                             /* return error */
+    }
+    
+    return 0;                                                                 /* success return 0 */
+}
+
 /**
  * @brief     set the address pin
  * @param[in] *handle pointer to an htu31d handle structure
@@ -203,6 +525,48 @@ uint8_t htu31d_get_addr_pin(htu31d_handle_t *handle, htu31d_addr_pin_t *addr_pin
     return 0;                                                 /* success return 0 */
 }
 
+/**
+ * @brief     set the init mode
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] mode init mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      it is used by the next htu31d_init or htu31d_group_init
+ */
+uint8_t htu31d_set_init_mode(htu31d_handle_t *handle, htu31d_init_mode_t mode)
+{
+    if (handle == NULL)                  /* check handle */
+    {
+        return 2;                        /* return error */
+    }
+    
+    handle->init_mode = (uint8_t)mode;   /* set the init mode */
+    
+    return 0;                            /* success return 0 */
+}
+
+/**
+ * @brief      get the init mode
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *mode pointer to an init mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t htu31d_get_init_mode(htu31d_handle_t *handle, htu31d_init_mode_t *mode)
+{
+    if (handle == NULL)                                      /* check handle */
+    {
+        return 2;                                            /* return error */
+    }
+    
+    *mode = (htu31d_init_mode_t)(handle->init_mode);         /* get the init mode */
+    
+    return 0;                                                /* success return 0 */
+}
+
 /**
  * @brief     soft reset
  * @param[in] *handle pointer to an htu31d handle structure
@@ -216,6 +580,7 @@ uint8_t htu31d_get_addr_pin(htu31d_handle_t *handle, htu31d_addr_pin_t *addr_pin
 uint8_t htu31d_soft_reset(htu31d_handle_t *handle)
 {
     uint8_t res;
+    uint32_t start;
     
     if (handle == NULL)                                                 /* check handle */
     {
@@ -226,6 +591,7 @@ uint8_t htu31d_soft_reset(htu31d_handle_t *handle)
         return 3;                                                       /* return error */
     }
     
+    start = a_htu31d_statistics_start(handle);                          /* get the start time */
     res = a_htu31d_write(handle, HTU31D_COMMAND_RESET, NULL, 0);        /* soft reset */
     if (res != 0)                                                       /* check the result */
     {
@@ -233,7 +599,8 @@ uint8_t htu31d_soft_reset(htu31d_handle_t *handle)
         
         return 1;                                                       /* return error */
     }
-    handle->delay_ms(15);                                               /* delay 15 ms */
+    a_htu31d_delay_ms(handle, 15);                                      /* delay 15 ms */
+    a_htu31d_statistics_latency(handle, HTU31D_STATISTICS_API_SOFT_RESET, start);  /* record the latency */
     
     return 0;                                                           /* success return 0 */
 }
@@ -341,6 +708,7 @@ uint8_t htu31d_get_serial_number(htu31d_handle_t *handle, uint8_t number[3])
     }
     if (a_htu31d_crc(buf, 3, buf[3]) != 0)                                         /* check the crc */
     {
+        a_htu31d_statistics_crc_error(handle, HTU31D_STATISTICS_COMMAND_SERIAL_NUMBER); /* count the error */
         handle->debug_print("htu31d: crc checked error.\n");                       /* crc checked error */
         
         return 4;                                                                  /* return error */
@@ -385,52 +753,77 @@ uint8_t htu31d_get_diagnostic(htu31d_handle_t *handle, uint8_t *diagnostic)
     }
     if (a_htu31d_crc(buf, 1, buf[1]) != 0)                                      /* check the crc */
     {
+        a_htu31d_statistics_crc_error(handle, HTU31D_STATISTICS_COMMAND_DIAGNOSTIC); /* count the error */
         handle->debug_print("htu31d: crc checked error.\n");                    /* crc checked error */
         
         return 4;                                                               /* return error */
     }
-    *diagnostic = buf[1];                                                       /* copy to diagnostic */
+    *diagnostic = buf[0];                                                       /* copy to diagnostic */
     
     return 0;                                                                   /* success return 0 */
 }
 
 /**
- * @brief      read the temperature and humidity data
- * @param[in]  *handle pointer to an htu31d handle structure
- * @param[out] *temperature_raw pointer to a raw temperature buffer
- * @param[out] *temperature_s pointer to a converted temperature buffer
- * @param[out] *humidity_raw pointer to a raw humidity buffer
- * @param[out] *humidity_s pointer to a converted humidity buffer
+ * @brief conversion time table definition
+ * @note  datasheet maximum of humidity + temperature conversion in us, indexed by [humidity osr][temperature osr]
+ */
+static const uint16_t gsc_htu31d_conversion_time_us[4][4] =
+{
+    { 2600,  4100,  7100, 13100},        /* humidity osr 0 */
+    { 3600,  5100,  8100, 14100},        /* humidity osr 1 */
+    { 5500,  7000, 10000, 16000},        /* humidity osr 2 */
+    { 9400, 10900, 13900, 19900}         /* humidity osr 3 */
+};
+
+/**
+ * @brief      get the conversion time
+ * @param[in]  humidity_osr humidity osr of the conversion
+ * @param[in]  temperature_osr temperature osr of the conversion
+ * @param[out] *us pointer to a conversion time buffer
  * @return     status code
  *             - 0 success
- *             - 1 read temperature humidity failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 crc is error
- *             - 5 param is error
+ *             - 1 param is error
  * @note       none
  */
-uint8_t htu31d_read_temperature_humidity(htu31d_handle_t *handle,
-                                         uint16_t *temperature_raw, float *temperature_s,
-                                         uint16_t *humidity_raw, float *humidity_s
-                                        )
+static uint8_t a_htu31d_conversion_time(uint8_t humidity_osr, uint8_t temperature_osr, uint32_t *us)
+{
+    if ((humidity_osr > 3) || (temperature_osr > 3))                                 /* check the osr */
+    {
+        return 1;                                                                     /* return error */
+    }
+    *us = gsc_htu31d_conversion_time_us[humidity_osr][temperature_osr];              /* get the time */
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief     send the conversion command
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] humidity_osr humidity osr of the conversion
+ * @param[in] temperature_osr temperature osr of the conversion
+ * @return    status code
+ *            - 0 success
+ *            - 1 start conversion failed
+ *            - 5 param is error
+ * @note      none
+ */
+static uint8_t a_htu31d_start_conversion(htu31d_handle_t *handle, uint8_t humidity_osr, uint8_t temperature_osr)
 {
     uint8_t res;
     uint8_t prev;
-    uint8_t buf[6];
+    uint32_t us;
+    uint32_t start;
     
-    if (handle == NULL)                                                     /* check handle */
-    {
-        return 2;                                                           /* return error */
-    }
-    if (handle->inited != 1)                                                /* check handle initialization */
+    start = a_htu31d_statistics_start(handle);                              /* get the start time */
+    if (a_htu31d_conversion_time(humidity_osr, temperature_osr, &us) != 0)  /* get the conversion time */
     {
-        return 3;                                                           /* return error */
+        handle->debug_print("htu31d: param is error.\n");                   /* param is error */
+        
+        return 5;                                                           /* return error */
     }
-    
     prev = HTU31D_COMMAND_CONVERSION 
-           | (handle->humidity_osr & 0x3) << 3 
-           | (handle->temperature_osr & 0x3) << 1;                          /* set the command */
+           | (humidity_osr & 0x3) << 3 
+           | (temperature_osr & 0x3) << 1;                                  /* set the command */
     res = a_htu31d_write(handle, prev, NULL, 0);                            /* conversion */
     if (res != 0)                                                           /* check the result */
     {
@@ -438,51 +831,226 @@ uint8_t htu31d_read_temperature_humidity(htu31d_handle_t *handle,
         
         return 1;                                                           /* return error */
     }
-    if (handle->humidity_osr == 0)                                          /* osr 0 */
-    {
-        handle->delay_ms(2);                                                /* delay 2ms */
-    }
-    else if (handle->humidity_osr == 1)                                     /* osr 1 */
+    if (handle->timestamp_us != NULL)                                       /* check timestamp_us */
     {
-        handle->delay_ms(3);                                                /* delay 3ms */
+        handle->conversion_start = handle->timestamp_us();                  /* save the start time */
     }
-    else if (handle->humidity_osr == 2)                                     /* osr 2 */
+    handle->conversion_time = us;                                           /* save the conversion time */
+    handle->conversion = 1;                                                 /* flag conversion */
+    a_htu31d_statistics_latency(handle, HTU31D_STATISTICS_API_START_CONVERSION, start);  /* record the latency */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief     get the temperature osr used by a humidity conversion
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @return    temperature osr
+ * @note      the chip always converts both channels, so the humidity priority
+ *            mode shortens the temperature part to the minimum osr
+ */
+static uint8_t a_htu31d_humidity_temperature_osr(htu31d_handle_t *handle)
+{
+    if (handle->humidity_priority != 0)                  /* humidity priority */
     {
-        handle->delay_ms(5);                                                /* delay 5ms */
+        return HTU31D_TEMPERATURE_OSR_LOW;               /* shortest temperature conversion */
     }
-    else if (handle->humidity_osr == 3)                                     /* osr 3 */
-    {
-        handle->delay_ms(9);                                                /* delay 9ms */
+    
+    return handle->temperature_osr;                      /* configured osr */
+}
+
+/**
+ * @brief     start a conversion without waiting for the result
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start conversion failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 param is error
+ * @note      the result can be fetched after the conversion time
+ */
+uint8_t htu31d_start_conversion(htu31d_handle_t *handle)
+{
+    if (handle == NULL)                                                             /* check handle */
+    {
+        return 2;                                                                   /* return error */
     }
-    else
+    if (handle->inited != 1)                                                        /* check handle initialization */
     {
-        handle->debug_print("htu31d: param is error.\n");                   /* param is error */
-        
-        return 5;                                                           /* return error */
+        return 3;                                                                   /* return error */
     }
-    if (handle->temperature_osr == 0)                                       /* osr 0 */
+    
+    return a_htu31d_start_conversion(handle, handle->humidity_osr,
+                                     handle->temperature_osr);                      /* start conversion */
+}
+
+/**
+ * @brief     start a conversion for a humidity only read
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start conversion failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 param is error
+ * @note      in the humidity priority mode the temperature osr of this conversion is the lowest
+ */
+uint8_t htu31d_start_humidity_conversion(htu31d_handle_t *handle)
+{
+    if (handle == NULL)                                                             /* check handle */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if (handle->inited != 1)                                                        /* check handle initialization */
+    {
+        return 3;                                                                   /* return error */
+    }
+    
+    return a_htu31d_start_conversion(handle, handle->humidity_osr,
+                                     a_htu31d_humidity_temperature_osr(handle));    /* start conversion */
+}
+
+/**
+ * @brief     start a conversion for a temperature only read
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start conversion failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 param is error
+ * @note      the humidity part of this conversion always uses the lowest osr
+ */
+uint8_t htu31d_start_temperature_conversion(htu31d_handle_t *handle)
+{
+    if (handle == NULL)                                                             /* check handle */
     {
-        handle->delay_ms(2);                                                /* delay 2ms */
+        return 2;                                                                   /* return error */
     }
-    else if (handle->temperature_osr == 1)                                  /* osr 1 */
+    if (handle->inited != 1)                                                        /* check handle initialization */
     {
-        handle->delay_ms(4);                                                /* delay 4ms */
+        return 3;                                                                   /* return error */
     }
-    else if (handle->temperature_osr == 2)                                  /* osr 2 */
+    
+    return a_htu31d_start_conversion(handle, HTU31D_HUMIDITY_OSR_LOW,
+                                     handle->temperature_osr);                      /* start conversion */
+}
+
+/**
+ * @brief      get the conversion time of the current osr
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *us pointer to a conversion time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 5 param is error
+ * @note       none
+ */
+uint8_t htu31d_get_conversion_time(htu31d_handle_t *handle, uint32_t *us)
+{
+    if (handle == NULL)                                                     /* check handle */
     {
-        handle->delay_ms(7);                                                /* delay 7ms */
+        return 2;                                                           /* return error */
     }
-    else if (handle->temperature_osr == 3)                                  /* osr 3 */
+    if (handle->inited != 1)                                                /* check handle initialization */
     {
-        handle->delay_ms(13);                                               /* delay 13ms */
+        return 3;                                                           /* return error */
     }
-    else
+    
+    if (a_htu31d_conversion_time(handle->humidity_osr,
+                                 handle->temperature_osr, us) != 0)         /* get the conversion time */
     {
         handle->debug_print("htu31d: param is error.\n");                   /* param is error */
         
         return 5;                                                           /* return error */
     }
     
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief      check whether the started conversion is finished
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *ready pointer to a ready flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timestamp_us is null
+ *             - 5 no conversion is started
+ * @note       the check compares the elapsed time with the osr deadline and doesn't access the bus
+ */
+uint8_t htu31d_is_conversion_ready(htu31d_handle_t *handle, uint8_t *ready)
+{
+    uint32_t elapsed;
+    
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    if (handle->timestamp_us == NULL)                                       /* check timestamp_us */
+    {
+        handle->debug_print("htu31d: timestamp_us is null.\n");             /* timestamp_us is null */
+        
+        return 4;                                                           /* return error */
+    }
+    if (handle->conversion != 1)                                            /* check the conversion */
+    {
+        handle->debug_print("htu31d: no conversion is started.\n");         /* no conversion is started */
+        
+        return 5;                                                           /* return error */
+    }
+    
+    elapsed = handle->timestamp_us() - handle->conversion_start;            /* get the elapsed time */
+    *ready = (elapsed >= handle->conversion_time) ? 1 : 0;                  /* check the deadline */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief     record the latency of a fetch and of the blocking read it finishes
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] start fetch start timestamp in us
+ * @note      none
+ */
+static void a_htu31d_statistics_fetched(htu31d_handle_t *handle, uint32_t start)
+{
+    if (handle->statistics == NULL)                                                           /* check statistics */
+    {
+        return;                                                                               /* disabled */
+    }
+    a_htu31d_statistics_latency(handle, HTU31D_STATISTICS_API_FETCH, start);                  /* record the fetch */
+    if (handle->read_pending != 0)                                                            /* check the blocking read */
+    {
+        handle->read_pending = 0;                                                             /* clear the flag */
+        a_htu31d_statistics_latency(handle, HTU31D_STATISTICS_API_READ, handle->read_start);  /* record the read */
+    }
+}
+
+/**
+ * @brief      fetch the raw temperature and humidity data
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 4 crc is error
+ * @note       none
+ */
+static uint8_t a_htu31d_fetch_temperature_humidity(htu31d_handle_t *handle, uint16_t *temperature_raw, uint16_t *humidity_raw)
+{
+    uint8_t res;
+    uint32_t start;
+    uint8_t buf[6];
+    
+    start = a_htu31d_statistics_start(handle);                              /* get the start time */
     res = a_htu31d_read(handle, HTU31D_COMMAND_READ_T_RH, buf, 6);          /* read t && rh */
     if (res != 0)                                                           /* check the result */
     {
@@ -490,349 +1058,2002 @@ uint8_t htu31d_read_temperature_humidity(htu31d_handle_t *handle,
         
         return 1;                                                           /* return error */
     }
-    if (a_htu31d_crc(buf, 2, buf[2]) != 0)                                  /* check the crc */
-    {
-        handle->debug_print("htu31d: crc checked error.\n");                /* crc checked error */
-        
-        return 4;                                                           /* return error */
-    }
-    if (a_htu31d_crc(buf + 3, 2, buf[5]) != 0)                              /* check the crc */
+    handle->conversion = 0;                                                 /* clear conversion flag */
+    if (a_htu31d_crc_frame(buf) != 0)                                       /* check the crc */
     {
+        a_htu31d_statistics_crc_error(handle, HTU31D_STATISTICS_COMMAND_T_RH);   /* count the error */
         handle->debug_print("htu31d: crc checked error.\n");                /* crc checked error */
         
         return 4;                                                           /* return error */
     }
     *temperature_raw = ((uint16_t)buf[0] << 8) | buf[1];                    /* set temperature raw */
     *humidity_raw = ((uint16_t)buf[3] << 8) | buf[4];                       /* set humidity raw */
-    
-    *temperature_s = (float)(*temperature_raw) / 65535.0f * 165.0f - 40.0f; /* convert raw temperature */
-    *humidity_s = (float)(*humidity_raw) / 65535.0f * 100.0f;               /* convert raw humidity */
+    a_htu31d_statistics_fetched(handle, start);                             /* record the latency */
     
     return 0;                                                               /* success return 0 */
 }
 
 /**
- * @brief      read the humidity data
+ * @brief      fetch the raw humidity data
  * @param[in]  *handle pointer to an htu31d handle structure
  * @param[out] *humidity_raw pointer to a raw humidity buffer
- * @param[out] *humidity_s pointer to a converted humidity buffer
  * @return     status code
  *             - 0 success
- *             - 1 read humidity failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
+ *             - 1 read failed
  *             - 4 crc is error
- *             - 5 param is error
  * @note       none
  */
-uint8_t htu31d_read_humidity(htu31d_handle_t *handle, uint16_t *humidity_raw, float *humidity_s)
+static uint8_t a_htu31d_fetch_humidity(htu31d_handle_t *handle, uint16_t *humidity_raw)
 {
     uint8_t res;
-    uint8_t prev;
+    uint32_t start;
     uint8_t buf[3];
     
-    if (handle == NULL)                                                     /* check handle */
+    start = a_htu31d_statistics_start(handle);                              /* get the start time */
+    res = a_htu31d_read(handle, HTU31D_COMMAND_READ_RH, buf, 3);            /* read rh */
+    if (res != 0)                                                           /* check the result */
     {
-        return 2;                                                           /* return error */
+        handle->debug_print("htu31d: read rh failed.\n");                   /* read rh failed */
+        
+        return 1;                                                           /* return error */
     }
-    if (handle->inited != 1)                                                /* check handle initialization */
+    handle->conversion = 0;                                                 /* clear conversion flag */
+    if (a_htu31d_crc(buf, 2, buf[2]) != 0)                                  /* check the crc */
     {
-        return 3;                                                           /* return error */
+        a_htu31d_statistics_crc_error(handle, HTU31D_STATISTICS_COMMAND_RH);   /* count the error */
+        handle->debug_print("htu31d: crc checked error.\n");                /* crc checked error */
+        
+        return 4;                                                           /* return error */
     }
+    *humidity_raw = ((uint16_t)buf[0] << 8) | buf[1];                       /* set humidity raw */
+    a_htu31d_statistics_fetched(handle, start);                             /* record the latency */
     
-    prev = HTU31D_COMMAND_CONVERSION 
-           | (handle->humidity_osr & 0x3) << 3 
-           | (handle->temperature_osr & 0x3) << 1;                          /* set the command */
-    res = a_htu31d_write(handle, prev, NULL, 0);                            /* conversion */
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief      fetch the raw temperature data
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 4 crc is error
+ * @note       the t && rh read is stopped after the temperature field
+ */
+static uint8_t a_htu31d_fetch_temperature(htu31d_handle_t *handle, uint16_t *temperature_raw)
+{
+    uint8_t res;
+    uint32_t start;
+    uint8_t buf[3];
+    
+    start = a_htu31d_statistics_start(handle);                              /* get the start time */
+    res = a_htu31d_read(handle, HTU31D_COMMAND_READ_T_RH, buf, 3);          /* read t */
     if (res != 0)                                                           /* check the result */
     {
-        handle->debug_print("htu31d: write failed.\n");                     /* write failed */
+        handle->debug_print("htu31d: read t failed.\n");                    /* read t failed */
         
         return 1;                                                           /* return error */
     }
-    if (handle->humidity_osr == 0)                                          /* osr 0 */
+    handle->conversion = 0;                                                 /* clear conversion flag */
+    if (a_htu31d_crc(buf, 2, buf[2]) != 0)                                  /* check the crc */
     {
-        handle->delay_ms(2);                                                /* delay 2ms */
+        a_htu31d_statistics_crc_error(handle, HTU31D_STATISTICS_COMMAND_T);   /* count the error */
+        handle->debug_print("htu31d: crc checked error.\n");                /* crc checked error */
+        
+        return 4;                                                           /* return error */
     }
-    else if (handle->humidity_osr == 1)                                     /* osr 1 */
+    *temperature_raw = ((uint16_t)buf[0] << 8) | buf[1];                    /* set temperature raw */
+    a_htu31d_statistics_fetched(handle, start);                             /* record the latency */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief     delay with the finest linked delay function
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] us delay time in us
+ * @note      delay_ms rounds the time up
+ */
+static void a_htu31d_delay(htu31d_handle_t *handle, uint32_t us)
+{
+    if (us == 0)                                          /* check the time */
     {
-        handle->delay_ms(3);                                                /* delay 3ms */
+        return;                                           /* nothing to wait */
     }
-    else if (handle->humidity_osr == 2)                                     /* osr 2 */
+    if (handle->delay_us != NULL)                         /* check delay_us */
     {
-        handle->delay_ms(5);                                                /* delay 5ms */
+        handle->delay_us(us);                             /* delay us */
     }
-    else if (handle->humidity_osr == 3)                                     /* osr 3 */
+    else
     {
-        handle->delay_ms(9);                                                /* delay 9ms */
+        a_htu31d_delay_ms(handle, (us + 999) / 1000);     /* delay ms */
     }
-    else
+}
+
+/**
+ * @brief     delay until a time point after a start timestamp
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] start start timestamp in us
+ * @param[in] us time after the start in us
+ * @return    waited time in us
+ * @note      without timestamp_us the whole time is waited
+ */
+static uint32_t a_htu31d_delay_until(htu31d_handle_t *handle, uint32_t start, uint32_t us)
+{
+    uint32_t elapsed;
+    
+    if (handle->timestamp_us == NULL)                     /* check timestamp_us */
     {
-        handle->debug_print("htu31d: param is error.\n");                   /* param is error */
+        a_htu31d_delay(handle, us);                       /* wait the whole time */
         
-        return 5;                                                           /* return error */
+        return us;                                        /* return the waited time */
     }
-    if (handle->temperature_osr == 0)                                       /* osr 0 */
+    elapsed = handle->timestamp_us() - start;             /* get the elapsed time */
+    if (elapsed < us)                                     /* check the elapsed time */
     {
-        handle->delay_ms(2);                                                /* delay 2ms */
+        a_htu31d_delay(handle, us - elapsed);             /* wait the remaining time */
+        
+        return us - elapsed;                              /* return the waited time */
     }
-    else if (handle->temperature_osr == 1)                                  /* osr 1 */
+    
+    return 0;                                             /* no wait */
+}
+
+/**
+ * @brief     start a conversion and wait until it is finished
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] channel 0 for both, 1 for humidity only, 2 for temperature only
+ * @return    status code
+ *            - 0 success
+ *            - 1 conversion failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 param is error
+ * @note      none
+ */
+static uint8_t a_htu31d_convert(htu31d_handle_t *handle, uint8_t channel)
+{
+    uint8_t res;
+    
+    if (handle->statistics != NULL)                                         /* check statistics */
     {
-        handle->delay_ms(4);                                                /* delay 4ms */
+        handle->read_start = a_htu31d_statistics_start(handle);             /* get the start time */
+        handle->read_pending = 1;                                           /* flag the blocking read */
     }
-    else if (handle->temperature_osr == 2)                                  /* osr 2 */
+    if (channel == 1)                                                       /* humidity only */
     {
-        handle->delay_ms(7);                                                /* delay 7ms */
+        res = htu31d_start_humidity_conversion(handle);                     /* start humidity conversion */
     }
-    else if (handle->temperature_osr == 3)                                  /* osr 3 */
+    else if (channel == 2)                                                  /* temperature only */
     {
-        handle->delay_ms(13);                                               /* delay 13ms */
+        res = htu31d_start_temperature_conversion(handle);                  /* start temperature conversion */
     }
     else
     {
-        handle->debug_print("htu31d: param is error.\n");                   /* param is error */
-        
-        return 5;                                                           /* return error */
+        res = htu31d_start_conversion(handle);                              /* start conversion */
     }
-    
-    res = a_htu31d_read(handle, HTU31D_COMMAND_READ_RH, buf, 3);            /* read rh */
     if (res != 0)                                                           /* check the result */
     {
-        handle->debug_print("htu31d: read rh failed.\n");                   /* read rh failed */
-        
-        return 1;                                                           /* return error */
-    }
-    if (a_htu31d_crc(buf, 2, buf[2]) != 0)                                  /* check the crc */
-    {
-        handle->debug_print("htu31d: crc checked error.\n");                /* crc checked error */
+        if (handle->statistics != NULL)                                     /* check statistics */
+        {
+            handle->read_pending = 0;                                       /* clear the flag */
+        }
         
-        return 4;                                                           /* return error */
+        return res;                                                         /* return error */
     }
-    *humidity_raw = ((uint16_t)buf[0] << 8) | buf[1];                       /* set humidity raw */
-    *humidity_s = (float)(*humidity_raw) / 65535.0f * 100.0f;               /* convert raw humidity */
+    a_htu31d_delay(handle, handle->conversion_time);                        /* wait the conversion */
+    a_htu31d_statistics_wait(handle, handle->conversion_time);              /* record the wait */
     
     return 0;                                                               /* success return 0 */
 }
 
 /**
- * @brief     initialize the chip
- * @param[in] *handle pointer to an htu31d handle structure
- * @return    status code
- *            - 0 success
- *            - 1 iic initialization failed
- *            - 2 handle is NULL
- *            - 3 linked functions is NULL
- *            - 4 reset failed
- * @note      none
+ * @brief     convert the raw temperature to centi degrees celsius
+ * @param[in] raw raw temperature
+ * @return    temperature in 0.01C
+ * @note      raw * 16500 / 65535 - 4000 rounded to nearest, error <= 0.005C,
+ *            x / 65535 is computed as (x + (x >> 16)) >> 16 with 32 bits integers
+ */
+static int16_t a_htu31d_temperature_centi(uint16_t raw)
+{
+    uint32_t x;
+    
+    x = (uint32_t)raw * 16500U;                                             /* scale */
+    
+    return (int16_t)((int32_t)((x + (x >> 16) + 32768U) >> 16) - 4000);     /* divide by 65535 and offset */
+}
+
+/**
+ * @brief     convert the raw humidity to centi percent
+ * @param[in] raw raw humidity
+ * @return    humidity in 0.01%
+ * @note      raw * 10000 / 65535 rounded to nearest, error <= 0.005%
+ */
+static uint16_t a_htu31d_humidity_centi(uint16_t raw)
+{
+    uint32_t x;
+    
+    x = (uint32_t)raw * 10000U;                                             /* scale */
+    
+    return (uint16_t)((x + (x >> 16) + 32768U) >> 16);                      /* divide by 65535 */
+}
+
+/**
+ * @brief      convert a raw t && rh frame to a sample
+ * @param[in]  *buf pointer to a 6 bytes frame buffer
+ * @param[out] *sample pointer to a sample structure
+ * @note       the crc is not checked here
+ */
+static void a_htu31d_sample(const uint8_t *buf, htu31d_sample_t *sample)
+{
+    sample->temperature_raw = ((uint16_t)buf[0] << 8) | buf[1];                        /* set temperature raw */
+    sample->humidity_raw = ((uint16_t)buf[3] << 8) | buf[4];                           /* set humidity raw */
+    sample->temperature_centi = a_htu31d_temperature_centi(sample->temperature_raw);   /* convert raw temperature */
+    sample->humidity_centi = a_htu31d_humidity_centi(sample->humidity_raw);            /* convert raw humidity */
+}
+
+#ifndef HTU31D_DISABLE_FLOAT
+/**
+ * @brief      fetch the temperature and humidity data of the finished conversion
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_s pointer to a converted temperature buffer
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *humidity_s pointer to a converted humidity buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 fetch temperature humidity failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ * @note       none
+ */
+uint8_t htu31d_fetch_temperature_humidity(htu31d_handle_t *handle,
+                                          uint16_t *temperature_raw, float *temperature_s,
+                                          uint16_t *humidity_raw, float *humidity_s
+                                         )
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    
+    res = a_htu31d_fetch_temperature_humidity(handle, temperature_raw, humidity_raw); /* fetch t && rh */
+    if (res != 0)                                                           /* check the result */
+    {
+        return res;                                                         /* return error */
+    }
+    *temperature_s = (float)(*temperature_raw) / 65535.0f * 165.0f - 40.0f; /* convert raw temperature */
+    *humidity_s = (float)(*humidity_raw) / 65535.0f * 100.0f;               /* convert raw humidity */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief      fetch the humidity data of the finished conversion
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *humidity_s pointer to a converted humidity buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 fetch humidity failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ * @note       none
+ */
+uint8_t htu31d_fetch_humidity(htu31d_handle_t *handle, uint16_t *humidity_raw, float *humidity_s)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    
+    res = a_htu31d_fetch_humidity(handle, humidity_raw);                    /* fetch rh */
+    if (res != 0)                                                           /* check the result */
+    {
+        return res;                                                         /* return error */
+    }
+    *humidity_s = (float)(*humidity_raw) / 65535.0f * 100.0f;               /* convert raw humidity */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief      read the temperature and humidity data
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_s pointer to a converted temperature buffer
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *humidity_s pointer to a converted humidity buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read temperature humidity failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 param is error
+ * @note       none
+ */
+uint8_t htu31d_read_temperature_humidity(htu31d_handle_t *handle,
+                                         uint16_t *temperature_raw, float *temperature_s,
+                                         uint16_t *humidity_raw, float *humidity_s
+                                        )
+{
+    uint8_t res;
+    
+    res = a_htu31d_convert(handle, 0);                                      /* convert */
+    if (res != 0)                                                           /* check the result */
+    {
+        return res;                                                         /* return error */
+    }
+    
+    return htu31d_fetch_temperature_humidity(handle,
+                                             temperature_raw, temperature_s,
+                                             humidity_raw, humidity_s);     /* fetch t && rh */
+}
+
+/**
+ * @brief      read the humidity data
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *humidity_s pointer to a converted humidity buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read humidity failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 param is error
+ * @note       none
+ */
+uint8_t htu31d_read_humidity(htu31d_handle_t *handle, uint16_t *humidity_raw, float *humidity_s)
+{
+    uint8_t res;
+    
+    res = a_htu31d_convert(handle, 1);                                      /* convert */
+    if (res != 0)                                                           /* check the result */
+    {
+        return res;                                                         /* return error */
+    }
+    
+    return htu31d_fetch_humidity(handle, humidity_raw, humidity_s);         /* fetch rh */
+}
+
+/**
+ * @brief      fetch the temperature data of the finished conversion
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_s pointer to a converted temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 fetch temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ * @note       only 3 bytes are transferred
+ */
+uint8_t htu31d_fetch_temperature(htu31d_handle_t *handle, uint16_t *temperature_raw, float *temperature_s)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    
+    res = a_htu31d_fetch_temperature(handle, temperature_raw);              /* fetch t */
+    if (res != 0)                                                           /* check the result */
+    {
+        return res;                                                         /* return error */
+    }
+    *temperature_s = (float)(*temperature_raw) / 65535.0f * 165.0f - 40.0f; /* convert raw temperature */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief      read the temperature data
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_s pointer to a converted temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 param is error
+ * @note       none
+ */
+uint8_t htu31d_read_temperature(htu31d_handle_t *handle, uint16_t *temperature_raw, float *temperature_s)
+{
+    uint8_t res;
+    
+    res = a_htu31d_convert(handle, 2);                                      /* convert */
+    if (res != 0)                                                           /* check the result */
+    {
+        return res;                                                         /* return error */
+    }
+    
+    return htu31d_fetch_temperature(handle, temperature_raw, temperature_s); /* fetch t */
+}
+#endif
+
+/**
+ * @brief      fetch the fixed point temperature and humidity data of the finished conversion
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_centi pointer to a temperature buffer in 0.01C
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *humidity_centi pointer to a humidity buffer in 0.01%
+ * @return     status code
+ *             - 0 success
+ *             - 1 fetch temperature humidity failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ * @note       none
+ */
+uint8_t htu31d_fetch_temperature_humidity_fixed(htu31d_handle_t *handle,
+                                                uint16_t *temperature_raw, int16_t *temperature_centi,
+                                                uint16_t *humidity_raw, uint16_t *humidity_centi
+                                               )
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    
+    res = a_htu31d_fetch_temperature_humidity(handle, temperature_raw, humidity_raw); /* fetch t && rh */
+    if (res != 0)                                                           /* check the result */
+    {
+        return res;                                                         /* return error */
+    }
+    *temperature_centi = a_htu31d_temperature_centi(*temperature_raw);      /* convert raw temperature */
+    *humidity_centi = a_htu31d_humidity_centi(*humidity_raw);               /* convert raw humidity */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief      fetch the fixed point humidity data of the finished conversion
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *humidity_centi pointer to a humidity buffer in 0.01%
+ * @return     status code
+ *             - 0 success
+ *             - 1 fetch humidity failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ * @note       none
+ */
+uint8_t htu31d_fetch_humidity_fixed(htu31d_handle_t *handle, uint16_t *humidity_raw, uint16_t *humidity_centi)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    
+    res = a_htu31d_fetch_humidity(handle, humidity_raw);                    /* fetch rh */
+    if (res != 0)                                                           /* check the result */
+    {
+        return res;                                                         /* return error */
+    }
+    *humidity_centi = a_htu31d_humidity_centi(*humidity_raw);               /* convert raw humidity */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief      read the fixed point temperature and humidity data
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_centi pointer to a temperature buffer in 0.01C
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *humidity_centi pointer to a humidity buffer in 0.01%
+ * @return     status code
+ *             - 0 success
+ *             - 1 read temperature humidity failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 param is error
+ * @note       none
+ */
+uint8_t htu31d_read_temperature_humidity_fixed(htu31d_handle_t *handle,
+                                               uint16_t *temperature_raw, int16_t *temperature_centi,
+                                               uint16_t *humidity_raw, uint16_t *humidity_centi
+                                              )
+{
+    uint8_t res;
+    
+    res = a_htu31d_convert(handle, 0);                                      /* convert */
+    if (res != 0)                                                           /* check the result */
+    {
+        return res;                                                         /* return error */
+    }
+    
+    return htu31d_fetch_temperature_humidity_fixed(handle,
+                                                   temperature_raw, temperature_centi,
+                                                   humidity_raw, humidity_centi); /* fetch t && rh */
+}
+
+/**
+ * @brief      read the fixed point humidity data
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *humidity_centi pointer to a humidity buffer in 0.01%
+ * @return     status code
+ *             - 0 success
+ *             - 1 read humidity failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 param is error
+ * @note       none
+ */
+uint8_t htu31d_read_humidity_fixed(htu31d_handle_t *handle, uint16_t *humidity_raw, uint16_t *humidity_centi)
+{
+    uint8_t res;
+    
+    res = a_htu31d_convert(handle, 1);                                      /* convert */
+    if (res != 0)                                                           /* check the result */
+    {
+        return res;                                                         /* return error */
+    }
+    
+    return htu31d_fetch_humidity_fixed(handle, humidity_raw, humidity_centi); /* fetch rh */
+}
+
+/**
+ * @brief     probe a running sensor for a warm start
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @return    status code
+ *            - 0 sensor is healthy
+ *            - 1 sensor needs a reset
+ * @note      the diagnostic read must answer with a valid crc and without the nvm error bit
+ */
+static uint8_t a_htu31d_probe(htu31d_handle_t *handle)
+{
+    uint8_t buf[2];
+    
+    if (handle->init_mode != HTU31D_INIT_MODE_WARM)                                 /* check the init mode */
+    {
+        return 1;                                                                   /* cold start */
+    }
+    if (a_htu31d_read(handle, HTU31D_COMMAND_READ_DIAGNOSTIC, buf, 2) != 0)         /* get diagnostic */
+    {
+        return 1;                                                                   /* no answer */
+    }
+    if (a_htu31d_crc(buf, 1, buf[1]) != 0)                                          /* check the crc */
+    {
+        a_htu31d_statistics_crc_error(handle, HTU31D_STATISTICS_COMMAND_DIAGNOSTIC); /* count the error */
+        
+        return 1;                                                                   /* bad frame */
+    }
+    if ((buf[0] & HTU31D_DIAGNOSTIC_NVM_ERROR) != 0)                                /* check the nvm error */
+    {
+        return 1;                                                                   /* nvm error */
+    }
+    
+    return 0;                                                                       /* sensor is healthy */
+}
+
+/**
+ * @brief     check the linked functions
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 3 linked functions is NULL
+ * @note      none
+ */
+static uint8_t a_htu31d_check_link(htu31d_handle_t *handle)
+{
+    if (handle->debug_print == NULL)                                    /* check debug_print */
+    {
+        return 3;                                                       /* return error */
+    }
+    if ((handle->iic_init == NULL) && (handle->iic_init_ctx == NULL))   /* check iic_init */
+    {
+        handle->debug_print("htu31d: iic_init is null.\n");             /* iic_init is null */
+       
+        return 3;                                                       /* return error */
+    }
+    if ((handle->iic_deinit == NULL) && (handle->iic_deinit_ctx == NULL)) /* check iic_deinit */
+    {
+        handle->debug_print("htu31d: iic_deinit is null.\n");           /* iic_deinit is null */
+       
+        return 3;                                                       /* return error */
+    }
+    if ((handle->iic_read == NULL) && (handle->iic_read_ctx == NULL))   /* check iic_read */
+    {
+        handle->debug_print("htu31d: iic_read is null.\n");             /* iic_read is null */
+       
+        return 3;                                                       /* return error */
+    }
+    if ((handle->iic_write == NULL) && (handle->iic_write_ctx == NULL)) /* check iic_write */
+    {
+        handle->debug_print("htu31d: iic_write is null.\n");            /* iic_write is null */
+       
+        return 3;                                                       /* return error */
+    }
+    if ((handle->delay_ms == NULL) && (handle->delay_ms_ctx == NULL))   /* check delay_ms */
+    {
+        handle->debug_print("htu31d: delay_ms is null.\n");             /* delay_ms is null */
+       
+        return 3;                                                       /* return error */
+    }
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     initialize the chip
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 reset failed
+ * @note      in HTU31D_INIT_MODE_WARM a healthy sensor keeps running without the reset and the 15 ms wait
+ */
+uint8_t htu31d_init(htu31d_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                 /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (a_htu31d_check_link(handle) != 0)                               /* check the linked functions */
+    {
+        return 3;                                                       /* return error */
+    }
+    
+    if (a_htu31d_iic_init(handle) != 0)                                 /* iic init */
+    {
+        handle->debug_print("htu31d: iic init failed.\n");              /* iic init failed */
+       
+        return 1;                                                       /* return error */
+    }
+    if (a_htu31d_probe(handle) != 0)                                    /* check the warm start */
+    {
+        res = a_htu31d_write(handle, HTU31D_COMMAND_RESET, NULL, 0);    /* soft reset */
+        if (res != 0)                                                   /* check the result */
+        {
+            handle->debug_print("htu31d: soft reset failed.\n");        /* soft reset failed */
+            (void)a_htu31d_iic_deinit(handle);                          /* iic deinit */
+            
+            return 4;                                                   /* return error */
+        }
+        a_htu31d_delay_ms(handle, 15);                                  /* delay 15 ms */
+    }
+    handle->conversion = 0;                                             /* clear conversion flag */
+    handle->humidity_priority = 0;                                      /* disable humidity priority */
+    handle->continuous = 0;                                             /* clear continuous */
+    handle->inited = 1;                                                 /* flag finish initialization */
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     close the chip
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 reset failed
+ * @note      none
+ */
+uint8_t htu31d_deinit(htu31d_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                 /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (handle->inited != 1)                                            /* check handle initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    
+    res = a_htu31d_write(handle, HTU31D_COMMAND_RESET, NULL, 0);        /* soft reset */
+    if (res != 0)                                                       /* check the result */
+    {
+        handle->debug_print("htu31d: soft reset failed.\n");            /* soft reset failed */
+        
+        return 4;                                                       /* return error */
+    }
+    a_htu31d_delay_ms(handle, 15);                                      /* delay 15 ms */
+    if (a_htu31d_iic_deinit(handle) != 0)                               /* iic deinit */
+    {
+        handle->debug_print("htu31d: iic deinit failed.\n");            /* iic deinit failed */
+       
+        return 1;                                                       /* return error */
+    }
+    handle->inited = 0;                                                 /* flag close */
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     set humidity osr
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] osr humidity osr
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t htu31d_set_humidity_osr(htu31d_handle_t *handle, htu31d_humidity_osr_t osr)
+{
+    if (handle == NULL)                /* check handle */
+    {
+        return 2;                      /* return error */
+    }
+    if (handle->inited != 1)           /* check handle initialization */
+    {
+        return 3;                      /* return error */
+    }
+    
+    handle->humidity_osr = osr;        /* set osr */
+    
+    return 0;                          /* success return 0 */
+}
+
+/**
+ * @brief      get humidity osr
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *osr pointer to a humidity osr buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t htu31d_get_humidity_osr(htu31d_handle_t *handle, htu31d_humidity_osr_t *osr)
+{
+    if (handle == NULL)                                          /* check handle */
+    {
+        return 2;                                                /* return error */
+    }
+    if (handle->inited != 1)                                     /* check handle initialization */
+    {
+        return 3;                                                /* return error */
+    }
+    
+    *osr = (htu31d_humidity_osr_t)(handle->humidity_osr);        /* get osr */
+    
+    return 0;                                                    /* success return 0 */
+}
+
+/**
+ * @brief     set temperature osr
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] osr temperature osr
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t htu31d_set_temperature_osr(htu31d_handle_t *handle, htu31d_temperature_osr_t osr)
+{
+    if (handle == NULL)                   /* check handle */
+    {
+        return 2;                         /* return error */
+    }
+    if (handle->inited != 1)              /* check handle initialization */
+    {
+        return 3;                         /* return error */
+    }
+    
+    handle->temperature_osr = osr;        /* set osr */
+    
+    return 0;                             /* success return 0 */
+}
+
+/**
+ * @brief      get temperature osr
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *osr pointer to a temperature osr buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t htu31d_get_temperature_osr(htu31d_handle_t *handle, htu31d_temperature_osr_t *osr)
+{
+    if (handle == NULL)                                                /* check handle */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (handle->inited != 1)                                           /* check handle initialization */
+    {
+        return 3;                                                      /* return error */
+    }
+    
+    *osr = (htu31d_temperature_osr_t)(handle->temperature_osr);        /* get osr */
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief      fetch the fixed point temperature data of the finished conversion
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_centi pointer to a temperature buffer in 0.01C
+ * @return     status code
+ *             - 0 success
+ *             - 1 fetch temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ * @note       only 3 bytes are transferred
+ */
+uint8_t htu31d_fetch_temperature_fixed(htu31d_handle_t *handle, uint16_t *temperature_raw, int16_t *temperature_centi)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    
+    res = a_htu31d_fetch_temperature(handle, temperature_raw);              /* fetch t */
+    if (res != 0)                                                           /* check the result */
+    {
+        return res;                                                         /* return error */
+    }
+    *temperature_centi = a_htu31d_temperature_centi(*temperature_raw);      /* convert raw temperature */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief      read the fixed point temperature data
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_centi pointer to a temperature buffer in 0.01C
+ * @return     status code
+ *             - 0 success
+ *             - 1 read temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 param is error
+ * @note       none
+ */
+uint8_t htu31d_read_temperature_fixed(htu31d_handle_t *handle, uint16_t *temperature_raw, int16_t *temperature_centi)
+{
+    uint8_t res;
+    
+    res = a_htu31d_convert(handle, 2);                                      /* convert */
+    if (res != 0)                                                           /* check the result */
+    {
+        return res;                                                         /* return error */
+    }
+    
+    return htu31d_fetch_temperature_fixed(handle, temperature_raw, temperature_centi); /* fetch t */
+}
+
+/**
+ * @brief     enable or disable the humidity priority mode
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t htu31d_set_humidity_priority(htu31d_handle_t *handle, htu31d_bool_t enable)
+{
+    if (handle == NULL)                               /* check handle */
+    {
+        return 2;                                     /* return error */
+    }
+    if (handle->inited != 1)                          /* check handle initialization */
+    {
+        return 3;                                     /* return error */
+    }
+    
+    handle->humidity_priority = (uint8_t)enable;      /* set the mode */
+    
+    return 0;                                         /* success return 0 */
+}
+
+/**
+ * @brief      get the humidity priority mode status
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t htu31d_get_humidity_priority(htu31d_handle_t *handle, htu31d_bool_t *enable)
+{
+    if (handle == NULL)                                           /* check handle */
+    {
+        return 2;                                                 /* return error */
+    }
+    if (handle->inited != 1)                                      /* check handle initialization */
+    {
+        return 3;                                                 /* return error */
+    }
+    
+    *enable = (htu31d_bool_t)(handle->humidity_priority);         /* get the mode */
+    
+    return 0;                                                     /* success return 0 */
+}
+
+/**
+ * @brief     check the crc of a continuous sample
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] *buf pointer to a 6 bytes frame buffer
+ * @return    callback status, 0 for a valid frame or 4 for a crc error
+ * @note      none
+ */
+static uint8_t a_htu31d_continuous_crc(htu31d_handle_t *handle, const uint8_t *buf)
+{
+    if (a_htu31d_crc_frame(buf) != 0)                                                 /* check the crc */
+    {
+        a_htu31d_statistics_crc_error(handle, HTU31D_STATISTICS_COMMAND_T_RH);       /* count the error */
+        
+        return 4;                                                                     /* crc is error */
+    }
+    
+    return 0;                                                                         /* crc is ok */
+}
+
+/**
+ * @brief     run the continuous pipelined sampling loop
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] period_us sampling period in us, 0 means as fast as the conversion allows
+ * @param[in] *callback pointer to a sample callback function
+ * @return    status code
+ *            - 0 success
+ *            - 1 continuous read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 param is error
+ * @note      the loop returns after htu31d_continuous_stop is called,
+ *            crc errors are reported to the callback and don't stop the loop,
+ *            when period_us is no more than the conversion time the next conversion already runs
+ *            during the callback, a stop then waits for it and discards its result, so the loop
+ *            always returns with no conversion in flight
+ */
+uint8_t htu31d_continuous_start(htu31d_handle_t *handle, uint32_t period_us,
+                                void (*callback)(htu31d_handle_t *handle, uint8_t res, htu31d_sample_t *sample))
+{
+    uint8_t res;
+    uint8_t buf[6];
+    uint32_t start;
+    uint32_t release;
+    htu31d_sample_t sample;
+    
+    if (handle == NULL)                                                            /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                       /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    if (callback == NULL)                                                          /* check callback */
+    {
+        handle->debug_print("htu31d: callback is null.\n");                        /* callback is null */
+        
+        return 5;                                                                  /* return error */
+    }
+    
+    handle->continuous = 1;                                                        /* flag continuous */
+    release = (handle->timestamp_us != NULL) ? handle->timestamp_us() : 0;         /* first release time */
+    res = a_htu31d_start_conversion(handle, handle->humidity_osr,
+                                    handle->temperature_osr);                      /* start the first conversion */
+    if (res != 0)                                                                  /* check the result */
+    {
+        handle->continuous = 0;                                                    /* clear continuous */
+        
+        return res;                                                                /* return error */
+    }
+    while (handle->continuous != 0)                                                /* run until stopped */
+    {
+        start = handle->conversion_start;                                          /* save the start time */
+        sample.timestamp_us = start;                                               /* set the timestamp */
+        a_htu31d_statistics_wait(handle,
+                                 a_htu31d_delay_until(handle, start,
+                                                      handle->conversion_time));  /* wait the conversion */
+        res = a_htu31d_read(handle, HTU31D_COMMAND_READ_T_RH, buf, 6);             /* read t && rh */
+        if (res != 0)                                                              /* check the result */
+        {
+            handle->debug_print("htu31d: read t && rh failed.\n");                 /* read t && rh failed */
+            handle->conversion = 0;                                                /* clear conversion flag */
+            handle->continuous = 0;                                                /* clear continuous */
+            
+            return 1;                                                              /* return error */
+        }
+        if (period_us > handle->conversion_time)                                   /* idle time between conversions */
+        {
+            handle->conversion = 0;                                                /* clear conversion flag */
+            a_htu31d_sample(buf, &sample);                                         /* convert the sample */
+            callback(handle, a_htu31d_continuous_crc(handle, buf), &sample);       /* run the callback */
+            if (handle->continuous == 0)                                           /* check the stop flag */
+            {
+                break;                                                             /* break */
+            }
+            if (handle->timestamp_us != NULL)                                      /* check timestamp_us */
+            {
+                a_htu31d_delay_until(handle, release, period_us);                  /* wait the next release */
+                release += period_us;                                              /* next release time */
+            }
+            else
+            {
+                a_htu31d_delay(handle, period_us - handle->conversion_time);       /* wait the idle time */
+            }
+            res = a_htu31d_start_conversion(handle, handle->humidity_osr,
+                                            handle->temperature_osr);              /* start the next conversion */
+            if (res != 0)                                                          /* check the result */
+            {
+                handle->continuous = 0;                                            /* clear continuous */
+                
+                return res;                                                        /* return error */
+            }
+        }
+        else
+        {
+            res = a_htu31d_start_conversion(handle, handle->humidity_osr,
+                                            handle->temperature_osr);              /* start the next conversion */
+            if (res != 0)                                                          /* check the result */
+            {
+                handle->continuous = 0;                                            /* clear continuous */
+                
+                return res;                                                        /* return error */
+            }
+            a_htu31d_sample(buf, &sample);                                         /* convert while converting */
+            callback(handle, a_htu31d_continuous_crc(handle, buf), &sample);       /* run the callback */
+            if (handle->continuous == 0)                                           /* check the stop flag */
+            {
+                a_htu31d_delay_until(handle, handle->conversion_start,
+                                     handle->conversion_time);                     /* wait the started conversion */
+                handle->conversion = 0;                                            /* clear conversion flag */
+                if (a_htu31d_read(handle, HTU31D_COMMAND_READ_T_RH, buf, 6) != 0)  /* drain the result */
+                {
+                    handle->debug_print("htu31d: read t && rh failed.\n");         /* read t && rh failed */
+                    
+                    return 1;                                                      /* return error */
+                }
+            }
+        }
+    }
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     stop the continuous sampling loop
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      it can be called from the sample callback
+ */
+uint8_t htu31d_continuous_stop(htu31d_handle_t *handle)
+{
+    if (handle == NULL)                    /* check handle */
+    {
+        return 2;                          /* return error */
+    }
+    if (handle->inited != 1)               /* check handle initialization */
+    {
+        return 3;                          /* return error */
+    }
+    
+    handle->continuous = 0;                /* clear continuous */
+    
+    return 0;                              /* success return 0 */
+}
+
+/**
+ * @brief      start a drift free periodic sampler
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *periodic pointer to a periodic sampler structure
+ * @param[in]  period_us sampling period in us
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timestamp_us is null
+ *             - 5 param is error
+ * @note       the first release time is now
+ */
+uint8_t htu31d_periodic_start(htu31d_handle_t *handle, htu31d_periodic_t *periodic, uint32_t period_us)
+{
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    if (handle->timestamp_us == NULL)                                    /* check timestamp_us */
+    {
+        handle->debug_print("htu31d: timestamp_us is null.\n");          /* timestamp_us is null */
+        
+        return 4;                                                        /* return error */
+    }
+    if ((periodic == NULL) || (period_us == 0))                          /* check the param */
+    {
+        handle->debug_print("htu31d: param is error.\n");                /* param is error */
+        
+        return 5;                                                        /* return error */
+    }
+    
+    memset(periodic, 0, sizeof(htu31d_periodic_t));                      /* clear the sampler */
+    periodic->period_us = period_us;                                     /* set the period */
+    periodic->release = handle->timestamp_us();                          /* first release time */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      take the sample of the next release time
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[in]  *periodic pointer to a periodic sampler structure
+ * @param[out] *sample pointer to a sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 periodic read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error or timestamp_us is null
+ *             - 5 param is error
+ * @note       the conversions start on absolute release times, so the bus and conversion time
+ *             don't add up to drift, the sample timestamp is the conversion midpoint,
+ *             release times that have already passed are counted as overruns and skipped
+ */
+uint8_t htu31d_periodic_read(htu31d_handle_t *handle, htu31d_periodic_t *periodic, htu31d_sample_t *sample)
+{
+    uint8_t res;
+    uint32_t late;
+    uint32_t missed;
+    
+    if (handle == NULL)                                                              /* check handle */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (handle->inited != 1)                                                         /* check handle initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    if (handle->timestamp_us == NULL)                                                /* check timestamp_us */
+    {
+        handle->debug_print("htu31d: timestamp_us is null.\n");                      /* timestamp_us is null */
+        
+        return 4;                                                                    /* return error */
+    }
+    if ((periodic == NULL) || (sample == NULL) || (periodic->period_us == 0))        /* check the param */
+    {
+        handle->debug_print("htu31d: param is error.\n");                            /* param is error */
+        
+        return 5;                                                                    /* return error */
+    }
+    
+    late = handle->timestamp_us() - periodic->release;                               /* get the lateness */
+    if (late >= 0x80000000U)                                                         /* release time is ahead */
+    {
+        a_htu31d_delay(handle, (uint32_t)(0U - late));                               /* wait the release time */
+    }
+    else if (late >= periodic->period_us)                                            /* check the overrun */
+    {
+        missed = late / periodic->period_us;                                         /* missed release times */
+        periodic->overrun += missed;                                                 /* count the overrun */
+        periodic->release += missed * periodic->period_us;                           /* skip to the current slot */
+    }
+    else
+    {
+        /* late within the slot, start at once */
+    }
+    res = a_htu31d_start_conversion(handle, handle->humidity_osr,
+                                    handle->temperature_osr);                        /* start conversion */
+    if (res != 0)                                                                    /* check the result */
+    {
+        return res;                                                                  /* return error */
+    }
+    late = handle->conversion_start - periodic->release;                             /* get the start lateness */
+    if ((late < 0x80000000U) && (late > periodic->max_lateness_us))                  /* check the lateness */
+    {
+        periodic->max_lateness_us = late;                                            /* save the lateness */
+    }
+    periodic->release += periodic->period_us;                                        /* next release time */
+    a_htu31d_statistics_wait(handle,
+                             a_htu31d_delay_until(handle, handle->conversion_start,
+                                                  handle->conversion_time));         /* wait the conversion */
+    res = a_htu31d_fetch_temperature_humidity(handle, &sample->temperature_raw,
+                                              &sample->humidity_raw);                /* fetch t && rh */
+    if (res != 0)                                                                    /* check the result */
+    {
+        return res;                                                                  /* return error */
+    }
+    sample->temperature_centi = a_htu31d_temperature_centi(sample->temperature_raw); /* convert raw temperature */
+    sample->humidity_centi = a_htu31d_humidity_centi(sample->humidity_raw);          /* convert raw humidity */
+    sample->timestamp_us = handle->conversion_start + handle->conversion_time / 2;   /* conversion midpoint */
+    periodic->count++;                                                               /* count the sample */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief      capture a batch of raw samples into caller owned arrays
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[in]  n sample number
+ * @param[in]  period sampling period in us, 0 means back to back conversions
+ * @param[out] *t_raw pointer to a raw temperature array with n entries
+ * @param[out] *rh_raw pointer to a raw humidity array with n entries
+ * @param[out] *ts pointer to a conversion start timestamp array with n entries, it can be NULL
+ * @return     status code
+ *             - 0 success
+ *             - 1 read batch failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 param is error or ts isn't NULL without timestamp_us
+ * @note       the loop doesn't convert to engineering units, use htu31d_convert_batch_fixed or
+ *             htu31d_convert_batch afterwards, ts counts in us from the linked timestamp_us without wrapping,
+ *             the release times follow an absolute schedule when timestamp_us is linked,
+ *             the batch stops at the first failed sample and the samples before it are kept
+ */
+uint8_t htu31d_read_batch(htu31d_handle_t *handle, uint32_t n, uint32_t period,
+                          uint16_t *t_raw, uint16_t *rh_raw, uint64_t *ts)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t release;
+    uint32_t last;
+    uint64_t now;
+    
+    if (handle == NULL)                                                                /* check handle */
+    {
+        return 2;                                                                      /* return error */
+    }
+    if (handle->inited != 1)                                                           /* check handle initialization */
+    {
+        return 3;                                                                      /* return error */
+    }
+    if ((t_raw == NULL) || (rh_raw == NULL))                                           /* check the buffers */
+    {
+        handle->debug_print("htu31d: buffer is null.\n");                              /* buffer is null */
+        
+        return 5;                                                                      /* return error */
+    }
+    if ((ts != NULL) && (handle->timestamp_us == NULL))                                /* check timestamp_us */
+    {
+        handle->debug_print("htu31d: timestamp_us is null.\n");                        /* timestamp_us is null */
+        
+        return 5;                                                                      /* return error */
+    }
+    
+    release = (handle->timestamp_us != NULL) ? handle->timestamp_us() : 0;            /* first release time */
+    last = release;                                                                    /* init the wrap tracking */
+    now = last;                                                                        /* init the 64 bits time */
+    for (i = 0; i < n; i++)                                                            /* capture all samples */
+    {
+        if ((i != 0) && (period > handle->conversion_time))                            /* idle time between conversions */
+        {
+            if (handle->timestamp_us != NULL)                                          /* check timestamp_us */
+            {
+                (void)a_htu31d_delay_until(handle, release, period);                   /* wait the next release */
+                release += period;                                                     /* next release time */
+            }
+            else
+            {
+                a_htu31d_delay(handle, period - handle->conversion_time);              /* wait the idle time */
+            }
+        }
+        res = a_htu31d_start_conversion(handle, handle->humidity_osr,
+                                        handle->temperature_osr);                      /* start conversion */
+        if (res != 0)                                                                  /* check the result */
+        {
+            return res;                                                                /* return error */
+        }
+        if (ts != NULL)                                                                /* check ts */
+        {
+            now += (uint32_t)(handle->conversion_start - last);                        /* extend to 64 bits */
+            last = handle->conversion_start;                                           /* save the timestamp */
+            ts[i] = now;                                                               /* set the timestamp */
+        }
+        a_htu31d_statistics_wait(handle,
+                                 a_htu31d_delay_until(handle, handle->conversion_start,
+                                                      handle->conversion_time));       /* wait the conversion */
+        res = a_htu31d_fetch_temperature_humidity(handle, &t_raw[i], &rh_raw[i]);      /* fetch t && rh */
+        if (res != 0)                                                                  /* check the result */
+        {
+            return res;                                                                /* return error */
+        }
+    }
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief      convert a batch of raw samples to fixed point
+ * @param[in]  n sample number
+ * @param[in]  *t_raw pointer to a raw temperature array with n entries
+ * @param[in]  *rh_raw pointer to a raw humidity array with n entries
+ * @param[out] *t_centi pointer to a temperature array in 0.01C with n entries
+ * @param[out] *rh_centi pointer to a humidity array in 0.01% with n entries
+ * @note       the loop has no branches so the compiler can vectorize it
+ */
+void htu31d_convert_batch_fixed(uint32_t n, const uint16_t *t_raw, const uint16_t *rh_raw,
+                                int16_t *t_centi, uint16_t *rh_centi)
+{
+    uint32_t i;
+    
+    for (i = 0; i < n; i++)                                                /* convert all samples */
+    {
+        t_centi[i] = a_htu31d_temperature_centi(t_raw[i]);                 /* convert raw temperature */
+        rh_centi[i] = a_htu31d_humidity_centi(rh_raw[i]);                  /* convert raw humidity */
+    }
+}
+
+#ifndef HTU31D_DISABLE_FLOAT
+/**
+ * @brief      convert a batch of raw samples to float
+ * @param[in]  n sample number
+ * @param[in]  *t_raw pointer to a raw temperature array with n entries
+ * @param[in]  *rh_raw pointer to a raw humidity array with n entries
+ * @param[out] *t pointer to a temperature array in C with n entries
+ * @param[out] *rh pointer to a humidity array in % with n entries
+ * @note       the loop has no branches so the compiler can vectorize it
+ */
+void htu31d_convert_batch(uint32_t n, const uint16_t *t_raw, const uint16_t *rh_raw, float *t, float *rh)
+{
+    uint32_t i;
+    
+    for (i = 0; i < n; i++)                                                /* convert all samples */
+    {
+        t[i] = (float)t_raw[i] * (165.0f / 65535.0f) - 40.0f;              /* convert raw temperature */
+        rh[i] = (float)rh_raw[i] * (100.0f / 65535.0f);                    /* convert raw humidity */
+    }
+}
+#endif
+
+/**
+ * @brief     enable the statistics of a handle
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] *statistics pointer to a caller owned statistics block, NULL disables the statistics
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      the block is cleared, latencies are only recorded when timestamp_us is linked
+ */
+uint8_t htu31d_set_statistics(htu31d_handle_t *handle, htu31d_statistics_t *statistics)
+{
+    if (handle == NULL)                                                   /* check handle */
+    {
+        return 2;                                                         /* return error */
+    }
+    
+    if (statistics != NULL)                                               /* check statistics */
+    {
+        memset(statistics, 0, sizeof(htu31d_statistics_t));               /* clear the block */
+    }
+    handle->statistics = statistics;                                      /* set the block */
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief      take a snapshot of the statistics
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *snapshot pointer to a statistics buffer
+ * @param[in]  reset clear the counters after the copy
+ * @return     status code
+ *             - 0 success
+ *             - 1 statistics is disabled
+ *             - 2 handle is NULL
+ *             - 5 snapshot is NULL
+ * @note       snapshot must not be the linked block, with HTU31D_STATISTICS_ATOMIC every counter is read
+ *             and cleared in one atomic step, so another thread can scrape and reset without losing counts,
+ *             counters of one snapshot can still mix values from before and after a running transaction
  */
-uint8_t htu31d_init(htu31d_handle_t *handle)
+uint8_t htu31d_get_statistics(htu31d_handle_t *handle, htu31d_statistics_t *snapshot, htu31d_bool_t reset)
 {
-    uint8_t res;
+    uint8_t i;
+    uint8_t j;
+    htu31d_statistics_t *statistics;
     
-    if (handle == NULL)                                                 /* check handle */
+    if (handle == NULL)                                                                      /* check handle */
     {
-        return 2;                                                       /* return error */
+        return 2;                                                                            /* return error */
     }
-    if (handle->debug_print == NULL)                                    /* check debug_print */
+    if (snapshot == NULL)                                                                    /* check snapshot */
     {
-        return 3;                                                       /* return error */
+        return 5;                                                                            /* return error */
     }
-    if (handle->iic_init == NULL)                                       /* check iic_init */
+    statistics = handle->statistics;                                                         /* get the block */
+    if (statistics == NULL)                                                                  /* check statistics */
     {
-        handle->debug_print("htu31d: iic_init is null.\n");             /* iic_init is null */
-       
-        return 3;                                                       /* return error */
+        return 1;                                                                            /* return error */
     }
-    if (handle->iic_deinit == NULL)                                     /* check iic_deinit */
+    
+    snapshot->write_count = a_htu31d_statistics_take(&statistics->write_count, reset);       /* take write count */
+    snapshot->read_count = a_htu31d_statistics_take(&statistics->read_count, reset);         /* take read count */
+    snapshot->write_bytes = a_htu31d_statistics_take(&statistics->write_bytes, reset);       /* take write bytes */
+    snapshot->read_bytes = a_htu31d_statistics_take(&statistics->read_bytes, reset);         /* take read bytes */
+    snapshot->write_failed = a_htu31d_statistics_take(&statistics->write_failed, reset);     /* take write failures */
+    snapshot->read_failed = a_htu31d_statistics_take(&statistics->read_failed, reset);       /* take read failures */
+    for (i = 0; i < HTU31D_STATISTICS_COMMAND_MAX; i++)                                      /* take crc errors */
     {
-        handle->debug_print("htu31d: iic_deinit is null.\n");           /* iic_deinit is null */
-       
-        return 3;                                                       /* return error */
+        snapshot->crc_error[i] = a_htu31d_statistics_take(&statistics->crc_error[i], reset); /* take crc error */
     }
-    if (handle->iic_read == NULL)                                       /* check iic_read */
+    snapshot->wait_count = a_htu31d_statistics_take(&statistics->wait_count, reset);         /* take wait count */
+    snapshot->wait_us = a_htu31d_statistics_take_64(&statistics->wait_us, reset);            /* take wait time */
+    for (i = 0; i < HTU31D_STATISTICS_API_MAX; i++)                                          /* take histograms */
     {
-        handle->debug_print("htu31d: iic_read is null.\n");             /* iic_read is null */
-       
-        return 3;                                                       /* return error */
+        for (j = 0; j < HTU31D_STATISTICS_BUCKETS; j++)                                      /* take all buckets */
+        {
+            snapshot->latency[i][j] = a_htu31d_statistics_take(&statistics->latency[i][j], reset); /* take bucket */
+        }
     }
-    if (handle->iic_write == NULL)                                      /* check iic_write */
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief      start the conversions of a sensor group back to back
+ * @param[in]  **handle pointer to an htu31d handle pointer array
+ * @param[in]  num sensor number
+ * @param[out] *status pointer to a status array with num entries
+ * @param[out] *wait_us pointer to a remaining wait time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 some conversions failed
+ *             - 2 handle is NULL
+ *             - 5 param is error
+ * @note       wait_us is the time until the slowest started conversion is finished,
+ *             status[i] uses the htu31d_start_conversion codes
+ */
+uint8_t htu31d_group_start_conversion(htu31d_handle_t **handle, uint8_t num, uint8_t *status, uint32_t *wait_us)
+{
+    uint8_t i;
+    uint8_t ret;
+    uint8_t timed;
+    uint32_t now;
+    uint32_t elapsed;
+    uint32_t wait;
+    
+    if ((handle == NULL) || (status == NULL) || (wait_us == NULL))                    /* check handle */
     {
-        handle->debug_print("htu31d: iic_write is null.\n");            /* iic_write is null */
-       
-        return 3;                                                       /* return error */
+        return 2;                                                                     /* return error */
     }
-    if (handle->delay_ms == NULL)                                       /* check delay_ms */
+    if (num == 0)                                                                     /* check num */
     {
-        handle->debug_print("htu31d: delay_ms is null.\n");             /* delay_ms is null */
-       
-        return 3;                                                       /* return error */
+        return 5;                                                                     /* return error */
     }
     
-    if (handle->iic_init() != 0)                                        /* iic init */
+    ret = 0;                                                                          /* init 0 */
+    timed = 1;                                                                        /* init 1 */
+    for (i = 0; i < num; i++)                                                         /* start all conversions */
     {
-        handle->debug_print("htu31d: iic init failed.\n");              /* iic init failed */
-       
-        return 1;                                                       /* return error */
+        if (handle[i] == NULL)                                                        /* check handle */
+        {
+            status[i] = 2;                                                            /* handle is NULL */
+            ret = 1;                                                                  /* flag error */
+            
+            continue;                                                                 /* next */
+        }
+        if (handle[i]->inited != 1)                                                   /* check handle initialization */
+        {
+            status[i] = 3;                                                            /* handle is not initialized */
+            ret = 1;                                                                  /* flag error */
+            
+            continue;                                                                 /* next */
+        }
+        status[i] = a_htu31d_start_conversion(handle[i], handle[i]->humidity_osr,
+                                              handle[i]->temperature_osr);            /* start conversion */
+        if (status[i] != 0)                                                           /* check the result */
+        {
+            ret = 1;                                                                  /* flag error */
+        }
+        else if (handle[i]->timestamp_us == NULL)                                     /* check timestamp_us */
+        {
+            timed = 0;                                                                /* no timestamp */
+        }
     }
-    res = a_htu31d_write(handle, HTU31D_COMMAND_RESET, NULL, 0);        /* soft reset */
-    if (res != 0)                                                       /* check the result */
+    
+    wait = 0;                                                                         /* init 0 */
+    for (i = 0; i < num; i++)                                                         /* find the slowest conversion */
     {
-        handle->debug_print("htu31d: soft reset failed.\n");            /* soft reset failed */
-        (void)handle->iic_deinit();                                     /* iic deinit */
+        if (status[i] != 0)                                                           /* skip failed sensors */
+        {
+            continue;                                                                 /* next */
+        }
+        if (timed != 0)                                                               /* the start times are known */
+        {
+            now = handle[i]->timestamp_us();                                          /* get the time */
+            elapsed = now - handle[i]->conversion_start;                              /* get the elapsed time */
+            if ((elapsed < handle[i]->conversion_time) &&
+                (handle[i]->conversion_time - elapsed > wait))                        /* check the remaining time */
+            {
+                wait = handle[i]->conversion_time - elapsed;                          /* save the remaining time */
+            }
+        }
+        else if (handle[i]->conversion_time > wait)                                   /* check the conversion time */
+        {
+            wait = handle[i]->conversion_time;                                        /* save the conversion time */
+        }
+    }
+    *wait_us = wait;                                                                  /* set the wait time */
+    
+    return ret;                                                                       /* return the result */
+}
+
+/**
+ * @brief         check a fetched result of a group sensor
+ * @param[in]     *handle pointer to an htu31d handle structure
+ * @param[in]     *buf pointer to a 6 bytes frame buffer
+ * @param[out]    *sample pointer to a sample structure
+ * @param[in,out] *status pointer to a status buffer
+ * @return        0 for a valid sample or 1 for an error
+ * @note          none
+ */
+static uint8_t a_htu31d_group_sample(htu31d_handle_t *handle, const uint8_t *buf,
+                                     htu31d_sample_t *sample, uint8_t *status)
+{
+    handle->conversion = 0;                                                           /* clear conversion flag */
+    if (a_htu31d_crc_frame(buf) != 0)                                                 /* check the crc */
+    {
+        a_htu31d_statistics_crc_error(handle, HTU31D_STATISTICS_COMMAND_T_RH);       /* count the error */
+        handle->debug_print("htu31d: crc checked error.\n");                         /* crc checked error */
+        *status = 4;                                                                  /* crc is error */
         
-        return 4;                                                       /* return error */
+        return 1;                                                                     /* return error */
     }
-    handle->delay_ms(15);                                               /* delay 15 ms */
-    handle->inited = 1;                                                 /* flag finish initialization */
+    a_htu31d_sample(buf, sample);                                                     /* convert the sample */
+    sample->timestamp_us = handle->conversion_start;                                  /* set the timestamp */
     
-    return 0;                                                           /* success return 0 */
+    return 0;                                                                         /* success return 0 */
 }
 
 /**
- * @brief     close the chip
- * @param[in] *handle pointer to an htu31d handle structure
- * @return    status code
- *            - 0 success
- *            - 1 iic deinit failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 reset failed
- * @note      none
+ * @brief         fetch the results of group sensors one by one
+ * @param[in]     **handle pointer to an htu31d handle pointer array
+ * @param[in]     *index pointer to a sensor index array
+ * @param[in]     num index number
+ * @param[out]    *sample pointer to a sample array
+ * @param[in,out] *status pointer to a status array
+ * @return        0 for success or 1 for an error
+ * @note          none
  */
-uint8_t htu31d_deinit(htu31d_handle_t *handle)
+static uint8_t a_htu31d_group_fetch_single(htu31d_handle_t **handle, const uint8_t *index, uint8_t num,
+                                           htu31d_sample_t *sample, uint8_t *status)
 {
-    uint8_t res;
+    uint8_t i;
+    uint8_t n;
+    uint8_t ret;
+    uint8_t buf[6];
     
-    if (handle == NULL)                                                 /* check handle */
+    ret = 0;                                                                          /* init 0 */
+    for (i = 0; i < num; i++)                                                         /* fetch all results */
     {
-        return 2;                                                       /* return error */
+        n = index[i];                                                                 /* get the sensor */
+        if (a_htu31d_read(handle[n], HTU31D_COMMAND_READ_T_RH, buf, 6) != 0)          /* read t && rh */
+        {
+            handle[n]->debug_print("htu31d: read t && rh failed.\n");                 /* read t && rh failed */
+            status[n] = 1;                                                            /* read failed */
+            ret = 1;                                                                  /* flag error */
+            
+            continue;                                                                 /* next */
+        }
+        ret |= a_htu31d_group_sample(handle[n], buf, &sample[n], &status[n]);         /* check the result */
     }
-    if (handle->inited != 1)                                            /* check handle initialization */
+    
+    return ret;                                                                       /* return the result */
+}
+
+/**
+ * @brief         fetch the results of group sensors in one bus transaction
+ * @param[in]     **handle pointer to an htu31d handle pointer array
+ * @param[in]     *index pointer to a sensor index array
+ * @param[in]     num index number, no more than HTU31D_GROUP_BATCH_MAX
+ * @param[out]    *sample pointer to a sample array
+ * @param[in,out] *status pointer to a status array
+ * @return        0 for success or 1 for an error
+ * @note          a failed transaction is retried sensor by sensor
+ */
+static uint8_t a_htu31d_group_fetch_batch(htu31d_handle_t **handle, const uint8_t *index, uint8_t num,
+                                          htu31d_sample_t *sample, uint8_t *status)
+{
+    uint8_t i;
+    uint8_t n;
+    uint8_t ret;
+    uint8_t addr[HTU31D_GROUP_BATCH_MAX];
+    uint8_t buf[HTU31D_GROUP_BATCH_MAX * 6];
+    void *user_data[HTU31D_GROUP_BATCH_MAX];
+    
+    for (i = 0; i < num; i++)                                                         /* collect the addresses */
     {
-        return 3;                                                       /* return error */
+        addr[i] = handle[index[i]]->iic_addr;                                         /* set the address */
+        user_data[i] = handle[index[i]]->user_data;                                   /* set the user data */
     }
-    
-    res = a_htu31d_write(handle, HTU31D_COMMAND_RESET, NULL, 0);        /* soft reset */
-    if (res != 0)                                                       /* check the result */
+    if (handle[index[0]]->iic_read_batch_ctx(user_data, addr, num,
+                                             HTU31D_COMMAND_READ_T_RH, buf, 6) != 0)  /* read all t && rh */
     {
-        handle->debug_print("htu31d: soft reset failed.\n");            /* soft reset failed */
+        handle[index[0]]->debug_print("htu31d: read batch failed.\n");                /* read batch failed */
         
-        return 4;                                                       /* return error */
+        return a_htu31d_group_fetch_single(handle, index, num, sample, status);       /* retry one by one */
     }
-    handle->delay_ms(15);                                               /* delay 15 ms */
-    if (handle->iic_deinit() != 0)                                      /* iic deinit */
+    
+    ret = 0;                                                                          /* init 0 */
+    for (i = 0; i < num; i++)                                                         /* demultiplex the results */
     {
-        handle->debug_print("htu31d: iic deinit failed.\n");            /* iic deinit failed */
-       
-        return 1;                                                       /* return error */
+        n = index[i];                                                                 /* get the sensor */
+        if (handle[n]->statistics != NULL)                                            /* check statistics */
+        {
+            a_htu31d_statistics_add(&handle[n]->statistics->read_count, 1);           /* count the read */
+            a_htu31d_statistics_add(&handle[n]->statistics->read_bytes, 6);           /* count the bytes */
+        }
+        ret |= a_htu31d_group_sample(handle[n], &buf[i * 6], &sample[n], &status[n]); /* check the result */
     }
-    handle->inited = 0;                                                 /* flag close */
     
-    return 0;                                                           /* success return 0 */
+    return ret;                                                                       /* return the result */
 }
 
 /**
- * @brief     set humidity osr
- * @param[in] *handle pointer to an htu31d handle structure
- * @param[in] osr humidity osr
- * @return    status code
- *            - 0 success
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      fetch the results of a sensor group
+ * @param[in]  **handle pointer to an htu31d handle pointer array
+ * @param[in]  num sensor number
+ * @param[out] *sample pointer to a sample array with num entries
+ * @param[in]  *status pointer to a status array with num entries
+ * @return     status code
+ *             - 0 success
+ *             - 1 some fetches failed
+ *             - 2 handle is NULL
+ *             - 5 param is error
+ * @note       sensors whose status is not 0 are skipped,
+ *             status[i] is updated with the htu31d_fetch_temperature_humidity codes,
+ *             when the first fetched handle links iic_read_batch_ctx all sensors must share its bus and
+ *             up to HTU31D_GROUP_BATCH_MAX results are read per bus transaction, a failed batch
+ *             is retried sensor by sensor to find the failed ones
  */
-uint8_t htu31d_set_humidity_osr(htu31d_handle_t *handle, htu31d_humidity_osr_t osr)
+uint8_t htu31d_group_fetch(htu31d_handle_t **handle, uint8_t num, htu31d_sample_t *sample, uint8_t *status)
 {
-    if (handle == NULL)                /* check handle */
+    uint8_t i;
+    uint8_t ret;
+    uint8_t count;
+    uint8_t index[HTU31D_GROUP_BATCH_MAX];
+    
+    if ((handle == NULL) || (sample == NULL) || (status == NULL))                     /* check handle */
     {
-        return 2;                      /* return error */
+        return 2;                                                                     /* return error */
     }
-    if (handle->inited != 1)           /* check handle initialization */
+    if (num == 0)                                                                     /* check num */
     {
-        return 3;                      /* return error */
+        return 5;                                                                     /* return error */
     }
     
-    handle->humidity_osr = osr;        /* set osr */
+    ret = 0;                                                                          /* init 0 */
+    count = 0;                                                                        /* init 0 */
+    for (i = 0; i < num; i++)                                                         /* fetch all results */
+    {
+        if (status[i] != 0)                                                           /* skip failed sensors */
+        {
+            ret = 1;                                                                  /* flag error */
+            
+            continue;                                                                 /* next */
+        }
+        index[count] = i;                                                             /* queue the sensor */
+        count++;                                                                      /* count the sensor */
+        if (count == HTU31D_GROUP_BATCH_MAX)                                          /* check the queue */
+        {
+            if (handle[index[0]]->iic_read_batch_ctx != NULL)                         /* check the batch read */
+            {
+                ret |= a_htu31d_group_fetch_batch(handle, index, count, sample, status);  /* fetch the batch */
+            }
+            else
+            {
+                ret |= a_htu31d_group_fetch_single(handle, index, count, sample, status); /* fetch one by one */
+            }
+            count = 0;                                                                /* clear the queue */
+        }
+    }
+    if (count != 0)                                                                   /* fetch the rest */
+    {
+        if (handle[index[0]]->iic_read_batch_ctx != NULL)                             /* check the batch read */
+        {
+            ret |= a_htu31d_group_fetch_batch(handle, index, count, sample, status);  /* fetch the batch */
+        }
+        else
+        {
+            ret |= a_htu31d_group_fetch_single(handle, index, count, sample, status); /* fetch one by one */
+        }
+    }
     
-    return 0;                          /* success return 0 */
+    return ret;                                                                       /* return the result */
 }
 
 /**
- * @brief      get humidity osr
- * @param[in]  *handle pointer to an htu31d handle structure
- * @param[out] *osr pointer to a humidity osr buffer
+ * @brief      read the temperature and humidity of a sensor group with one shared wait
+ * @param[in]  **handle pointer to an htu31d handle pointer array
+ * @param[in]  num sensor number
+ * @param[out] *sample pointer to a sample array with num entries
+ * @param[out] *status pointer to a status array with num entries
  * @return     status code
  *             - 0 success
+ *             - 1 some reads failed
  *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ *             - 5 param is error
+ * @note       the delay functions of the first started sensor are used for the shared wait
  */
-uint8_t htu31d_get_humidity_osr(htu31d_handle_t *handle, htu31d_humidity_osr_t *osr)
+uint8_t htu31d_group_read(htu31d_handle_t **handle, uint8_t num, htu31d_sample_t *sample, uint8_t *status)
 {
-    if (handle == NULL)                                          /* check handle */
+    uint8_t i;
+    uint8_t res;
+    uint32_t wait_us;
+    
+    res = htu31d_group_start_conversion(handle, num, status, &wait_us);               /* start all conversions */
+    if ((res != 0) && (res != 1))                                                     /* check the result */
     {
-        return 2;                                                /* return error */
+        return res;                                                                   /* return error */
     }
-    if (handle->inited != 1)                                     /* check handle initialization */
+    for (i = 0; i < num; i++)                                                         /* find a started sensor */
     {
-        return 3;                                                /* return error */
+        if (status[i] == 0)                                                           /* check the status */
+        {
+            a_htu31d_delay(handle[i], wait_us);                                       /* wait once */
+            a_htu31d_statistics_wait(handle[i], wait_us);                             /* record the wait */
+            
+            break;                                                                    /* break */
+        }
     }
     
-    *osr = (htu31d_humidity_osr_t)(handle->humidity_osr);        /* get osr */
-    
-    return 0;                                                    /* success return 0 */
+    return htu31d_group_fetch(handle, num, sample, status);                           /* fetch all results */
 }
 
 /**
- * @brief     set temperature osr
- * @param[in] *handle pointer to an htu31d handle structure
- * @param[in] osr temperature osr
- * @return    status code
- *            - 0 success
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      initialize a sensor group with one shared reset wait
+ * @param[in]  **handle pointer to an htu31d handle pointer array
+ * @param[in]  num sensor number
+ * @param[out] *status pointer to a status array with num entries
+ * @return     status code
+ *             - 0 success
+ *             - 1 some inits failed
+ *             - 2 handle is NULL
+ *             - 5 param is error
+ * @note       all sensors are reset back to back, the group waits 15 ms once and then reads the serial number
+ *             of every sensor to validate it, status[i] uses the htu31d_init codes and 4 also means the
+ *             serial number can't be read after the reset, the delay functions of the first reset sensor
+ *             are used for the shared wait
  */
-uint8_t htu31d_set_temperature_osr(htu31d_handle_t *handle, htu31d_temperature_osr_t osr)
+uint8_t htu31d_group_init(htu31d_handle_t **handle, uint8_t num, uint8_t *status)
 {
-    if (handle == NULL)                   /* check handle */
+    uint8_t i;
+    uint8_t res;
+    uint8_t first;
+    uint8_t buf[4];
+    
+    if (handle == NULL)                                                               /* check handle */
     {
-        return 2;                         /* return error */
+        return 2;                                                                     /* return error */
     }
-    if (handle->inited != 1)              /* check handle initialization */
+    if ((num == 0) || (status == NULL))                                               /* check the param */
     {
-        return 3;                         /* return error */
+        return 5;                                                                     /* return error */
     }
     
-    handle->temperature_osr = osr;        /* set osr */
+    first = num;                                                                      /* no reset sensor */
+    for (i = 0; i < num; i++)                                                         /* reset back to back */
+    {
+        if (handle[i] == NULL)                                                        /* check handle */
+        {
+            status[i] = 2;                                                            /* handle is NULL */
+            
+            continue;                                                                 /* next sensor */
+        }
+        if (a_htu31d_check_link(handle[i]) != 0)                                      /* check the linked functions */
+        {
+            status[i] = 3;                                                            /* linked functions is NULL */
+            
+            continue;                                                                 /* next sensor */
+        }
+        handle[i]->inited = 0;                                                        /* flag not initialized */
+        if (a_htu31d_iic_init(handle[i]) != 0)                                        /* iic init */
+        {
+            handle[i]->debug_print("htu31d: iic init failed.\n");                     /* iic init failed */
+            status[i] = 1;                                                            /* iic init failed */
+            
+            continue;                                                                 /* next sensor */
+        }
+        if (a_htu31d_probe(handle[i]) == 0)                                           /* check the warm start */
+        {
+            handle[i]->conversion = 0;                                                /* clear conversion flag */
+            handle[i]->humidity_priority = 0;                                         /* disable humidity priority */
+            handle[i]->continuous = 0;                                                /* clear continuous */
+            handle[i]->inited = 1;                                                    /* flag finish initialization */
+            status[i] = 0;                                                            /* healthy sensor */
+            
+            continue;                                                                 /* next sensor */
+        }
+        if (a_htu31d_write(handle[i], HTU31D_COMMAND_RESET, NULL, 0) != 0)            /* soft reset */
+        {
+            handle[i]->debug_print("htu31d: soft reset failed.\n");                   /* soft reset failed */
+            (void)a_htu31d_iic_deinit(handle[i]);                                     /* iic deinit */
+            status[i] = 4;                                                            /* reset failed */
+            
+            continue;                                                                 /* next sensor */
+        }
+        status[i] = 0;                                                                /* reset sent */
+        if (first == num)                                                             /* check the first one */
+        {
+            first = i;                                                                /* save the first one */
+        }
+    }
+    if (first != num)                                                                 /* check the reset sensors */
+    {
+        a_htu31d_delay_ms(handle[first], 15);                                         /* delay 15 ms once */
+    }
     
-    return 0;                             /* success return 0 */
+    res = 0;                                                                          /* all inits success */
+    for (i = 0; i < num; i++)                                                         /* validate all sensors */
+    {
+        if (status[i] != 0)                                                           /* check the status */
+        {
+            res = 1;                                                                  /* some inits failed */
+            
+            continue;                                                                 /* next sensor */
+        }
+        if (handle[i]->inited == 1)                                                   /* check the warm start */
+        {
+            continue;                                                                 /* already validated */
+        }
+        if ((a_htu31d_read(handle[i], HTU31D_COMMAND_READ_SERIAL_NUMBER, buf, 4) != 0) ||
+            (a_htu31d_crc(buf, 3, buf[3]) != 0))                                      /* read the serial number */
+        {
+            handle[i]->debug_print("htu31d: get serial number failed.\n");            /* get serial number failed */
+            (void)a_htu31d_iic_deinit(handle[i]);                                     /* iic deinit */
+            status[i] = 4;                                                            /* validation failed */
+            res = 1;                                                                  /* some inits failed */
+            
+            continue;                                                                 /* next sensor */
+        }
+        handle[i]->conversion = 0;                                                    /* clear conversion flag */
+        handle[i]->humidity_priority = 0;                                             /* disable humidity priority */
+        handle[i]->continuous = 0;                                                    /* clear continuous */
+        handle[i]->inited = 1;                                                        /* flag finish initialization */
+    }
+    
+    return res;                                                                       /* return the result */
 }
 
 /**
- * @brief      get temperature osr
- * @param[in]  *handle pointer to an htu31d handle structure
- * @param[out] *osr pointer to a temperature osr buffer
+ * @brief      close a sensor group with one shared reset wait
+ * @param[in]  **handle pointer to an htu31d handle pointer array
+ * @param[in]  num sensor number
+ * @param[out] *status pointer to a status array with num entries
  * @return     status code
  *             - 0 success
+ *             - 1 some deinits failed
  *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ *             - 5 param is error
+ * @note       all sensors are reset back to back and the group waits 15 ms once before closing the buses,
+ *             status[i] uses the htu31d_deinit codes, the delay functions of the first reset sensor
+ *             are used for the shared wait
  */
-uint8_t htu31d_get_temperature_osr(htu31d_handle_t *handle, htu31d_temperature_osr_t *osr)
+uint8_t htu31d_group_deinit(htu31d_handle_t **handle, uint8_t num, uint8_t *status)
 {
-    if (handle == NULL)                                                /* check handle */
+    uint8_t i;
+    uint8_t res;
+    uint8_t first;
+    
+    if (handle == NULL)                                                               /* check handle */
     {
-        return 2;                                                      /* return error */
+        return 2;                                                                     /* return error */
     }
-    if (handle->inited != 1)                                           /* check handle initialization */
+    if ((num == 0) || (status == NULL))                                               /* check the param */
     {
-        return 3;                                                      /* return error */
+        return 5;                                                                     /* return error */
     }
     
-    *osr = (htu31d_temperature_osr_t)(handle->temperature_osr);        /* get osr */
+    first = num;                                                                      /* no reset sensor */
+    for (i = 0; i < num; i++)                                                         /* reset back to back */
+    {
+        if (handle[i] == NULL)                                                        /* check handle */
+        {
+            status[i] = 2;                                                            /* handle is NULL */
+            
+            continue;                                                                 /* next sensor */
+        }
+        if (handle[i]->inited != 1)                                                   /* check handle initialization */
+        {
+            status[i] = 3;                                                            /* handle is not initialized */
+            
+            continue;                                                                 /* next sensor */
+        }
+        if (a_htu31d_write(handle[i], HTU31D_COMMAND_RESET, NULL, 0) != 0)            /* soft reset */
+        {
+            handle[i]->debug_print("htu31d: soft reset failed.\n");                   /* soft reset failed */
+            status[i] = 4;                                                            /* reset failed */
+            
+            continue;                                                                 /* next sensor */
+        }
+        status[i] = 0;                                                                /* reset sent */
+        if (first == num)                                                             /* check the first one */
+        {
+            first = i;                                                                /* save the first one */
+        }
+    }
+    if (first != num)                                                                 /* check the reset sensors */
+    {
+        a_htu31d_delay_ms(handle[first], 15);                                         /* delay 15 ms once */
+    }
     
-    return 0;                                                          /* success return 0 */
+    res = 0;                                                                          /* all deinits success */
+    for (i = 0; i < num; i++)                                                         /* close all buses */
+    {
+        if (status[i] != 0)                                                           /* check the status */
+        {
+            res = 1;                                                                  /* some deinits failed */
+            
+            continue;                                                                 /* next sensor */
+        }
+        if (a_htu31d_iic_deinit(handle[i]) != 0)                                      /* iic deinit */
+        {
+            handle[i]->debug_print("htu31d: iic deinit failed.\n");                   /* iic deinit failed */
+            status[i] = 1;                                                            /* iic deinit failed */
+            res = 1;                                                                  /* some deinits failed */
+            
+            continue;                                                                 /* next sensor */
+        }
+        handle[i]->inited = 0;                                                        /* flag close */
+    }
+    
+    return res;                                                                       /* return the result */
 }
 
 /**
@@ -889,6 +3110,30 @@ uint8_t htu31d_get_reg(htu31d_handle_t *handle, uint8_t reg, uint8_t *buf, uint1
     return a_htu31d_read(handle, reg, buf, len);        /* read command */
 }
 
+/**
+ * @brief     check the crc of a raw t && rh frame
+ * @param[in] *frame pointer to a 6 bytes frame buffer
+ * @return    status code
+ *            - 0 pass
+ *            - 2 frame is NULL
+ *            - 4 crc is error
+ * @note      frame layout is t_msb, t_lsb, t_crc, rh_msb, rh_lsb, rh_crc
+ */
+uint8_t htu31d_check_frame(const uint8_t frame[6])
+{
+    if (frame == NULL)                          /* check frame */
+    {
+        return 2;                               /* return error */
+    }
+    
+    if (a_htu31d_crc_frame(frame) != 0)         /* check the crc */
+    {
+        return 4;                               /* return error */
+    }
+    
+    return 0;                                   /* success return 0 */
+}
+
 /**
  * @brief      get chip's information
  * @param[out] *info pointer to an htu31d info structure
@@ -56,6 +56,15 @@ extern "C"{
  * @{
  */
 
+/**
+ * @brief htu31d bool enumeration definition
+ */
+typedef enum
+{
+    HTU31D_BOOL_FALSE = 0x00,        /**< false */
+    HTU31D_BOOL_TRUE  = 0x01,        /**< true */
+} htu31d_bool_t;
+
 /**
  * @brief htu31d addr pin enumeration definition
  */
@@ -65,6 +74,15 @@ typedef enum
     HTU31D_ADDR_PIN_HIGH = (0x41 << 1),        /**< pin to vcc */
 } htu31d_addr_pin_t;
 
+/**
+ * @brief htu31d init mode enumeration definition
+ */
+typedef enum
+{
+    HTU31D_INIT_MODE_COLD = 0x00,        /**< always soft reset */
+    HTU31D_INIT_MODE_WARM = 0x01,        /**< soft reset only when the diagnostic probe fails or reports an nvm error */
+} htu31d_init_mode_t;
+
 /**
  * @brief htu31d humidity osr enumeration definition
  */
@@ -102,6 +120,63 @@ typedef enum
     HTU31D_DIAGNOSTIC_HEATER_ON                 = (1 << 0),        /**< heater on */
 } htu31d_diagnostic_t;
 
+/**
+ * @brief htu31d group batch size definition
+ * @note  results read by one iic_read_batch_ctx call
+ */
+#ifndef HTU31D_GROUP_BATCH_MAX
+    #define HTU31D_GROUP_BATCH_MAX 16        /**< 16 sensors */
+#endif
+
+/**
+ * @brief htu31d statistics histogram buckets definition
+ * @note  bucket 0 counts latencies below 2us, bucket n counts [2^n, 2^(n + 1)) us,
+ *        the last bucket counts everything above
+ */
+#define HTU31D_STATISTICS_BUCKETS        16
+
+/**
+ * @brief htu31d statistics command enumeration definition
+ */
+typedef enum
+{
+    HTU31D_STATISTICS_COMMAND_T_RH          = 0x00,        /**< read t && rh */
+    HTU31D_STATISTICS_COMMAND_RH            = 0x01,        /**< read rh */
+    HTU31D_STATISTICS_COMMAND_T             = 0x02,        /**< read t */
+    HTU31D_STATISTICS_COMMAND_SERIAL_NUMBER = 0x03,        /**< read serial number */
+    HTU31D_STATISTICS_COMMAND_DIAGNOSTIC    = 0x04,        /**< read diagnostic */
+    HTU31D_STATISTICS_COMMAND_MAX           = 0x05,        /**< command number */
+} htu31d_statistics_command_t;
+
+/**
+ * @brief htu31d statistics api enumeration definition
+ */
+typedef enum
+{
+    HTU31D_STATISTICS_API_START_CONVERSION = 0x00,        /**< send a conversion command */
+    HTU31D_STATISTICS_API_FETCH            = 0x01,        /**< read and check a result */
+    HTU31D_STATISTICS_API_READ             = 0x02,        /**< blocking read from conversion to result */
+    HTU31D_STATISTICS_API_SOFT_RESET       = 0x03,        /**< soft reset including the reset time */
+    HTU31D_STATISTICS_API_MAX              = 0x04,        /**< api number */
+} htu31d_statistics_api_t;
+
+/**
+ * @brief htu31d statistics structure definition
+ */
+typedef struct htu31d_statistics_s
+{
+    uint32_t write_count;                                                        /**< write transactions */
+    uint32_t read_count;                                                         /**< read transactions */
+    uint32_t write_bytes;                                                        /**< written bytes including the command */
+    uint32_t read_bytes;                                                         /**< read data bytes */
+    uint32_t write_failed;                                                       /**< nacked or failed writes */
+    uint32_t read_failed;                                                        /**< nacked or failed reads */
+    uint32_t crc_error[HTU31D_STATISTICS_COMMAND_MAX];                           /**< crc errors per read command */
+    uint32_t wait_count;                                                         /**< conversion waits */
+    uint64_t wait_us;                                                            /**< time spent waiting for conversions in us */
+    uint32_t latency[HTU31D_STATISTICS_API_MAX][HTU31D_STATISTICS_BUCKETS];      /**< log2 latency histograms in us */
+} htu31d_statistics_t;
+
 /**
  * @brief htu31d handle structure definition
  */
@@ -112,13 +187,58 @@ typedef struct htu31d_handle_s
     uint8_t (*iic_write)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);        /**< point to an iic_write function address */
     uint8_t (*iic_read)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);         /**< point to an iic_read function address */
     void (*delay_ms)(uint32_t ms);                                                      /**< point to a delay_ms function address */
+    uint8_t (*iic_init_ctx)(void *user_data);                                           /**< point to an iic_init_ctx function address */
+    uint8_t (*iic_deinit_ctx)(void *user_data);                                         /**< point to an iic_deinit_ctx function address */
+    uint8_t (*iic_write_ctx)(void *user_data, uint8_t addr, uint8_t reg,
+                             uint8_t *buf, uint16_t len);                               /**< point to an iic_write_ctx function address */
+    uint8_t (*iic_read_ctx)(void *user_data, uint8_t addr, uint8_t reg,
+                            uint8_t *buf, uint16_t len);                                /**< point to an iic_read_ctx function address */
+    void (*delay_ms_ctx)(void *user_data, uint32_t ms);                                 /**< point to a delay_ms_ctx function address */
+    uint8_t (*iic_read_batch_ctx)(void **user_data, const uint8_t *addr, uint8_t num,
+                                  uint8_t reg, uint8_t *buf, uint16_t len);             /**< point to an iic_read_batch_ctx function address */
+    void *user_data;                                                                    /**< user context passed to the ctx functions */
+    void (*delay_us)(uint32_t us);                                                      /**< point to a delay_us function address */
+    uint32_t (*timestamp_us)(void);                                                     /**< point to a timestamp_us function address */
     void (*debug_print)(const char *const fmt, ...);                                    /**< point to a debug_print function address */
     uint8_t iic_addr;                                                                   /**< iic address */
+    uint8_t init_mode;                                                                  /**< init mode */
     uint8_t inited;                                                                     /**< inited flag */
     uint8_t humidity_osr;                                                               /**< humidity osr */
     uint8_t temperature_osr;                                                            /**< temperature osr */
+    uint8_t humidity_priority;                                                          /**< humidity priority mode */
+    uint8_t conversion;                                                                 /**< conversion in progress flag */
+    volatile uint8_t continuous;                                                        /**< continuous sampling flag */
+    uint32_t conversion_start;                                                          /**< conversion start timestamp in us */
+    uint32_t conversion_time;                                                           /**< conversion time in us */
+    htu31d_statistics_t *statistics;                                                    /**< statistics block, NULL disables it */
+    uint32_t read_start;                                                                /**< running blocking read start timestamp */
+    uint8_t read_pending;                                                               /**< blocking read running flag */
 } htu31d_handle_t;
 
+/**
+ * @brief htu31d sample structure definition
+ */
+typedef struct htu31d_sample_s
+{
+    uint32_t timestamp_us;             /**< conversion start timestamp in us */
+    uint16_t temperature_raw;          /**< raw temperature */
+    uint16_t humidity_raw;             /**< raw humidity */
+    int16_t temperature_centi;         /**< temperature in 0.01C */
+    uint16_t humidity_centi;           /**< humidity in 0.01% */
+} htu31d_sample_t;
+
+/**
+ * @brief htu31d periodic sampler structure definition
+ */
+typedef struct htu31d_periodic_s
+{
+    uint32_t period_us;                /**< sampling period in us */
+    uint32_t release;                  /**< next release timestamp in us */
+    uint32_t count;                    /**< taken samples */
+    uint32_t overrun;                  /**< missed release times */
+    uint32_t max_lateness_us;          /**< largest conversion start after its release in us */
+} htu31d_periodic_t;
+
 /**
  * @brief htu31d information structure definition
  */
@@ -194,6 +314,79 @@ typedef struct htu31d_info_s
  */
 #define DRIVER_HTU31D_LINK_DELAY_MS(HANDLE, FUC)                 (HANDLE)->delay_ms = FUC
 
+/**
+ * @brief     link user data
+ * @param[in] HANDLE pointer to an htu31d handle structure
+ * @param[in] DATA pointer to the user context passed to every ctx function
+ * @note      none
+ */
+#define DRIVER_HTU31D_LINK_USER_DATA(HANDLE, DATA)               (HANDLE)->user_data = DATA
+
+/**
+ * @brief     link iic_init_ctx function
+ * @param[in] HANDLE pointer to an htu31d handle structure
+ * @param[in] FUC pointer to an iic_init_ctx function address
+ * @note      optional, used instead of iic_init when it is linked
+ */
+#define DRIVER_HTU31D_LINK_IIC_INIT_CTX(HANDLE, FUC)             (HANDLE)->iic_init_ctx = FUC
+
+/**
+ * @brief     link iic_deinit_ctx function
+ * @param[in] HANDLE pointer to an htu31d handle structure
+ * @param[in] FUC pointer to an iic_deinit_ctx function address
+ * @note      optional, used instead of iic_deinit when it is linked
+ */
+#define DRIVER_HTU31D_LINK_IIC_DEINIT_CTX(HANDLE, FUC)           (HANDLE)->iic_deinit_ctx = FUC
+
+/**
+ * @brief     link iic_write_ctx function
+ * @param[in] HANDLE pointer to an htu31d handle structure
+ * @param[in] FUC pointer to an iic_write_ctx function address
+ * @note      optional, used instead of iic_write when it is linked
+ */
+#define DRIVER_HTU31D_LINK_IIC_WRITE_CTX(HANDLE, FUC)            (HANDLE)->iic_write_ctx = FUC
+
+/**
+ * @brief     link iic_read_ctx function
+ * @param[in] HANDLE pointer to an htu31d handle structure
+ * @param[in] FUC pointer to an iic_read_ctx function address
+ * @note      optional, used instead of iic_read when it is linked
+ */
+#define DRIVER_HTU31D_LINK_IIC_READ_CTX(HANDLE, FUC)             (HANDLE)->iic_read_ctx = FUC
+
+/**
+ * @brief     link delay_ms_ctx function
+ * @param[in] HANDLE pointer to an htu31d handle structure
+ * @param[in] FUC pointer to a delay_ms_ctx function address
+ * @note      optional, used instead of delay_ms when it is linked
+ */
+#define DRIVER_HTU31D_LINK_DELAY_MS_CTX(HANDLE, FUC)             (HANDLE)->delay_ms_ctx = FUC
+
+/**
+ * @brief     link iic_read_batch_ctx function
+ * @param[in] HANDLE pointer to an htu31d handle structure
+ * @param[in] FUC pointer to an iic_read_batch_ctx function address
+ * @note      optional, htu31d_group_fetch reads the group in one bus transaction when the
+ *            first fetched handle links it, user_data[i] is the user data of the handle read into buf + i * len
+ */
+#define DRIVER_HTU31D_LINK_IIC_READ_BATCH_CTX(HANDLE, FUC)       (HANDLE)->iic_read_batch_ctx = FUC
+
+/**
+ * @brief     link delay_us function
+ * @param[in] HANDLE pointer to an htu31d handle structure
+ * @param[in] FUC pointer to a delay_us function address
+ * @note      optional, the conversion wait falls back to delay_ms when it is not linked
+ */
+#define DRIVER_HTU31D_LINK_DELAY_US(HANDLE, FUC)                 (HANDLE)->delay_us = FUC
+
+/**
+ * @brief     link timestamp_us function
+ * @param[in] HANDLE pointer to an htu31d handle structure
+ * @param[in] FUC pointer to a timestamp_us function address
+ * @note      optional, only htu31d_is_conversion_ready needs it
+ */
+#define DRIVER_HTU31D_LINK_TIMESTAMP_US(HANDLE, FUC)             (HANDLE)->timestamp_us = FUC
+
 /**
  * @brief     link debug_print function
  * @param[in] HANDLE pointer to an htu31d handle structure
@@ -245,6 +438,28 @@ uint8_t htu31d_set_addr_pin(htu31d_handle_t *handle, htu31d_addr_pin_t addr_pin)
  */
 uint8_t htu31d_get_addr_pin(htu31d_handle_t *handle, htu31d_addr_pin_t *addr_pin);
 
+/**
+ * @brief     set the init mode
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] mode init mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      it is used by the next htu31d_init or htu31d_group_init
+ */
+uint8_t htu31d_set_init_mode(htu31d_handle_t *handle, htu31d_init_mode_t mode);
+
+/**
+ * @brief      get the init mode
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *mode pointer to an init mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t htu31d_get_init_mode(htu31d_handle_t *handle, htu31d_init_mode_t *mode);
+
 /**
  * @brief     initialize the chip
  * @param[in] *handle pointer to an htu31d handle structure
@@ -254,7 +469,7 @@ uint8_t htu31d_get_addr_pin(htu31d_handle_t *handle, htu31d_addr_pin_t *addr_pin
  *            - 2 handle is NULL
  *            - 3 linked functions is NULL
  *            - 4 reset failed
- * @note      none
+ * @note      in HTU31D_INIT_MODE_WARM a healthy sensor keeps running without the reset and the 15 ms wait
  */
 uint8_t htu31d_init(htu31d_handle_t *handle);
 
@@ -319,6 +534,7 @@ uint8_t htu31d_set_temperature_osr(htu31d_handle_t *handle, htu31d_temperature_o
  */
 uint8_t htu31d_get_temperature_osr(htu31d_handle_t *handle, htu31d_temperature_osr_t *osr);
 
+#ifndef HTU31D_DISABLE_FLOAT
 /**
  * @brief      read the temperature and humidity data
  * @param[in]  *handle pointer to an htu31d handle structure
@@ -355,6 +571,495 @@ uint8_t htu31d_read_temperature_humidity(htu31d_handle_t *handle,
  * @note       none
  */
 uint8_t htu31d_read_humidity(htu31d_handle_t *handle, uint16_t *humidity_raw, float *humidity_s);
+#endif
+
+/**
+ * @brief     start a conversion without waiting for the result
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start conversion failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 param is error
+ * @note      the result can be fetched after the conversion time
+ */
+uint8_t htu31d_start_conversion(htu31d_handle_t *handle);
+
+/**
+ * @brief     start a conversion for a humidity only read
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start conversion failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 param is error
+ * @note      in the humidity priority mode the temperature osr of this conversion is the lowest
+ */
+uint8_t htu31d_start_humidity_conversion(htu31d_handle_t *handle);
+
+/**
+ * @brief     start a conversion for a temperature only read
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start conversion failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 param is error
+ * @note      the humidity part of this conversion always uses the lowest osr
+ */
+uint8_t htu31d_start_temperature_conversion(htu31d_handle_t *handle);
+
+/**
+ * @brief      get the conversion time of the current osr
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *us pointer to a conversion time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 5 param is error
+ * @note       none
+ */
+uint8_t htu31d_get_conversion_time(htu31d_handle_t *handle, uint32_t *us);
+
+/**
+ * @brief      check whether the started conversion is finished
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *ready pointer to a ready flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timestamp_us is null
+ *             - 5 no conversion is started
+ * @note       the check compares the elapsed time with the osr deadline and doesn't access the bus
+ */
+uint8_t htu31d_is_conversion_ready(htu31d_handle_t *handle, uint8_t *ready);
+
+#ifndef HTU31D_DISABLE_FLOAT
+/**
+ * @brief      fetch the temperature and humidity data of the finished conversion
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_s pointer to a converted temperature buffer
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *humidity_s pointer to a converted humidity buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 fetch temperature humidity failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ * @note       none
+ */
+uint8_t htu31d_fetch_temperature_humidity(htu31d_handle_t *handle,
+                                          uint16_t *temperature_raw, float *temperature_s,
+                                          uint16_t *humidity_raw, float *humidity_s
+                                         );
+
+/**
+ * @brief      fetch the humidity data of the finished conversion
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *humidity_s pointer to a converted humidity buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 fetch humidity failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ * @note       none
+ */
+uint8_t htu31d_fetch_humidity(htu31d_handle_t *handle, uint16_t *humidity_raw, float *humidity_s);
+
+/**
+ * @brief      fetch the temperature data of the finished conversion
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_s pointer to a converted temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 fetch temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ * @note       only 3 bytes are transferred
+ */
+uint8_t htu31d_fetch_temperature(htu31d_handle_t *handle, uint16_t *temperature_raw, float *temperature_s);
+
+/**
+ * @brief      read the temperature data
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_s pointer to a converted temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 param is error
+ * @note       the conversion uses the lowest humidity osr and only the 3 bytes temperature field is read
+ */
+uint8_t htu31d_read_temperature(htu31d_handle_t *handle, uint16_t *temperature_raw, float *temperature_s);
+#endif
+
+/**
+ * @brief      fetch the fixed point temperature and humidity data of the finished conversion
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_centi pointer to a temperature buffer in 0.01C
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *humidity_centi pointer to a humidity buffer in 0.01%
+ * @return     status code
+ *             - 0 success
+ *             - 1 fetch temperature humidity failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ * @note       none
+ */
+uint8_t htu31d_fetch_temperature_humidity_fixed(htu31d_handle_t *handle,
+                                                uint16_t *temperature_raw, int16_t *temperature_centi,
+                                                uint16_t *humidity_raw, uint16_t *humidity_centi
+                                               );
+
+/**
+ * @brief      fetch the fixed point humidity data of the finished conversion
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *humidity_centi pointer to a humidity buffer in 0.01%
+ * @return     status code
+ *             - 0 success
+ *             - 1 fetch humidity failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ * @note       none
+ */
+uint8_t htu31d_fetch_humidity_fixed(htu31d_handle_t *handle, uint16_t *humidity_raw, uint16_t *humidity_centi);
+
+/**
+ * @brief      read the fixed point temperature and humidity data
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_centi pointer to a temperature buffer in 0.01C
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *humidity_centi pointer to a humidity buffer in 0.01%
+ * @return     status code
+ *             - 0 success
+ *             - 1 read temperature humidity failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 param is error
+ * @note       only integer multiply and shift is used, the error against the exact value is <= 0.005,
+ *             define HTU31D_DISABLE_FLOAT to leave the float api out of the build
+ */
+uint8_t htu31d_read_temperature_humidity_fixed(htu31d_handle_t *handle,
+                                               uint16_t *temperature_raw, int16_t *temperature_centi,
+                                               uint16_t *humidity_raw, uint16_t *humidity_centi
+                                              );
+
+/**
+ * @brief      read the fixed point humidity data
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *humidity_centi pointer to a humidity buffer in 0.01%
+ * @return     status code
+ *             - 0 success
+ *             - 1 read humidity failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 param is error
+ * @note       only integer multiply and shift is used, the error against the exact value is <= 0.005
+ */
+uint8_t htu31d_read_humidity_fixed(htu31d_handle_t *handle, uint16_t *humidity_raw, uint16_t *humidity_centi);
+
+/**
+ * @brief      fetch the fixed point temperature data of the finished conversion
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_centi pointer to a temperature buffer in 0.01C
+ * @return     status code
+ *             - 0 success
+ *             - 1 fetch temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ * @note       only 3 bytes are transferred
+ */
+uint8_t htu31d_fetch_temperature_fixed(htu31d_handle_t *handle, uint16_t *temperature_raw, int16_t *temperature_centi);
+
+/**
+ * @brief      read the fixed point temperature data
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_centi pointer to a temperature buffer in 0.01C
+ * @return     status code
+ *             - 0 success
+ *             - 1 read temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 param is error
+ * @note       the conversion uses the lowest humidity osr and only the 3 bytes temperature field is read
+ */
+uint8_t htu31d_read_temperature_fixed(htu31d_handle_t *handle, uint16_t *temperature_raw, int16_t *temperature_centi);
+
+/**
+ * @brief     run the continuous pipelined sampling loop
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] period_us sampling period in us, 0 means as fast as the conversion allows
+ * @param[in] *callback pointer to a sample callback function
+ * @return    status code
+ *            - 0 success
+ *            - 1 continuous read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 param is error
+ * @note      the next conversion is started right after the previous result is read, so the crc check,
+ *            the conversion and the callback overlap with the sensor conversion,
+ *            the loop returns after htu31d_continuous_stop is called,
+ *            crc errors are reported to the callback with res 4 and don't stop the loop,
+ *            when period_us is no more than the conversion time the next conversion already runs
+ *            during the callback, a stop then waits for it and discards its result, so the loop
+ *            always returns with no conversion in flight
+ */
+uint8_t htu31d_continuous_start(htu31d_handle_t *handle, uint32_t period_us,
+                                void (*callback)(htu31d_handle_t *handle, uint8_t res, htu31d_sample_t *sample));
+
+/**
+ * @brief     stop the continuous sampling loop
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      it can be called from the sample callback
+ */
+uint8_t htu31d_continuous_stop(htu31d_handle_t *handle);
+
+/**
+ * @brief      start a drift free periodic sampler
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *periodic pointer to a periodic sampler structure
+ * @param[in]  period_us sampling period in us
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timestamp_us is null
+ *             - 5 param is error
+ * @note       the first release time is now
+ */
+uint8_t htu31d_periodic_start(htu31d_handle_t *handle, htu31d_periodic_t *periodic, uint32_t period_us);
+
+/**
+ * @brief      take the sample of the next release time
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[in]  *periodic pointer to a periodic sampler structure
+ * @param[out] *sample pointer to a sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 periodic read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error or timestamp_us is null
+ *             - 5 param is error
+ * @note       the conversions start on absolute release times, so the bus and conversion time
+ *             don't add up to drift, the sample timestamp is the conversion midpoint,
+ *             release times that have already passed are counted as overruns and skipped
+ */
+uint8_t htu31d_periodic_read(htu31d_handle_t *handle, htu31d_periodic_t *periodic, htu31d_sample_t *sample);
+
+/**
+ * @brief      capture a batch of raw samples into caller owned arrays
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[in]  n sample number
+ * @param[in]  period sampling period in us, 0 means back to back conversions
+ * @param[out] *t_raw pointer to a raw temperature array with n entries
+ * @param[out] *rh_raw pointer to a raw humidity array with n entries
+ * @param[out] *ts pointer to a conversion start timestamp array with n entries, it can be NULL
+ * @return     status code
+ *             - 0 success
+ *             - 1 read batch failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 param is error or ts isn't NULL without timestamp_us
+ * @note       the loop doesn't convert to engineering units, use htu31d_convert_batch_fixed or
+ *             htu31d_convert_batch afterwards, ts counts in us from the linked timestamp_us without wrapping,
+ *             the release times follow an absolute schedule when timestamp_us is linked,
+ *             the batch stops at the first failed sample and the samples before it are kept
+ */
+uint8_t htu31d_read_batch(htu31d_handle_t *handle, uint32_t n, uint32_t period,
+                          uint16_t *t_raw, uint16_t *rh_raw, uint64_t *ts);
+
+/**
+ * @brief      convert a batch of raw samples to fixed point
+ * @param[in]  n sample number
+ * @param[in]  *t_raw pointer to a raw temperature array with n entries
+ * @param[in]  *rh_raw pointer to a raw humidity array with n entries
+ * @param[out] *t_centi pointer to a temperature array in 0.01C with n entries
+ * @param[out] *rh_centi pointer to a humidity array in 0.01% with n entries
+ * @note       the loop has no branches so the compiler can vectorize it
+ */
+void htu31d_convert_batch_fixed(uint32_t n, const uint16_t *t_raw, const uint16_t *rh_raw,
+                                int16_t *t_centi, uint16_t *rh_centi);
+
+#ifndef HTU31D_DISABLE_FLOAT
+/**
+ * @brief      convert a batch of raw samples to float
+ * @param[in]  n sample number
+ * @param[in]  *t_raw pointer to a raw temperature array with n entries
+ * @param[in]  *rh_raw pointer to a raw humidity array with n entries
+ * @param[out] *t pointer to a temperature array in C with n entries
+ * @param[out] *rh pointer to a humidity array in % with n entries
+ * @note       the loop has no branches so the compiler can vectorize it
+ */
+void htu31d_convert_batch(uint32_t n, const uint16_t *t_raw, const uint16_t *rh_raw, float *t, float *rh);
+#endif
+
+/**
+ * @brief     enable the statistics of a handle
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] *statistics pointer to a caller owned statistics block, NULL disables the statistics
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      the block is cleared, latencies are only recorded when timestamp_us is linked
+ */
+uint8_t htu31d_set_statistics(htu31d_handle_t *handle, htu31d_statistics_t *statistics);
+
+/**
+ * @brief      take a snapshot of the statistics
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *snapshot pointer to a statistics buffer
+ * @param[in]  reset clear the counters after the copy
+ * @return     status code
+ *             - 0 success
+ *             - 1 statistics is disabled
+ *             - 2 handle is NULL
+ *             - 5 snapshot is NULL
+ * @note       snapshot must not be the linked block, with HTU31D_STATISTICS_ATOMIC every counter is read
+ *             and cleared in one atomic step, so another thread can scrape and reset without losing counts,
+ *             counters of one snapshot can still mix values from before and after a running transaction
+ */
+uint8_t htu31d_get_statistics(htu31d_handle_t *handle, htu31d_statistics_t *snapshot, htu31d_bool_t reset);
+
+/**
+ * @brief      start the conversions of a sensor group back to back
+ * @param[in]  **handle pointer to an htu31d handle pointer array
+ * @param[in]  num sensor number
+ * @param[out] *status pointer to a status array with num entries
+ * @param[out] *wait_us pointer to a remaining wait time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 some conversions failed
+ *             - 2 handle is NULL
+ *             - 5 param is error
+ * @note       wait_us is the time until the slowest started conversion is finished,
+ *             status[i] uses the htu31d_start_conversion codes
+ */
+uint8_t htu31d_group_start_conversion(htu31d_handle_t **handle, uint8_t num, uint8_t *status, uint32_t *wait_us);
+
+/**
+ * @brief      fetch the results of a sensor group
+ * @param[in]  **handle pointer to an htu31d handle pointer array
+ * @param[in]  num sensor number
+ * @param[out] *sample pointer to a sample array with num entries
+ * @param[in]  *status pointer to a status array with num entries
+ * @return     status code
+ *             - 0 success
+ *             - 1 some fetches failed
+ *             - 2 handle is NULL
+ *             - 5 param is error
+ * @note       sensors whose status is not 0 are skipped,
+ *             status[i] is updated with the htu31d_fetch_temperature_humidity codes,
+ *             when the first fetched handle links iic_read_batch_ctx all sensors must share its bus and
+ *             up to HTU31D_GROUP_BATCH_MAX results are read per bus transaction, a failed batch
+ *             is retried sensor by sensor to find the failed ones
+ */
+uint8_t htu31d_group_fetch(htu31d_handle_t **handle, uint8_t num, htu31d_sample_t *sample, uint8_t *status);
+
+/**
+ * @brief      read the temperature and humidity of a sensor group with one shared wait
+ * @param[in]  **handle pointer to an htu31d handle pointer array
+ * @param[in]  num sensor number
+ * @param[out] *sample pointer to a sample array with num entries
+ * @param[out] *status pointer to a status array with num entries
+ * @return     status code
+ *             - 0 success
+ *             - 1 some reads failed
+ *             - 2 handle is NULL
+ *             - 5 param is error
+ * @note       all conversion commands are sent first, then the group waits once for the slowest osr
+ *             and reads every result, so n sensors cost about one conversion time
+ */
+uint8_t htu31d_group_read(htu31d_handle_t **handle, uint8_t num, htu31d_sample_t *sample, uint8_t *status);
+
+/**
+ * @brief      initialize a sensor group with one shared reset wait
+ * @param[in]  **handle pointer to an htu31d handle pointer array
+ * @param[in]  num sensor number
+ * @param[out] *status pointer to a status array with num entries
+ * @return     status code
+ *             - 0 success
+ *             - 1 some inits failed
+ *             - 2 handle is NULL
+ *             - 5 param is error
+ * @note       all sensors are reset back to back, the group waits 15 ms once and then reads the serial number
+ *             of every sensor to validate it, status[i] uses the htu31d_init codes and 4 also means the
+ *             serial number can't be read after the reset, the delay functions of the first reset sensor
+ *             are used for the shared wait
+ */
+uint8_t htu31d_group_init(htu31d_handle_t **handle, uint8_t num, uint8_t *status);
+
+/**
+ * @brief      close a sensor group with one shared reset wait
+ * @param[in]  **handle pointer to an htu31d handle pointer array
+ * @param[in]  num sensor number
+ * @param[out] *status pointer to a status array with num entries
+ * @return     status code
+ *             - 0 success
+ *             - 1 some deinits failed
+ *             - 2 handle is NULL
+ *             - 5 param is error
+ * @note       all sensors are reset back to back and the group waits 15 ms once before closing the buses,
+ *             status[i] uses the htu31d_deinit codes, the delay functions of the first reset sensor
+ *             are used for the shared wait
+ */
+uint8_t htu31d_group_deinit(htu31d_handle_t **handle, uint8_t num, uint8_t *status);
+
+/**
+ * @brief     enable or disable the humidity priority mode
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      when enabled, humidity only reads run the conversion with the lowest temperature osr
+ *            and wait only for that shorter conversion
+ */
+uint8_t htu31d_set_humidity_priority(htu31d_handle_t *handle, htu31d_bool_t enable);
+
+/**
+ * @brief      get the humidity priority mode status
+ * @param[in]  *handle pointer to an htu31d handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t htu31d_get_humidity_priority(htu31d_handle_t *handle, htu31d_bool_t *enable);
 
 /**
  * @brief     soft reset
@@ -461,6 +1166,17 @@ uint8_t htu31d_set_reg(htu31d_handle_t *handle, uint8_t reg, uint8_t *buf, uint1
  */
 uint8_t htu31d_get_reg(htu31d_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     check the crc of a raw t && rh frame
+ * @param[in] *frame pointer to a 6 bytes frame buffer
+ * @return    status code
+ *            - 0 pass
+ *            - 2 frame is NULL
+ *            - 4 crc is error
+ * @note      frame layout is t_msb, t_lsb, t_crc, rh_msb, rh_lsb, rh_crc
+ */
+uint8_t htu31d_check_frame(const uint8_t frame[6]);
+
 /**
  * @}
  */
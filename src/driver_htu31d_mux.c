@@ -0,0 +1,541 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_htu31d_mux.c
+ * @brief     driver htu31d mux source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_htu31d_mux.h"
+
+/**
+ * @brief     select a channel
+ * @param[in] *mux pointer to an htu31d mux structure
+ * @param[in] channel channel index
+ * @return    status code
+ *            - 0 success
+ *            - 1 select failed
+ * @note      none
+ */
+static uint8_t a_htu31d_mux_select(htu31d_mux_t *mux, uint8_t channel)
+{
+    if (mux->channel == channel)                                                     /* check the cache */
+    {
+        return 0;                                                                    /* already selected */
+    }
+    mux->select_count++;                                                             /* count the select */
+    if (mux->iic_write_ctx(mux->user_data, mux->iic_addr,
+                           (uint8_t)(1 << channel), NULL, 0) != 0)                   /* write the control register */
+    {
+        mux->channel = HTU31D_MUX_CHANNEL_NONE;                                      /* state is unknown */
+        
+        return 1;                                                                    /* return error */
+    }
+    mux->channel = channel;                                                          /* cache the channel */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     wait until the conversions of all started handles are finished
+ * @param[in] **handle pointer to an htu31d handle pointer array
+ * @param[in] num sensor number
+ * @param[in] *status pointer to a status array with num entries, 0 means started
+ * @note      it waits once for the longest remaining conversion time, without timestamp_us
+ *            the full conversion time of a handle remains,
+ *            delay_ms_ctx is never used because the user data of the handle is its mux channel
+ */
+static void a_htu31d_mux_wait(htu31d_handle_t **handle, uint8_t num, const uint8_t *status)
+{
+    uint8_t i;
+    uint32_t elapsed;
+    uint32_t remain;
+    uint32_t max;
+    htu31d_handle_t *wait;
+    
+    max = 0;                                                                         /* nothing to wait */
+    wait = NULL;                                                                     /* no handle */
+    for (i = 0; i < num; i++)                                                        /* check all handles */
+    {
+        if (status[i] != 0)                                                          /* check the start */
+        {
+            continue;                                                                /* skip it */
+        }
+        remain = handle[i]->conversion_time;                                         /* full conversion time */
+        if (handle[i]->timestamp_us != NULL)                                         /* check timestamp_us */
+        {
+            elapsed = handle[i]->timestamp_us() - handle[i]->conversion_start;       /* get the elapsed time */
+            remain = (elapsed < remain) ? (remain - elapsed) : 0;                    /* get the remaining time */
+        }
+        if (remain > max)                                                            /* check the longest one */
+        {
+            max = remain;                                                            /* save the time */
+            wait = handle[i];                                                        /* save the handle */
+        }
+    }
+    if (wait == NULL)                                                                /* check the remaining time */
+    {
+        return;                                                                      /* finished */
+    }
+    if (wait->delay_us != NULL)                                                      /* check delay_us */
+    {
+        wait->delay_us(max);                                                         /* delay us */
+    }
+    else
+    {
+        wait->delay_ms((max + 999) / 1000);                                          /* delay ms */
+    }
+}
+
+/**
+ * @brief      fetch the results of the sensors behind one mux in one batch
+ * @param[in]  **handle pointer to an htu31d handle pointer array
+ * @param[in]  num sensor number, no more than HTU31D_GROUP_BATCH_MAX
+ * @param[in]  *order pointer to the channel start order
+ * @param[in]  n channel number in order
+ * @param[out] *sample pointer to a sample array with num entries
+ * @param[in,out] *status pointer to a status array with num entries
+ * @return     0 for success or 1 for an error
+ * @note       the started sensors are fetched in the reverse start order like the single path
+ */
+static uint8_t a_htu31d_mux_group_fetch(htu31d_handle_t **handle, uint8_t num, const uint8_t *order, uint8_t n,
+                                        htu31d_sample_t *sample, uint8_t *status)
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t k;
+    uint8_t res;
+    uint8_t index[HTU31D_GROUP_BATCH_MAX];
+    uint8_t fetch_status[HTU31D_GROUP_BATCH_MAX];
+    htu31d_handle_t *fetch_handle[HTU31D_GROUP_BATCH_MAX];
+    htu31d_sample_t fetch_sample[HTU31D_GROUP_BATCH_MAX];
+    htu31d_mux_channel_t *channel;
+    
+    res = 0;                                                                         /* all reads success */
+    k = 0;                                                                           /* no sensor */
+    a_htu31d_mux_wait(handle, num, status);                                          /* wait all conversions */
+    for (j = n; j > 0; j--)                                                          /* queue in the reverse order */
+    {
+        for (i = num; i > 0; i--)                                                    /* queue the channel sensors */
+        {
+            channel = (htu31d_mux_channel_t *)handle[i - 1]->user_data;              /* get the channel */
+            if ((channel->channel != order[j - 1]) || (status[i - 1] != 0))          /* check the channel and start */
+            {
+                continue;                                                            /* skip it */
+            }
+            index[k] = i - 1;                                                        /* save the sensor */
+            fetch_handle[k] = handle[i - 1];                                         /* queue the handle */
+            fetch_status[k] = 0;                                                     /* started */
+            k++;                                                                     /* count the sensor */
+        }
+    }
+    if (k != 0)                                                                      /* check the started sensors */
+    {
+        (void)htu31d_group_fetch(fetch_handle, k, fetch_sample, fetch_status);       /* fetch all results */
+    }
+    for (j = 0; j < k; j++)                                                          /* copy the results */
+    {
+        i = index[j];                                                                /* get the sensor */
+        status[i] = fetch_status[j];                                                 /* set the status */
+        sample[i] = fetch_sample[j];                                                 /* set the sample */
+        sample[i].timestamp_us = handle[i]->conversion_start +
+                                 handle[i]->conversion_time / 2;                     /* conversion midpoint */
+    }
+    for (i = 0; i < num; i++)                                                        /* check the status */
+    {
+        if (status[i] != 0)                                                          /* check the result */
+        {
+            res = 1;                                                                 /* some reads failed */
+        }
+    }
+    
+    return res;                                                                      /* return the result */
+}
+
+/**
+ * @brief     set the mux address
+ * @param[in] *mux pointer to an htu31d mux structure
+ * @param[in] addr mux write address
+ * @return    status code
+ *            - 0 success
+ *            - 2 mux is NULL
+ * @note      the selected channel becomes unknown
+ */
+uint8_t htu31d_mux_set_addr(htu31d_mux_t *mux, uint8_t addr)
+{
+    if (mux == NULL)                                                                 /* check mux */
+    {
+        return 2;                                                                    /* return error */
+    }
+    
+    mux->iic_addr = addr;                                                            /* set the address */
+    mux->channel = HTU31D_MUX_CHANNEL_NONE;                                          /* state is unknown */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     forget the cached channel
+ * @param[in] *mux pointer to an htu31d mux structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 mux is NULL
+ * @note      call it when another master may have changed the mux, the next transaction selects again
+ */
+uint8_t htu31d_mux_invalidate(htu31d_mux_t *mux)
+{
+    if (mux == NULL)                                                                 /* check mux */
+    {
+        return 2;                                                                    /* return error */
+    }
+    
+    mux->channel = HTU31D_MUX_CHANNEL_NONE;                                          /* state is unknown */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     init a mux channel
+ * @param[in] *channel pointer to an htu31d mux channel structure
+ * @param[in] *mux pointer to an htu31d mux structure
+ * @param[in] index channel index
+ * @return    status code
+ *            - 0 success
+ *            - 2 channel or mux is NULL
+ *            - 5 index is over HTU31D_MUX_CHANNEL_MAX
+ * @note      link the channel as the handle user data and the htu31d_mux_iic_* functions as its ctx iic functions,
+ *            delay_ms_ctx must not be linked, because it would get the channel as user data
+ */
+uint8_t htu31d_mux_channel_init(htu31d_mux_channel_t *channel, htu31d_mux_t *mux, uint8_t index)
+{
+    if ((channel == NULL) || (mux == NULL))                                          /* check channel and mux */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (index >= HTU31D_MUX_CHANNEL_MAX)                                             /* check the index */
+    {
+        return 5;                                                                    /* return error */
+    }
+    
+    channel->mux = mux;                                                              /* set the mux */
+    channel->channel = index;                                                        /* set the channel */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     mux channel iic bus init
+ * @param[in] *user_data pointer to an htu31d mux channel structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      the parent bus is inited by the first channel handle
+ */
+uint8_t htu31d_mux_iic_init(void *user_data)
+{
+    htu31d_mux_t *mux = ((htu31d_mux_channel_t *)user_data)->mux;
+    
+    if (mux->ref == 0)                                                               /* first channel handle */
+    {
+        if ((mux->iic_init_ctx != NULL) &&
+            (mux->iic_init_ctx(mux->user_data) != 0))                                /* init the parent bus */
+        {
+            return 1;                                                                /* return error */
+        }
+        mux->channel = HTU31D_MUX_CHANNEL_NONE;                                      /* state is unknown */
+    }
+    mux->ref++;                                                                      /* count the handle */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     mux channel iic bus deinit
+ * @param[in] *user_data pointer to an htu31d mux channel structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      the parent bus is closed by the last channel handle
+ */
+uint8_t htu31d_mux_iic_deinit(void *user_data)
+{
+    htu31d_mux_t *mux = ((htu31d_mux_channel_t *)user_data)->mux;
+    
+    if (mux->ref == 0)                                                               /* check the count */
+    {
+        return 0;                                                                    /* nothing is inited */
+    }
+    mux->ref--;                                                                      /* release the handle */
+    if (mux->ref == 0)                                                               /* last channel handle */
+    {
+        if ((mux->iic_deinit_ctx != NULL) &&
+            (mux->iic_deinit_ctx(mux->user_data) != 0))                              /* deinit the parent bus */
+        {
+            return 1;                                                                /* return error */
+        }
+    }
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     mux channel iic bus write
+ * @param[in] *user_data pointer to an htu31d mux channel structure
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the channel is only selected when the cached one differs
+ */
+uint8_t htu31d_mux_iic_write(void *user_data, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    htu31d_mux_channel_t *channel = (htu31d_mux_channel_t *)user_data;
+    
+    if (a_htu31d_mux_select(channel->mux, channel->channel) != 0)                   /* select the channel */
+    {
+        return 1;                                                                    /* return error */
+    }
+    
+    return channel->mux->iic_write_ctx(channel->mux->user_data, addr, reg, buf, len);   /* write the parent bus */
+}
+
+/**
+ * @brief      mux channel iic bus read
+ * @param[in]  *user_data pointer to an htu31d mux channel structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the channel is only selected when the cached one differs
+ */
+uint8_t htu31d_mux_iic_read(void *user_data, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    htu31d_mux_channel_t *channel = (htu31d_mux_channel_t *)user_data;
+    
+    if (a_htu31d_mux_select(channel->mux, channel->channel) != 0)                   /* select the channel */
+    {
+        return 1;                                                                    /* return error */
+    }
+    
+    return channel->mux->iic_read_ctx(channel->mux->user_data, addr, reg, buf, len);    /* read the parent bus */
+}
+
+/**
+ * @brief      mux channel iic bus batch read
+ * @param[in]  **user_data pointer to an htu31d mux channel structure array with num entries
+ * @param[in]  *addr pointer to an iic device write address array
+ * @param[in]  num device number, no more than HTU31D_GROUP_BATCH_MAX
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer with num * len bytes
+ * @param[in]  len data length of each device
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       link it as the iic_read_batch_ctx of the channel handles, all channels must use the same mux,
+ *             a select is only queued before a read whose channel differs from the previous one
+ */
+uint8_t htu31d_mux_iic_read_batch(void **user_data, const uint8_t *addr, uint8_t num, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t i;
+    uint8_t last;
+    uint8_t select[HTU31D_GROUP_BATCH_MAX];
+    htu31d_mux_t *mux;
+    htu31d_mux_channel_t *channel;
+    
+    if ((num == 0) || (num > HTU31D_GROUP_BATCH_MAX))                                /* check num */
+    {
+        return 1;                                                                    /* return error */
+    }
+    
+    mux = ((htu31d_mux_channel_t *)user_data[0])->mux;                               /* get the mux */
+    if (mux->iic_read_batch_select_ctx == NULL)                                      /* check the batch read */
+    {
+        for (i = 0; i < num; i++)                                                    /* read one by one */
+        {
+            if (htu31d_mux_iic_read(user_data[i], addr[i], reg, buf + i * len, len) != 0)  /* read the device */
+            {
+                return 1;                                                            /* return error */
+            }
+        }
+        
+        return 0;                                                                    /* success return 0 */
+    }
+    
+    last = mux->channel;                                                             /* start with the cached channel */
+    for (i = 0; i < num; i++)                                                        /* queue the selects */
+    {
+        channel = (htu31d_mux_channel_t *)user_data[i];                              /* get the channel */
+        if (channel->channel != last)                                                /* check the channel */
+        {
+            select[i] = (uint8_t)(1 << channel->channel);                            /* select it */
+            last = channel->channel;                                                 /* save the channel */
+            mux->select_count++;                                                     /* count the select */
+        }
+        else
+        {
+            select[i] = 0;                                                           /* no select */
+        }
+    }
+    if (mux->iic_read_batch_select_ctx(mux->user_data, mux->iic_addr, select,
+                                       addr, num, reg, buf, len) != 0)               /* read the batch */
+    {
+        mux->channel = HTU31D_MUX_CHANNEL_NONE;                                      /* state is unknown */
+        
+        return 1;                                                                    /* return error */
+    }
+    mux->channel = last;                                                             /* cache the channel */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief      read the temperature and humidity of the sensors behind one mux
+ * @param[in]  **handle pointer to an htu31d handle pointer array
+ * @param[in]  num sensor number
+ * @param[out] *sample pointer to a sample array with num entries
+ * @param[out] *status pointer to a status array with num entries
+ * @return     status code
+ *             - 0 success
+ *             - 1 some reads failed
+ *             - 2 handle is NULL
+ *             - 3 a handle links neither delay_us nor delay_ms
+ *             - 5 param is error
+ * @note       all handles must use mux channels of the same mux, the conversions are started channel by channel
+ *             beginning with the selected one, then the results are fetched in the reverse channel order,
+ *             so a sweep over c channels costs at most 2 * c - 1 mux writes and the conversions overlap,
+ *             status[i] uses the htu31d_start_conversion and htu31d_fetch_temperature_humidity codes,
+ *             when the handles link iic_read_batch_ctx the results are fetched with htu31d_group_fetch
+ *             in the same order and num must be no more than HTU31D_GROUP_BATCH_MAX,
+ *             the fetch starts after one wait for the longest remaining conversion time
+ */
+uint8_t htu31d_mux_group_read(htu31d_handle_t **handle, uint8_t num, htu31d_sample_t *sample, uint8_t *status)
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t n;
+    uint8_t ch;
+    uint8_t res;
+    uint8_t order[HTU31D_MUX_CHANNEL_MAX];
+    htu31d_mux_t *mux;
+    htu31d_mux_channel_t *channel;
+    
+    if (handle == NULL)                                                              /* check handle */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if ((num == 0) || (sample == NULL) || (status == NULL))                          /* check the param */
+    {
+        return 5;                                                                    /* return error */
+    }
+    if ((handle[0] != NULL) && (handle[0]->iic_read_batch_ctx != NULL) &&
+        (num > HTU31D_GROUP_BATCH_MAX))                                              /* check the batch size */
+    {
+        return 5;                                                                    /* return error */
+    }
+    for (i = 0; i < num; i++)                                                        /* check the handles */
+    {
+        if ((handle[i] == NULL) || (handle[i]->user_data == NULL))                   /* check the handle */
+        {
+            return 2;                                                                /* return error */
+        }
+        if ((handle[i]->delay_us == NULL) && (handle[i]->delay_ms == NULL))          /* check the delay */
+        {
+            return 3;                                                                /* return error */
+        }
+    }
+    
+    mux = ((htu31d_mux_channel_t *)handle[0]->user_data)->mux;                       /* get the mux */
+    n = 0;                                                                           /* no channel */
+    if (mux->channel < HTU31D_MUX_CHANNEL_MAX)                                       /* check the selected channel */
+    {
+        order[n++] = mux->channel;                                                   /* start with the selected one */
+    }
+    for (ch = 0; ch < HTU31D_MUX_CHANNEL_MAX; ch++)                                  /* add the other channels */
+    {
+        if (ch != mux->channel)                                                      /* skip the selected one */
+        {
+            order[n++] = ch;                                                         /* add the channel */
+        }
+    }
+    
+    for (j = 0; j < n; j++)                                                          /* start channel by channel */
+    {
+        for (i = 0; i < num; i++)                                                    /* start the channel sensors */
+        {
+            channel = (htu31d_mux_channel_t *)handle[i]->user_data;                  /* get the channel */
+            if (channel->channel == order[j])                                        /* check the channel */
+            {
+                status[i] = htu31d_start_conversion(handle[i]);                      /* start conversion */
+            }
+        }
+    }
+    
+    if (handle[0]->iic_read_batch_ctx != NULL)                                       /* check the batch read */
+    {
+        return a_htu31d_mux_group_fetch(handle, num, order, n, sample, status);     /* fetch the batch */
+    }
+    
+    res = 0;                                                                         /* all reads success */
+    a_htu31d_mux_wait(handle, num, status);                                          /* wait all conversions */
+    for (j = n; j > 0; j--)                                                          /* fetch in the reverse order */
+    {
+        for (i = num; i > 0; i--)                                                    /* fetch the channel sensors */
+        {
+            channel = (htu31d_mux_channel_t *)handle[i - 1]->user_data;              /* get the channel */
+            if ((channel->channel != order[j - 1]) || (status[i - 1] != 0))          /* check the channel and start */
+            {
+                continue;                                                            /* skip it */
+            }
+            status[i - 1] = htu31d_fetch_temperature_humidity_fixed(handle[i - 1],
+                                                                    &sample[i - 1].temperature_raw,
+                                                                    &sample[i - 1].temperature_centi,
+                                                                    &sample[i - 1].humidity_raw,
+                                                                    &sample[i - 1].humidity_centi);  /* fetch t && rh */
+            sample[i - 1].timestamp_us = handle[i - 1]->conversion_start +
+                                         handle[i - 1]->conversion_time / 2;         /* conversion midpoint */
+        }
+    }
+    for (i = 0; i < num; i++)                                                        /* check the status */
+    {
+        if (status[i] != 0)                                                          /* check the result */
+        {
+            res = 1;                                                                 /* some reads failed */
+        }
+    }
+    
+    return res;                                                                      /* return the result */
+}
@@ -0,0 +1,299 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_htu31d_mux.h
+ * @brief     driver htu31d mux header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_HTU31D_MUX_H
+#define DRIVER_HTU31D_MUX_H
+
+#include "driver_htu31d.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup htu31d_mux_driver htu31d mux driver function
+ * @brief    htu31d mux driver modules
+ * @ingroup  htu31d_driver
+ * @{
+ */
+
+/**
+ * @brief htu31d mux definition
+ */
+#define HTU31D_MUX_ADDR_BASE         (0x70 << 1)        /**< TCA9548A write address with A2 A1 A0 low */
+#define HTU31D_MUX_CHANNEL_MAX       8                  /**< channel number */
+#define HTU31D_MUX_CHANNEL_NONE      0xFF               /**< no channel is known to be selected */
+
+/**
+ * @brief htu31d mux structure definition
+ */
+typedef struct htu31d_mux_s
+{
+    void *user_data;                                                        /**< parent bus user data */
+    uint8_t (*iic_init_ctx)(void *user_data);                               /**< point to a parent iic_init_ctx function address */
+    uint8_t (*iic_deinit_ctx)(void *user_data);                             /**< point to a parent iic_deinit_ctx function address */
+    uint8_t (*iic_write_ctx)(void *user_data, uint8_t addr, uint8_t reg,
+                             uint8_t *buf, uint16_t len);                   /**< point to a parent iic_write_ctx function address */
+    uint8_t (*iic_read_ctx)(void *user_data, uint8_t addr, uint8_t reg,
+                            uint8_t *buf, uint16_t len);                    /**< point to a parent iic_read_ctx function address */
+    uint8_t (*iic_read_batch_select_ctx)(void *user_data, uint8_t mux_addr,
+                                         const uint8_t *select, const uint8_t *addr,
+                                         uint8_t num, uint8_t reg,
+                                         uint8_t *buf, uint16_t len);       /**< point to a parent iic_read_batch_select_ctx function address */
+    uint8_t iic_addr;                                                       /**< mux write address */
+    uint8_t channel;                                                        /**< cached selected channel */
+    uint8_t ref;                                                            /**< inited channel handles */
+    uint32_t select_count;                                                  /**< channel select writes */
+} htu31d_mux_t;
+
+/**
+ * @brief htu31d mux channel structure definition
+ * @note  it is the user data of a handle behind the mux
+ */
+typedef struct htu31d_mux_channel_s
+{
+    htu31d_mux_t *mux;                  /**< mux */
+    uint8_t channel;                    /**< channel */
+} htu31d_mux_channel_t;
+
+/**
+ * @defgroup htu31d_mux_link_driver htu31d mux link driver function
+ * @brief    htu31d mux link driver modules
+ * @ingroup  htu31d_mux_driver
+ * @{
+ */
+
+/**
+ * @brief     initialize htu31d_mux_t structure
+ * @param[in] MUX pointer to an htu31d mux structure
+ * @note      none
+ */
+#define DRIVER_HTU31D_MUX_LINK_INIT(MUX)                  memset(MUX, 0, sizeof(htu31d_mux_t))
+
+/**
+ * @brief     link the parent bus user data
+ * @param[in] MUX pointer to an htu31d mux structure
+ * @param[in] DATA pointer to the parent bus user data
+ * @note      none
+ */
+#define DRIVER_HTU31D_MUX_LINK_USER_DATA(MUX, DATA)       (MUX)->user_data = DATA
+
+/**
+ * @brief     link the parent iic_init_ctx function
+ * @param[in] MUX pointer to an htu31d mux structure
+ * @param[in] FUC pointer to an iic_init_ctx function address
+ * @note      none
+ */
+#define DRIVER_HTU31D_MUX_LINK_IIC_INIT_CTX(MUX, FUC)     (MUX)->iic_init_ctx = FUC
+
+/**
+ * @brief     link the parent iic_deinit_ctx function
+ * @param[in] MUX pointer to an htu31d mux structure
+ * @param[in] FUC pointer to an iic_deinit_ctx function address
+ * @note      none
+ */
+#define DRIVER_HTU31D_MUX_LINK_IIC_DEINIT_CTX(MUX, FUC)   (MUX)->iic_deinit_ctx = FUC
+
+/**
+ * @brief     link the parent iic_write_ctx function
+ * @param[in] MUX pointer to an htu31d mux structure
+ * @param[in] FUC pointer to an iic_write_ctx function address
+ * @note      none
+ */
+#define DRIVER_HTU31D_MUX_LINK_IIC_WRITE_CTX(MUX, FUC)    (MUX)->iic_write_ctx = FUC
+
+/**
+ * @brief     link the parent iic_read_ctx function
+ * @param[in] MUX pointer to an htu31d mux structure
+ * @param[in] FUC pointer to an iic_read_ctx function address
+ * @note      none
+ */
+#define DRIVER_HTU31D_MUX_LINK_IIC_READ_CTX(MUX, FUC)     (MUX)->iic_read_ctx = FUC
+
+/**
+ * @brief     link the parent iic_read_batch_select_ctx function
+ * @param[in] MUX pointer to an htu31d mux structure
+ * @param[in] FUC pointer to an iic_read_batch_select_ctx function address
+ * @note      optional, htu31d_mux_iic_read_batch sends the channel selects and the reads in one bus transaction
+ *            when it is linked and falls back to htu31d_mux_iic_read otherwise
+ */
+#define DRIVER_HTU31D_MUX_LINK_IIC_READ_BATCH_SELECT_CTX(MUX, FUC)    (MUX)->iic_read_batch_select_ctx = FUC
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup htu31d_mux_base_driver htu31d mux base driver function
+ * @brief    htu31d mux base driver modules
+ * @ingroup  htu31d_mux_driver
+ * @{
+ */
+
+/**
+ * @brief     set the mux address
+ * @param[in] *mux pointer to an htu31d mux structure
+ * @param[in] addr mux write address
+ * @return    status code
+ *            - 0 success
+ *            - 2 mux is NULL
+ * @note      the selected channel becomes unknown
+ */
+uint8_t htu31d_mux_set_addr(htu31d_mux_t *mux, uint8_t addr);
+
+/**
+ * @brief     forget the cached channel
+ * @param[in] *mux pointer to an htu31d mux structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 mux is NULL
+ * @note      call it when another master may have changed the mux, the next transaction selects again
+ */
+uint8_t htu31d_mux_invalidate(htu31d_mux_t *mux);
+
+/**
+ * @brief     init a mux channel
+ * @param[in] *channel pointer to an htu31d mux channel structure
+ * @param[in] *mux pointer to an htu31d mux structure
+ * @param[in] index channel index
+ * @return    status code
+ *            - 0 success
+ *            - 2 channel or mux is NULL
+ *            - 5 index is over HTU31D_MUX_CHANNEL_MAX
+ * @note      link the channel as the handle user data and the htu31d_mux_iic_* functions as its ctx iic functions,
+ *            delay_ms_ctx must not be linked, because it would get the channel as user data
+ */
+uint8_t htu31d_mux_channel_init(htu31d_mux_channel_t *channel, htu31d_mux_t *mux, uint8_t index);
+
+/**
+ * @brief     mux channel iic bus init
+ * @param[in] *user_data pointer to an htu31d mux channel structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      the parent bus is inited by the first channel handle
+ */
+uint8_t htu31d_mux_iic_init(void *user_data);
+
+/**
+ * @brief     mux channel iic bus deinit
+ * @param[in] *user_data pointer to an htu31d mux channel structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      the parent bus is closed by the last channel handle
+ */
+uint8_t htu31d_mux_iic_deinit(void *user_data);
+
+/**
+ * @brief     mux channel iic bus write
+ * @param[in] *user_data pointer to an htu31d mux channel structure
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the channel is only selected when the cached one differs
+ */
+uint8_t htu31d_mux_iic_write(void *user_data, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      mux channel iic bus read
+ * @param[in]  *user_data pointer to an htu31d mux channel structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the channel is only selected when the cached one differs
+ */
+uint8_t htu31d_mux_iic_read(void *user_data, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      mux channel iic bus batch read
+ * @param[in]  **user_data pointer to an htu31d mux channel structure array with num entries
+ * @param[in]  *addr pointer to an iic device write address array
+ * @param[in]  num device number, no more than HTU31D_GROUP_BATCH_MAX
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer with num * len bytes
+ * @param[in]  len data length of each device
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       link it as the iic_read_batch_ctx of the channel handles, all channels must use the same mux,
+ *             a select is only queued before a read whose channel differs from the previous one
+ */
+uint8_t htu31d_mux_iic_read_batch(void **user_data, const uint8_t *addr, uint8_t num, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      read the temperature and humidity of the sensors behind one mux
+ * @param[in]  **handle pointer to an htu31d handle pointer array
+ * @param[in]  num sensor number
+ * @param[out] *sample pointer to a sample array with num entries
+ * @param[out] *status pointer to a status array with num entries
+ * @return     status code
+ *             - 0 success
+ *             - 1 some reads failed
+ *             - 2 handle is NULL
+ *             - 3 a handle links neither delay_us nor delay_ms
+ *             - 5 param is error
+ * @note       all handles must use mux channels of the same mux, the conversions are started channel by channel
+ *             beginning with the selected one, then the results are fetched in the reverse channel order,
+ *             so a sweep over c channels costs at most 2 * c - 1 mux writes and the conversions overlap,
+ *             status[i] uses the htu31d_start_conversion and htu31d_fetch_temperature_humidity codes,
+ *             when the handles link iic_read_batch_ctx the results are fetched with htu31d_group_fetch
+ *             in the same order and num must be no more than HTU31D_GROUP_BATCH_MAX,
+ *             the fetch starts after one wait for the longest remaining conversion time
+ */
+uint8_t htu31d_mux_group_read(htu31d_handle_t **handle, uint8_t num, htu31d_sample_t *sample, uint8_t *status);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -35,8 +35,355 @@
  */
 
 #include "driver_htu31d_read_test.h"
+#include <stdlib.h>
+#include <math.h>
 
 static htu31d_handle_t gs_handle;        /**< htu31d handle */
+static uint32_t gs_times;                /**< continuous test times */
+static htu31d_simulator_t *gs_sim;       /**< simulator, NULL uses the iic interface */
+static htu31d_statistics_t gs_stats;     /**< htu31d statistics */
+static htu31d_statistics_t gs_snapshot;  /**< htu31d statistics snapshot */
+
+/**
+ * @brief read test mux definition
+ */
+#define HTU31D_READ_TEST_MUX_CHANNELS        4        /**< 4 channels */
+#define HTU31D_READ_TEST_MUX_SENSORS         8        /**< 2 sensors per channel */
+
+static htu31d_simulator_mux_t gs_sim_mux;                                       /**< simulated mux */
+static htu31d_simulator_t gs_mux_sim[HTU31D_READ_TEST_MUX_SENSORS];             /**< simulators behind the mux */
+static htu31d_mux_t gs_mux;                                                     /**< htu31d mux */
+static htu31d_mux_channel_t gs_mux_channel[HTU31D_READ_TEST_MUX_SENSORS];       /**< htu31d mux channels */
+static htu31d_handle_t gs_mux_handle[HTU31D_READ_TEST_MUX_SENSORS];             /**< htu31d handles behind the mux */
+
+/**
+ * @brief     run the read test against a simulator
+ * @param[in] *sim pointer to a simulator structure, NULL uses the iic interface
+ * @note      the simulator must be inited with the same addr pin as the test
+ */
+void htu31d_read_test_set_simulator(htu31d_simulator_t *sim)
+{
+    gs_sim = sim;
+}
+
+/**
+ * @brief     read test delay
+ * @param[in] ms delay time in ms
+ * @note      the simulator runs in virtual time
+ */
+static void a_htu31d_read_test_delay_ms(uint32_t ms)
+{
+    gs_handle.delay_ms(ms);
+}
+
+/**
+ * @brief     continuous sample callback
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] res sample status
+ * @param[in] *sample pointer to a sample structure
+ * @note      none
+ */
+static void a_htu31d_continuous_callback(htu31d_handle_t *handle, uint8_t res, htu31d_sample_t *sample)
+{
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: continuous sample crc error.\n");
+    }
+    else
+    {
+        htu31d_interface_debug_print("htu31d: raw temperature is 0x%04X, raw humidity is 0x%04X.\n",
+                                     sample->temperature_raw, sample->humidity_raw);
+    }
+    if (gs_times != 0)
+    {
+        gs_times--;
+    }
+    if (gs_times == 0)
+    {
+        (void)htu31d_continuous_stop(handle);
+    }
+}
+
+/**
+ * @brief     check a reading against the simulated environment
+ * @param[in] *temperature_s pointer to a temperature, NULL skips it
+ * @param[in] *humidity_s pointer to a humidity, NULL skips it
+ * @return    status code
+ *            - 0 success
+ *            - 1 the reading is off by more than the simulated noise
+ * @note      the simulator latches the environment at the conversion start, without a simulator it always passes
+ */
+static uint8_t a_htu31d_read_test_check(const float *temperature_s, const float *humidity_s)
+{
+    float temperature;
+    float humidity;
+    
+    if (gs_sim == NULL)
+    {
+        return 0;
+    }
+    
+    htu31d_simulator_get_environment(gs_sim, gs_handle.conversion_start, &temperature, &humidity);
+    if ((temperature_s != NULL) && (fabsf(*temperature_s - temperature) > gs_sim->temperature.noise + 0.01f))
+    {
+        htu31d_interface_debug_print("htu31d: temperature %0.2fC but the simulator has %0.2fC.\n", *temperature_s, temperature);
+        
+        return 1;
+    }
+    if ((humidity_s != NULL) && (fabsf(*humidity_s - humidity) > gs_sim->humidity.noise + 0.01f))
+    {
+        htu31d_interface_debug_print("htu31d: humidity %0.2f%% but the simulator has %0.2f%%.\n", *humidity_s, humidity);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     check a fixed point result against the float conversion
+ * @param[in] temperature_raw raw temperature
+ * @param[in] humidity_raw raw humidity
+ * @param[in] temperature_centi fixed point temperature in 0.01C
+ * @param[in] humidity_centi fixed point humidity in 0.01%
+ * @return    status code
+ *            - 0 success
+ *            - 1 the results differ by more than 0.01
+ * @note      none
+ */
+static uint8_t a_htu31d_read_test_fixed_check(uint16_t temperature_raw, uint16_t humidity_raw,
+                                              int16_t temperature_centi, uint16_t humidity_centi)
+{
+    float temperature_s;
+    float humidity_s;
+    
+    htu31d_convert_batch(1, &temperature_raw, &humidity_raw, &temperature_s, &humidity_s);
+    if ((fabsf((float)temperature_centi / 100.0f - temperature_s) > 0.0101f) ||
+        (fabsf((float)humidity_centi / 100.0f - humidity_s) > 0.0101f))
+    {
+        htu31d_interface_debug_print("htu31d: raw 0x%04X 0x%04X fixed %d %d float %0.4f %0.4f.\n",
+                                     temperature_raw, humidity_raw, temperature_centi, humidity_centi,
+                                     temperature_s, humidity_s);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  check the fixed point conversion over the whole raw range
+ * @return status code
+ *         - 0 success
+ *         - 1 the results differ by more than 0.01
+ * @note   none
+ */
+static uint8_t a_htu31d_read_test_fixed_range(void)
+{
+    uint32_t raw;
+    uint32_t i;
+    uint16_t temperature_raw[256];
+    uint16_t humidity_raw[256];
+    int16_t temperature_centi[256];
+    uint16_t humidity_centi[256];
+    
+    for (raw = 0; raw < 65536; raw += 256)
+    {
+        for (i = 0; i < 256; i++)
+        {
+            temperature_raw[i] = (uint16_t)(raw + i);
+            humidity_raw[i] = (uint16_t)(65535 - raw - i);
+        }
+        htu31d_convert_batch_fixed(256, temperature_raw, humidity_raw, temperature_centi, humidity_centi);
+        for (i = 0; i < 256; i++)
+        {
+            if (a_htu31d_read_test_fixed_check(temperature_raw[i], humidity_raw[i],
+                                               temperature_centi[i], humidity_centi[i]) != 0)
+            {
+                return 1;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     mux read test
+ * @param[in] times sweep times
+ * @param[in] batch 1 fetches the results with one batch transaction per sweep
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      it runs 8 simulated sensors behind 4 channels of a simulated mux
+ */
+static uint8_t a_htu31d_read_test_mux(uint32_t times, uint8_t batch)
+{
+    uint8_t i;
+    uint8_t res;
+    uint8_t status[HTU31D_READ_TEST_MUX_SENSORS];
+    uint32_t t;
+    uint32_t selects;
+    uint32_t batches;
+    uint64_t start;
+    htu31d_humidity_osr_t humidity_osr;
+    htu31d_temperature_osr_t temperature_osr;
+    htu31d_handle_t *handle[HTU31D_READ_TEST_MUX_SENSORS];
+    htu31d_sample_t sample[HTU31D_READ_TEST_MUX_SENSORS];
+    
+    /* link the mux to the simulated bus */
+    htu31d_simulator_mux_init(&gs_sim_mux, HTU31D_MUX_ADDR_BASE);
+    DRIVER_HTU31D_MUX_LINK_INIT(&gs_mux);
+    DRIVER_HTU31D_MUX_LINK_USER_DATA(&gs_mux, &gs_sim_mux);
+    DRIVER_HTU31D_MUX_LINK_IIC_WRITE_CTX(&gs_mux, htu31d_simulator_mux_iic_write);
+    DRIVER_HTU31D_MUX_LINK_IIC_READ_CTX(&gs_mux, htu31d_simulator_mux_iic_read);
+    if (batch != 0)
+    {
+        DRIVER_HTU31D_MUX_LINK_IIC_READ_BATCH_SELECT_CTX(&gs_mux, htu31d_simulator_mux_iic_read_batch_select);
+    }
+    (void)htu31d_mux_set_addr(&gs_mux, HTU31D_MUX_ADDR_BASE);
+    
+    /* init the sensors, the even ones use the low address and the odd ones the high address */
+    for (i = 0; i < HTU31D_READ_TEST_MUX_SENSORS; i++)
+    {
+        htu31d_addr_pin_t addr_pin = ((i % 2) != 0) ? HTU31D_ADDR_PIN_HIGH : HTU31D_ADDR_PIN_LOW;
+        
+        htu31d_simulator_init(&gs_mux_sim[i], addr_pin);
+        gs_mux_sim[i].timestamp_us = htu31d_simulator_clock_timestamp_us;
+        gs_mux_sim[i].temperature.mean = 20.0f + (float)i;
+        (void)htu31d_simulator_mux_attach(&gs_sim_mux, i / 2, &gs_mux_sim[i]);
+        (void)htu31d_mux_channel_init(&gs_mux_channel[i], &gs_mux, i / 2);
+        DRIVER_HTU31D_LINK_INIT(&gs_mux_handle[i], htu31d_handle_t);
+        DRIVER_HTU31D_LINK_IIC_INIT(&gs_mux_handle[i], htu31d_interface_iic_init);
+        DRIVER_HTU31D_LINK_IIC_DEINIT(&gs_mux_handle[i], htu31d_interface_iic_deinit);
+        DRIVER_HTU31D_LINK_IIC_WRITE(&gs_mux_handle[i], htu31d_interface_iic_write);
+        DRIVER_HTU31D_LINK_IIC_READ(&gs_mux_handle[i], htu31d_interface_iic_read);
+        DRIVER_HTU31D_LINK_DELAY_MS(&gs_mux_handle[i], htu31d_simulator_clock_delay_ms);
+        DRIVER_HTU31D_LINK_DELAY_US(&gs_mux_handle[i], htu31d_simulator_clock_delay_us);
+        DRIVER_HTU31D_LINK_TIMESTAMP_US(&gs_mux_handle[i], htu31d_simulator_clock_timestamp_us);
+        DRIVER_HTU31D_LINK_DEBUG_PRINT(&gs_mux_handle[i], htu31d_interface_debug_print);
+        DRIVER_HTU31D_LINK_USER_DATA(&gs_mux_handle[i], &gs_mux_channel[i]);
+        DRIVER_HTU31D_LINK_IIC_INIT_CTX(&gs_mux_handle[i], htu31d_mux_iic_init);
+        DRIVER_HTU31D_LINK_IIC_DEINIT_CTX(&gs_mux_handle[i], htu31d_mux_iic_deinit);
+        DRIVER_HTU31D_LINK_IIC_WRITE_CTX(&gs_mux_handle[i], htu31d_mux_iic_write);
+        DRIVER_HTU31D_LINK_IIC_READ_CTX(&gs_mux_handle[i], htu31d_mux_iic_read);
+        if (batch != 0)
+        {
+            DRIVER_HTU31D_LINK_IIC_READ_BATCH_CTX(&gs_mux_handle[i], htu31d_mux_iic_read_batch);
+        }
+        (void)htu31d_set_addr_pin(&gs_mux_handle[i], addr_pin);
+        handle[i] = &gs_mux_handle[i];
+    }
+    
+    /* init all sensors with one reset wait */
+    start = htu31d_simulator_clock_get_us();
+    res = htu31d_group_init(handle, HTU31D_READ_TEST_MUX_SENSORS, status);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: mux group init failed.\n");
+        (void)htu31d_group_deinit(handle, HTU31D_READ_TEST_MUX_SENSORS, status);
+        
+        return 1;
+    }
+    htu31d_interface_debug_print("htu31d: mux group init of %d sensors took %dus.\n",
+                                 HTU31D_READ_TEST_MUX_SENSORS, (uint32_t)(htu31d_simulator_clock_get_us() - start));
+    
+    /* a handle without delay_us and delay_ms is rejected before any bus access */
+    selects = gs_sim_mux.selects;
+    DRIVER_HTU31D_LINK_DELAY_MS(&gs_mux_handle[0], NULL);
+    DRIVER_HTU31D_LINK_DELAY_US(&gs_mux_handle[0], NULL);
+    res = htu31d_mux_group_read(handle, HTU31D_READ_TEST_MUX_SENSORS, sample, status);
+    DRIVER_HTU31D_LINK_DELAY_MS(&gs_mux_handle[0], htu31d_simulator_clock_delay_ms);
+    DRIVER_HTU31D_LINK_DELAY_US(&gs_mux_handle[0], htu31d_simulator_clock_delay_us);
+    if ((res != 3) || (gs_sim_mux.selects != selects))
+    {
+        htu31d_interface_debug_print("htu31d: mux group read accepted a handle without delay.\n");
+        (void)htu31d_group_deinit(handle, HTU31D_READ_TEST_MUX_SENSORS, status);
+        
+        return 1;
+    }
+    
+    /* sweep */
+    for (t = 0; t < times; t++)
+    {
+        selects = gs_sim_mux.selects;
+        batches = gs_sim_mux.batches;
+        res = htu31d_mux_group_read(handle, HTU31D_READ_TEST_MUX_SENSORS, sample, status);
+        if (res != 0)
+        {
+            htu31d_interface_debug_print("htu31d: mux group read failed.\n");
+            (void)htu31d_group_deinit(handle, HTU31D_READ_TEST_MUX_SENSORS, status);
+            
+            return 1;
+        }
+        if (gs_sim_mux.batches - batches != ((batch != 0) ? 1 : 0))
+        {
+            htu31d_interface_debug_print("htu31d: mux sweep used %d batches.\n", gs_sim_mux.batches - batches);
+            (void)htu31d_group_deinit(handle, HTU31D_READ_TEST_MUX_SENSORS, status);
+            
+            return 1;
+        }
+        htu31d_interface_debug_print("htu31d: mux sweep %d read %d sensors with %d mux writes.\n",
+                                     t + 1, HTU31D_READ_TEST_MUX_SENSORS, gs_sim_mux.selects - selects);
+        if (gs_sim_mux.selects - selects > 2 * (HTU31D_READ_TEST_MUX_SENSORS / 2) - 1)
+        {
+            htu31d_interface_debug_print("htu31d: mux sweep needs no more than %d mux writes.\n",
+                                         2 * (HTU31D_READ_TEST_MUX_SENSORS / 2) - 1);
+            (void)htu31d_group_deinit(handle, HTU31D_READ_TEST_MUX_SENSORS, status);
+            
+            return 1;
+        }
+        for (i = 0; i < HTU31D_READ_TEST_MUX_SENSORS; i++)
+        {
+            htu31d_interface_debug_print("htu31d: channel %d sensor %d temperature is %s%d.%02dC.\n",
+                                         gs_mux_channel[i].channel, i, (sample[i].temperature_centi < 0) ? "-" : "",
+                                         abs(sample[i].temperature_centi) / 100, abs(sample[i].temperature_centi) % 100);
+            if (abs(sample[i].temperature_centi - (2000 + 100 * i)) > 2)
+            {
+                htu31d_interface_debug_print("htu31d: sample of sensor %d belongs to another sensor.\n", i);
+                (void)htu31d_group_deinit(handle, HTU31D_READ_TEST_MUX_SENSORS, status);
+                
+                return 1;
+            }
+        }
+    }
+    
+    /* without timestamp_us one wait must cover the longest conversion */
+    (void)htu31d_get_humidity_osr(&gs_mux_handle[0], &humidity_osr);
+    (void)htu31d_get_temperature_osr(&gs_mux_handle[0], &temperature_osr);
+    (void)htu31d_set_humidity_osr(&gs_mux_handle[0], HTU31D_HUMIDITY_OSR_VERY_HIGH);
+    (void)htu31d_set_temperature_osr(&gs_mux_handle[0], HTU31D_TEMPERATURE_OSR_VERY_HIGH);
+    for (i = 0; i < HTU31D_READ_TEST_MUX_SENSORS; i++)
+    {
+        DRIVER_HTU31D_LINK_TIMESTAMP_US(&gs_mux_handle[i], NULL);
+    }
+    res = htu31d_mux_group_read(handle, HTU31D_READ_TEST_MUX_SENSORS, sample, status);
+    for (i = 0; i < HTU31D_READ_TEST_MUX_SENSORS; i++)
+    {
+        DRIVER_HTU31D_LINK_TIMESTAMP_US(&gs_mux_handle[i], htu31d_simulator_clock_timestamp_us);
+    }
+    (void)htu31d_set_humidity_osr(&gs_mux_handle[0], humidity_osr);
+    (void)htu31d_set_temperature_osr(&gs_mux_handle[0], temperature_osr);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: mux group read without timestamp_us failed.\n");
+        (void)htu31d_group_deinit(handle, HTU31D_READ_TEST_MUX_SENSORS, status);
+        
+        return 1;
+    }
+    htu31d_interface_debug_print("htu31d: mux nacks %d.\n", gs_sim_mux.nacks);
+    
+    /* deinit all sensors with one reset wait */
+    res = htu31d_group_deinit(handle, HTU31D_READ_TEST_MUX_SENSORS, status);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: mux group deinit failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
 
 /**
  * @brief     read test
@@ -51,6 +398,9 @@ uint8_t htu31d_read_test(htu31d_addr_pin_t addr_pin, uint32_t times)
 {
     uint8_t res;
     uint32_t i;
+    uint32_t start;
+    uint32_t resets;
+    uint32_t conversion_time;
     htu31d_info_t info;
     
     /* link functions */
@@ -60,8 +410,29 @@ uint8_t htu31d_read_test(htu31d_addr_pin_t addr_pin, uint32_t times)
     DRIVER_HTU31D_LINK_IIC_WRITE(&gs_handle, htu31d_interface_iic_write);
     DRIVER_HTU31D_LINK_IIC_READ(&gs_handle, htu31d_interface_iic_read);
     DRIVER_HTU31D_LINK_DELAY_MS(&gs_handle, htu31d_interface_delay_ms);
+    DRIVER_HTU31D_LINK_DELAY_US(&gs_handle, htu31d_interface_delay_us);
+    DRIVER_HTU31D_LINK_TIMESTAMP_US(&gs_handle, htu31d_interface_timestamp_us);
     DRIVER_HTU31D_LINK_DEBUG_PRINT(&gs_handle, htu31d_interface_debug_print);
     
+    /* link the simulator */
+    if (gs_sim != NULL)
+    {
+        htu31d_simulator_clock_init(1);
+        gs_sim->timestamp_us = htu31d_simulator_clock_timestamp_us;
+        DRIVER_HTU31D_LINK_DELAY_MS(&gs_handle, htu31d_simulator_clock_delay_ms);
+        DRIVER_HTU31D_LINK_DELAY_US(&gs_handle, htu31d_simulator_clock_delay_us);
+        DRIVER_HTU31D_LINK_TIMESTAMP_US(&gs_handle, htu31d_simulator_clock_timestamp_us);
+        DRIVER_HTU31D_LINK_USER_DATA(&gs_handle, gs_sim);
+        DRIVER_HTU31D_LINK_IIC_INIT_CTX(&gs_handle, htu31d_simulator_iic_init);
+        DRIVER_HTU31D_LINK_IIC_DEINIT_CTX(&gs_handle, htu31d_simulator_iic_deinit);
+        DRIVER_HTU31D_LINK_IIC_WRITE_CTX(&gs_handle, htu31d_simulator_iic_write);
+        DRIVER_HTU31D_LINK_IIC_READ_CTX(&gs_handle, htu31d_simulator_iic_read);
+        htu31d_interface_debug_print("htu31d: use the simulator.\n");
+    }
+    
+    /* enable statistics */
+    (void)htu31d_set_statistics(&gs_handle, &gs_stats);
+    
     /* htu31d info */
     res = htu31d_info(&info);
     if (res != 0)
@@ -157,13 +528,163 @@ uint8_t htu31d_read_test(htu31d_addr_pin_t addr_pin, uint32_t times)
            
             return 1;
         }
+        if (a_htu31d_read_test_check(&temperature_s, &humidity_s) != 0)
+        {
+            (void)htu31d_deinit(&gs_handle);
+           
+            return 1;
+        }
+        
+        /* output */
+        htu31d_interface_debug_print("htu31d: temperature is %0.2fC.\n", temperature_s);
+        htu31d_interface_debug_print("htu31d: humidity is %0.2f%%.\n", humidity_s);
+        
+        /* delay 2000ms */
+        a_htu31d_read_test_delay_ms(2000);
+    }
+    
+    /* output */
+    htu31d_interface_debug_print("htu31d: start conversion and fetch test.\n");
+    
+    for (i = 0; i < times; i++)
+    {
+        uint16_t temperature_raw;
+        float temperature_s;
+        uint16_t humidity_raw;
+        float humidity_s;
+        uint8_t ready;
+        
+        /* start conversion */
+        res = htu31d_start_conversion(&gs_handle);
+        if (res != 0)
+        {
+            htu31d_interface_debug_print("htu31d: start conversion failed.\n");
+            (void)htu31d_deinit(&gs_handle);
+           
+            return 1;
+        }
+        
+        /* poll the deadline */
+        do
+        {
+            res = htu31d_is_conversion_ready(&gs_handle, &ready);
+            if (res != 0)
+            {
+                htu31d_interface_debug_print("htu31d: check conversion ready failed.\n");
+                (void)htu31d_deinit(&gs_handle);
+               
+                return 1;
+            }
+        } while (ready == 0);
+        
+        /* fetch the result */
+        res = htu31d_fetch_temperature_humidity(&gs_handle,
+                                                &temperature_raw, &temperature_s,
+                                                &humidity_raw, &humidity_s
+                                               );
+        if (res != 0)
+        {
+            htu31d_interface_debug_print("htu31d: fetch temperature humidity failed.\n");
+            (void)htu31d_deinit(&gs_handle);
+           
+            return 1;
+        }
+        if (a_htu31d_read_test_check(&temperature_s, &humidity_s) != 0)
+        {
+            (void)htu31d_deinit(&gs_handle);
+           
+            return 1;
+        }
         
         /* output */
         htu31d_interface_debug_print("htu31d: temperature is %0.2fC.\n", temperature_s);
         htu31d_interface_debug_print("htu31d: humidity is %0.2f%%.\n", humidity_s);
         
         /* delay 2000ms */
-        htu31d_interface_delay_ms(2000);
+        a_htu31d_read_test_delay_ms(2000);
+    }
+    
+    /* output */
+    htu31d_interface_debug_print("htu31d: read fixed point test.\n");
+    
+    /* the fixed point conversion matches the float one within 0.01 over the raw range */
+    if (a_htu31d_read_test_fixed_range() != 0)
+    {
+        htu31d_interface_debug_print("htu31d: fixed point conversion differs from float.\n");
+        (void)htu31d_deinit(&gs_handle);
+       
+        return 1;
+    }
+    
+    for (i = 0; i < times; i++)
+    {
+        uint16_t temperature_raw;
+        int16_t temperature_centi;
+        float temperature_s;
+        uint16_t humidity_raw;
+        uint16_t humidity_centi;
+        float humidity_s;
+        
+        res = htu31d_read_temperature_humidity_fixed(&gs_handle,
+                                                     &temperature_raw, &temperature_centi,
+                                                     &humidity_raw, &humidity_centi
+                                                    );
+        if (res != 0)
+        {
+            htu31d_interface_debug_print("htu31d: read temperature humidity fixed failed.\n");
+            (void)htu31d_deinit(&gs_handle);
+           
+            return 1;
+        }
+        if (a_htu31d_read_test_fixed_check(temperature_raw, humidity_raw, temperature_centi, humidity_centi) != 0)
+        {
+            htu31d_interface_debug_print("htu31d: fixed point sample differs from float.\n");
+            (void)htu31d_deinit(&gs_handle);
+           
+            return 1;
+        }
+        temperature_s = (float)temperature_centi / 100.0f;
+        humidity_s = (float)humidity_centi / 100.0f;
+        if (a_htu31d_read_test_check(&temperature_s, &humidity_s) != 0)
+        {
+            (void)htu31d_deinit(&gs_handle);
+           
+            return 1;
+        }
+        
+        /* output */
+        htu31d_interface_debug_print("htu31d: temperature is %s%d.%02dC.\n", (temperature_centi < 0) ? "-" : "",
+                                     abs(temperature_centi) / 100, abs(temperature_centi) % 100);
+        htu31d_interface_debug_print("htu31d: humidity is %d.%02d%%.\n", humidity_centi / 100, humidity_centi % 100);
+        
+        /* delay 2000ms */
+        a_htu31d_read_test_delay_ms(2000);
+    }
+    
+    /* injected crc errors are reported and counted */
+    if (gs_sim != NULL)
+    {
+        uint16_t temperature_raw;
+        float temperature_s;
+        uint16_t humidity_raw;
+        float humidity_s;
+        uint32_t crc_error;
+        
+        htu31d_interface_debug_print("htu31d: crc error test.\n");
+        crc_error = gs_stats.crc_error[HTU31D_STATISTICS_COMMAND_T_RH];
+        gs_sim->crc_error_period = 1;
+        res = htu31d_read_temperature_humidity(&gs_handle,
+                                               &temperature_raw, &temperature_s,
+                                               &humidity_raw, &humidity_s
+                                              );
+        gs_sim->crc_error_period = 0;
+        if ((res != 4) || (gs_stats.crc_error[HTU31D_STATISTICS_COMMAND_T_RH] != crc_error + 1))
+        {
+            htu31d_interface_debug_print("htu31d: crc error is not reported.\n");
+            (void)htu31d_deinit(&gs_handle);
+           
+            return 1;
+        }
     }
     
     /* set low */
@@ -176,11 +697,27 @@ uint8_t htu31d_read_test(htu31d_addr_pin_t addr_pin, uint32_t times)
         return 1;
     }
     
-    /* set low */
-    res = htu31d_set_temperature_osr(&gs_handle, HTU31D_TEMPERATURE_OSR_LOW);
+    /* read once without humidity priority, the very high temperature osr is converted too */
+    {
+        uint16_t humidity_raw;
+        float humidity_s;
+        
+        res = htu31d_read_humidity(&gs_handle, &humidity_raw, &humidity_s);
+        if (res != 0)
+        {
+            htu31d_interface_debug_print("htu31d: read humidity failed.\n");
+            (void)htu31d_deinit(&gs_handle);
+           
+            return 1;
+        }
+        conversion_time = gs_handle.conversion_time;
+    }
+    
+    /* enable humidity priority */
+    res = htu31d_set_humidity_priority(&gs_handle, HTU31D_BOOL_TRUE);
     if (res != 0)
     {
-        htu31d_interface_debug_print("htu31d: set temperature osr failed.\n");
+        htu31d_interface_debug_print("htu31d: set humidity priority failed.\n");
         (void)htu31d_deinit(&gs_handle);
        
         return 1;
@@ -188,7 +725,8 @@ uint8_t htu31d_read_test(htu31d_addr_pin_t addr_pin, uint32_t times)
     
     /* output */
     htu31d_interface_debug_print("htu31d: set humidity osr low.\n");
-    htu31d_interface_debug_print("htu31d: set temperature osr low.\n");
+    htu31d_interface_debug_print("htu31d: keep temperature osr very high.\n");
+    htu31d_interface_debug_print("htu31d: enable humidity priority.\n");
     
     for (i = 0; i < times; i++)
     {
@@ -204,11 +742,213 @@ uint8_t htu31d_read_test(htu31d_addr_pin_t addr_pin, uint32_t times)
             return 1;
         }
         
+        /* the priority conversion skips the long temperature part */
+        if ((gs_handle.conversion_time >= conversion_time) ||
+            ((gs_sim != NULL) && (gs_sim->conversion_time != gs_handle.conversion_time)))
+        {
+            htu31d_interface_debug_print("htu31d: humidity priority conversion takes %dus, %dus without it.\n",
+                                         gs_handle.conversion_time, conversion_time);
+            (void)htu31d_deinit(&gs_handle);
+           
+            return 1;
+        }
+        if (a_htu31d_read_test_check(NULL, &humidity_s) != 0)
+        {
+            (void)htu31d_deinit(&gs_handle);
+           
+            return 1;
+        }
+        
         /* output */
         htu31d_interface_debug_print("htu31d: humidity is %0.2f%%.\n", humidity_s);
         
         /* delay 2000ms */
-        htu31d_interface_delay_ms(2000);
+        a_htu31d_read_test_delay_ms(2000);
+    }
+    
+    /* output */
+    htu31d_interface_debug_print("htu31d: read temperature test.\n");
+    
+    for (i = 0; i < times; i++)
+    {
+        uint16_t temperature_raw;
+        float temperature_s;
+        
+        res = htu31d_read_temperature(&gs_handle, &temperature_raw, &temperature_s);
+        if (res != 0)
+        {
+            htu31d_interface_debug_print("htu31d: read temperature failed.\n");
+            (void)htu31d_deinit(&gs_handle);
+           
+            return 1;
+        }
+        if (a_htu31d_read_test_check(&temperature_s, NULL) != 0)
+        {
+            (void)htu31d_deinit(&gs_handle);
+           
+            return 1;
+        }
+        
+        /* output */
+        htu31d_interface_debug_print("htu31d: temperature is %0.2fC.\n", temperature_s);
+        
+        /* delay 2000ms */
+        a_htu31d_read_test_delay_ms(2000);
+    }
+    
+    /* output */
+    htu31d_interface_debug_print("htu31d: continuous read test.\n");
+    
+    /* run the continuous loop */
+    gs_times = times;
+    res = htu31d_continuous_start(&gs_handle, 1000000, a_htu31d_continuous_callback);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: continuous read failed.\n");
+        (void)htu31d_deinit(&gs_handle);
+       
+        return 1;
+    }
+    
+    /* output */
+    htu31d_interface_debug_print("htu31d: read batch test.\n");
+    
+    /* read batch */
+    if (times > 0)
+    {
+        uint16_t temperature_raw[8];
+        uint16_t humidity_raw[8];
+        int16_t temperature_centi[8];
+        uint16_t humidity_centi[8];
+        uint64_t ts[8];
+        uint32_t num;
+        uint32_t (*timestamp_us)(void);
+        
+        num = (times > 8) ? 8 : times;
+        res = htu31d_read_batch(&gs_handle, num, 100000, temperature_raw, humidity_raw, ts);
+        if (res != 0)
+        {
+            htu31d_interface_debug_print("htu31d: read batch failed.\n");
+            (void)htu31d_deinit(&gs_handle);
+           
+            return 1;
+        }
+        htu31d_convert_batch_fixed(num, temperature_raw, humidity_raw, temperature_centi, humidity_centi);
+        for (i = 0; i < num; i++)
+        {
+            htu31d_interface_debug_print("htu31d: +%dus temperature is %s%d.%02dC, humidity is %d.%02d%%.\n",
+                                         (uint32_t)(ts[i] - ts[0]), (temperature_centi[i] < 0) ? "-" : "",
+                                         abs(temperature_centi[i]) / 100, abs(temperature_centi[i]) % 100,
+                                         humidity_centi[i] / 100, humidity_centi[i] % 100);
+        }
+        
+        /* ts without timestamp_us is a param error */
+        timestamp_us = gs_handle.timestamp_us;
+        DRIVER_HTU31D_LINK_TIMESTAMP_US(&gs_handle, NULL);
+        res = htu31d_read_batch(&gs_handle, num, 100000, temperature_raw, humidity_raw, ts);
+        DRIVER_HTU31D_LINK_TIMESTAMP_US(&gs_handle, timestamp_us);
+        if (res != 5)
+        {
+            htu31d_interface_debug_print("htu31d: read batch accepted ts without timestamp_us.\n");
+            (void)htu31d_deinit(&gs_handle);
+           
+            return 1;
+        }
+    }
+    
+    /* warm restart */
+    htu31d_interface_debug_print("htu31d: warm restart test.\n");
+    res = htu31d_deinit(&gs_handle);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: deinit failed.\n");
+       
+        return 1;
+    }
+    res = htu31d_set_init_mode(&gs_handle, HTU31D_INIT_MODE_WARM);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: set init mode failed.\n");
+       
+        return 1;
+    }
+    resets = (gs_sim != NULL) ? gs_sim->resets : 0;
+    start = gs_handle.timestamp_us();
+    res = htu31d_init(&gs_handle);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: init failed.\n");
+       
+        return 1;
+    }
+    htu31d_interface_debug_print("htu31d: warm init took %dus.\n", gs_handle.timestamp_us() - start);
+    if ((gs_sim != NULL) && (gs_sim->resets != resets))
+    {
+        htu31d_interface_debug_print("htu31d: warm init reset a healthy sensor.\n");
+        (void)htu31d_deinit(&gs_handle);
+       
+        return 1;
+    }
+    res = htu31d_set_init_mode(&gs_handle, HTU31D_INIT_MODE_COLD);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: set init mode failed.\n");
+        (void)htu31d_deinit(&gs_handle);
+       
+        return 1;
+    }
+    
+    /* read behind a mux */
+    if ((gs_sim != NULL) && (times > 0))
+    {
+        htu31d_interface_debug_print("htu31d: mux read test.\n");
+        res = a_htu31d_read_test_mux((times > 3) ? 3 : times, 0);
+        if (res != 0)
+        {
+            (void)htu31d_deinit(&gs_handle);
+           
+            return 1;
+        }
+        
+        htu31d_interface_debug_print("htu31d: mux batch read test.\n");
+        res = a_htu31d_read_test_mux((times > 3) ? 3 : times, 1);
+        if (res != 0)
+        {
+            (void)htu31d_deinit(&gs_handle);
+           
+            return 1;
+        }
+    }
+    
+    /* output the virtual time */
+    if (gs_sim != NULL)
+    {
+        htu31d_interface_debug_print("htu31d: simulated %d conversions in %d s of virtual time.\n",
+                                     gs_sim->conversions, (uint32_t)(htu31d_simulator_clock_get_us() / 1000000));
+    }
+    
+    /* output the statistics */
+    res = htu31d_get_statistics(&gs_handle, &gs_snapshot, HTU31D_BOOL_TRUE);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: get statistics failed.\n");
+        (void)htu31d_deinit(&gs_handle);
+       
+        return 1;
+    }
+    htu31d_interface_debug_print("htu31d: %d writes, %d reads, %d bytes, %d bus failures.\n",
+                                 gs_snapshot.write_count, gs_snapshot.read_count,
+                                 gs_snapshot.write_bytes + gs_snapshot.read_bytes,
+                                 gs_snapshot.write_failed + gs_snapshot.read_failed);
+    htu31d_interface_debug_print("htu31d: %d t && rh crc errors, %d conversion waits.\n",
+                                 gs_snapshot.crc_error[HTU31D_STATISTICS_COMMAND_T_RH], gs_snapshot.wait_count);
+    res = htu31d_get_statistics(&gs_handle, &gs_snapshot, HTU31D_BOOL_FALSE);
+    if ((res != 0) || (gs_snapshot.write_count != 0) || (gs_snapshot.read_count != 0) || (gs_snapshot.wait_us != 0))
+    {
+        htu31d_interface_debug_print("htu31d: statistics reset failed.\n");
+        (void)htu31d_deinit(&gs_handle);
+       
+        return 1;
     }
     
     /* finish read test */
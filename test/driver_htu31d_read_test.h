@@ -38,6 +38,7 @@
 #define DRIVER_HTU31D_READ_TEST_H
 
 #include "driver_htu31d_interface.h"
+#include "driver_htu31d_simulator.h"
 
 #ifdef __cplusplus
 extern "C"{
@@ -59,6 +60,13 @@ extern "C"{
  */
 uint8_t htu31d_read_test(htu31d_addr_pin_t addr_pin, uint32_t times);
 
+/**
+ * @brief     run the read test against a simulator
+ * @param[in] *sim pointer to a simulator structure, NULL uses the iic interface
+ * @note      the simulator must be inited with the same addr pin as the test
+ */
+void htu31d_read_test_set_simulator(htu31d_simulator_t *sim);
+
 /**
  * @}
  */
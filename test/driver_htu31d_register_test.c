@@ -53,6 +53,8 @@ uint8_t htu31d_register_test(htu31d_addr_pin_t addr_pin)
     htu31d_humidity_osr_t humi_osr;
     htu31d_temperature_osr_t temp_osr;
     htu31d_addr_pin_t addr_pin_check;
+    htu31d_init_mode_t init_mode_check;
+    htu31d_bool_t enable;
     uint8_t diagnostic;
     uint8_t number[3];
     
@@ -63,6 +65,8 @@ uint8_t htu31d_register_test(htu31d_addr_pin_t addr_pin)
     DRIVER_HTU31D_LINK_IIC_WRITE(&gs_handle, htu31d_interface_iic_write);
     DRIVER_HTU31D_LINK_IIC_READ(&gs_handle, htu31d_interface_iic_read);
     DRIVER_HTU31D_LINK_DELAY_MS(&gs_handle, htu31d_interface_delay_ms);
+    DRIVER_HTU31D_LINK_DELAY_US(&gs_handle, htu31d_interface_delay_us);
+    DRIVER_HTU31D_LINK_TIMESTAMP_US(&gs_handle, htu31d_interface_timestamp_us);
     DRIVER_HTU31D_LINK_DEBUG_PRINT(&gs_handle, htu31d_interface_debug_print);
     
     /* htu31d info */
@@ -129,6 +133,45 @@ uint8_t htu31d_register_test(htu31d_addr_pin_t addr_pin)
     }
     htu31d_interface_debug_print("htu31d: check addr pin %s.\n", (HTU31D_ADDR_PIN_HIGH == addr_pin_check) ? "ok" : "error");
     
+    /* htu31d_set_init_mode/htu31d_get_init_mode test */
+    htu31d_interface_debug_print("htu31d: htu31d_set_init_mode/htu31d_get_init_mode test.\n");
+    
+    /* set init mode warm */
+    res = htu31d_set_init_mode(&gs_handle, HTU31D_INIT_MODE_WARM);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: set init mode failed.\n");
+       
+        return 1;
+    }
+    htu31d_interface_debug_print("htu31d: set init mode warm.\n");
+    res = htu31d_get_init_mode(&gs_handle, &init_mode_check);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: get init mode failed.\n");
+       
+        return 1;
+    }
+    htu31d_interface_debug_print("htu31d: check init mode %s.\n", (HTU31D_INIT_MODE_WARM == init_mode_check) ? "ok" : "error");
+    
+    /* set init mode cold */
+    res = htu31d_set_init_mode(&gs_handle, HTU31D_INIT_MODE_COLD);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: set init mode failed.\n");
+       
+        return 1;
+    }
+    htu31d_interface_debug_print("htu31d: set init mode cold.\n");
+    res = htu31d_get_init_mode(&gs_handle, &init_mode_check);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: get init mode failed.\n");
+       
+        return 1;
+    }
+    htu31d_interface_debug_print("htu31d: check init mode %s.\n", (HTU31D_INIT_MODE_COLD == init_mode_check) ? "ok" : "error");
+    
     /* set addr pin */
     res = htu31d_set_addr_pin(&gs_handle, addr_pin);
     if (res != 0)
@@ -313,6 +356,49 @@ uint8_t htu31d_register_test(htu31d_addr_pin_t addr_pin)
     }
     htu31d_interface_debug_print("htu31d: check temperature osr %s.\n", (HTU31D_TEMPERATURE_OSR_LOW == temp_osr) ? "ok" : "error");
     
+    /* htu31d_set_humidity_priority/htu31d_get_humidity_priority test */
+    htu31d_interface_debug_print("htu31d: htu31d_set_humidity_priority/htu31d_get_humidity_priority test.\n");
+    
+    /* enable humidity priority */
+    res = htu31d_set_humidity_priority(&gs_handle, HTU31D_BOOL_TRUE);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: set humidity priority failed.\n");
+        (void)htu31d_deinit(&gs_handle);
+        
+        return 1;
+    }
+    htu31d_interface_debug_print("htu31d: enable humidity priority.\n");
+    res = htu31d_get_humidity_priority(&gs_handle, &enable);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: get humidity priority failed.\n");
+        (void)htu31d_deinit(&gs_handle);
+        
+        return 1;
+    }
+    htu31d_interface_debug_print("htu31d: check humidity priority %s.\n", (HTU31D_BOOL_TRUE == enable) ? "ok" : "error");
+    
+    /* disable humidity priority */
+    res = htu31d_set_humidity_priority(&gs_handle, HTU31D_BOOL_FALSE);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: set humidity priority failed.\n");
+        (void)htu31d_deinit(&gs_handle);
+        
+        return 1;
+    }
+    htu31d_interface_debug_print("htu31d: disable humidity priority.\n");
+    res = htu31d_get_humidity_priority(&gs_handle, &enable);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: get humidity priority failed.\n");
+        (void)htu31d_deinit(&gs_handle);
+        
+        return 1;
+    }
+    htu31d_interface_debug_print("htu31d: check humidity priority %s.\n", (HTU31D_BOOL_FALSE == enable) ? "ok" : "error");
+    
     /* htu31d_set_heater_on test */
     htu31d_interface_debug_print("htu31d: htu31d_set_heater_on test.\n");
     
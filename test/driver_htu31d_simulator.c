@@ -0,0 +1,682 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_htu31d_simulator.c
+ * @brief     driver htu31d simulator source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_htu31d_simulator.h"
+#include <math.h>
+
+/**
+ * @brief command definition
+ */
+#define HTU31D_SIMULATOR_CONVERSION              (0x1 << 6)        /**< conversion command */
+#define HTU31D_SIMULATOR_READ_T_RH               (0x00)            /**< read t && rh command */
+#define HTU31D_SIMULATOR_READ_RH                 (0x1 << 4)        /**< read rh command */
+#define HTU31D_SIMULATOR_RESET                   (0x1E)            /**< reset command */
+#define HTU31D_SIMULATOR_HEATER_ON               (0x1 << 2)        /**< heater on command */
+#define HTU31D_SIMULATOR_HEATER_OFF              (0x1 << 1)        /**< heater off command */
+#define HTU31D_SIMULATOR_READ_SERIAL_NUMBER      (0x0A)            /**< read serial number command */
+#define HTU31D_SIMULATOR_READ_DIAGNOSTIC         (1 << 3)          /**< read diagnostic command */
+
+/**
+ * @brief datasheet conversion time table in us
+ */
+static const uint16_t gsc_htu31d_simulator_humidity_time_us[4] = {1000, 2000, 3900, 7800};            /**< rh conversion time */
+static const uint16_t gsc_htu31d_simulator_temperature_time_us[4] = {1600, 3100, 6100, 12100};        /**< t conversion time */
+
+/**
+ * @brief virtual clock definition
+ */
+static uint64_t gs_htu31d_simulator_clock_us;              /**< virtual time in us */
+static uint32_t gs_htu31d_simulator_clock_tick_us;         /**< time added by every timestamp read */
+
+/**
+ * @brief     crc8
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    crc
+ * @note      none
+ */
+static uint8_t a_htu31d_simulator_crc(const uint8_t *buf, uint8_t len)
+{
+    uint8_t crc = 0x00;
+    uint8_t i;
+    uint8_t j;
+    
+    for (i = 0; i < len; i++)                                   /* run len times */
+    {
+        crc ^= buf[i];                                          /* xor data */
+        for (j = 0; j < 8; j++)                                 /* run 8 times */
+        {
+            if ((crc & 0x80) != 0)                              /* check msb */
+            {
+                crc = (uint8_t)((crc << 1) ^ 0x31);             /* shift and xor poly */
+            }
+            else
+            {
+                crc = (uint8_t)(crc << 1);                      /* shift */
+            }
+        }
+    }
+    
+    return crc;                                                 /* return crc */
+}
+
+/**
+ * @brief         get a noise value
+ * @param[in,out] *sim pointer to a simulator structure
+ * @param[in]     peak peak noise
+ * @return        noise in [-peak, peak]
+ * @note          xorshift32 generator
+ */
+static float a_htu31d_simulator_noise(htu31d_simulator_t *sim, float peak)
+{
+    uint32_t x;
+    
+    if (peak == 0.0f)                                           /* check peak */
+    {
+        return 0.0f;                                            /* no noise */
+    }
+    x = sim->seed;                                              /* get the state */
+    x ^= x << 13;                                               /* xorshift */
+    x ^= x >> 17;                                               /* xorshift */
+    x ^= x << 5;                                                /* xorshift */
+    sim->seed = x;                                              /* save the state */
+    
+    return ((float)(x >> 8) / 8388607.5f - 1.0f) * peak;        /* map 24 bits to [-peak, peak] */
+}
+
+/**
+ * @brief     get a waveform value
+ * @param[in] *wave pointer to a waveform structure
+ * @param[in] time_us sample time in us
+ * @return    value
+ * @note      none
+ */
+static float a_htu31d_simulator_waveform(const htu31d_simulator_waveform_t *wave, uint32_t time_us)
+{
+    if ((wave->period_s <= 0.0f) || (wave->amplitude == 0.0f))                      /* check constant */
+    {
+        return wave->mean;                                                          /* return mean */
+    }
+    
+    return wave->mean + wave->amplitude *
+           (float)sin(2.0 * 3.14159265358979 * ((double)time_us / 1000000.0) / (double)wave->period_s);
+}
+
+/**
+ * @brief         latch a conversion result
+ * @param[in,out] *sim pointer to a simulator structure
+ * @param[in]     time_us sample time in us
+ * @note          none
+ */
+static void a_htu31d_simulator_convert(htu31d_simulator_t *sim, uint32_t time_us)
+{
+    float t;
+    float rh;
+    uint16_t t_raw;
+    uint16_t rh_raw;
+    
+    htu31d_simulator_get_environment(sim, time_us, &t, &rh);                        /* get the environment */
+    t += a_htu31d_simulator_noise(sim, sim->temperature.noise);                     /* add temperature noise */
+    rh += a_htu31d_simulator_noise(sim, sim->humidity.noise);                       /* add humidity noise */
+    sim->diagnostic &= HTU31D_DIAGNOSTIC_HEATER_ON;                                 /* clear range errors */
+    if ((t < -40.0f) || (t > 125.0f))                                               /* check temperature range */
+    {
+        sim->diagnostic |= HTU31D_DIAGNOSTIC_TEMPERATURE_UNDER_OVERRUN;             /* set under/overrun */
+        t = (t < -40.0f) ? -40.0f : 125.0f;                                         /* clamp */
+    }
+    if ((rh < 0.0f) || (rh > 100.0f))                                               /* check humidity range */
+    {
+        sim->diagnostic |= HTU31D_DIAGNOSTIC_HUMIDITY_UNDER_OVERRUN;                /* set under/overrun */
+        rh = (rh < 0.0f) ? 0.0f : 100.0f;                                           /* clamp */
+    }
+    t_raw = (uint16_t)((t + 40.0f) / 165.0f * 65535.0f + 0.5f);                     /* convert temperature */
+    rh_raw = (uint16_t)(rh / 100.0f * 65535.0f + 0.5f);                             /* convert humidity */
+    sim->frame[0] = (uint8_t)(t_raw >> 8);                                          /* set temperature msb */
+    sim->frame[1] = (uint8_t)(t_raw >> 0);                                          /* set temperature lsb */
+    sim->frame[2] = a_htu31d_simulator_crc(&sim->frame[0], 2);                      /* set temperature crc */
+    sim->frame[3] = (uint8_t)(rh_raw >> 8);                                         /* set humidity msb */
+    sim->frame[4] = (uint8_t)(rh_raw >> 0);                                         /* set humidity lsb */
+    sim->frame[5] = a_htu31d_simulator_crc(&sim->frame[3], 2);                      /* set humidity crc */
+}
+
+/**
+ * @brief         check the conversion status
+ * @param[in,out] *sim pointer to a simulator structure
+ * @return        1 if a conversion is still running
+ * @note          none
+ */
+static uint8_t a_htu31d_simulator_busy(htu31d_simulator_t *sim)
+{
+    if (sim->converting == 0)                                                       /* check converting */
+    {
+        return 0;                                                                   /* idle */
+    }
+    if ((sim->timestamp_us != NULL) &&
+        ((uint32_t)(sim->timestamp_us() - sim->conversion_start) < sim->conversion_time))  /* check the elapsed time */
+    {
+        return 1;                                                                   /* busy */
+    }
+    sim->converting = 0;                                                            /* conversion done */
+    
+    return 0;                                                                       /* idle */
+}
+
+/**
+ * @brief     reset the virtual clock to 0
+ * @param[in] tick_us time added by every timestamp read
+ * @note      a non-zero tick lets polling loops make progress
+ */
+void htu31d_simulator_clock_init(uint32_t tick_us)
+{
+    gs_htu31d_simulator_clock_us = 0;                                               /* reset the time */
+    gs_htu31d_simulator_clock_tick_us = tick_us;                                    /* set the tick */
+}
+
+/**
+ * @brief     advance the virtual clock
+ * @param[in] us advanced time in us
+ * @note      none
+ */
+void htu31d_simulator_clock_advance(uint32_t us)
+{
+    gs_htu31d_simulator_clock_us += us;                                             /* advance the time */
+}
+
+/**
+ * @brief  get the virtual clock time
+ * @return time in us since htu31d_simulator_clock_init
+ * @note   it does not wrap like htu31d_simulator_clock_timestamp_us
+ */
+uint64_t htu31d_simulator_clock_get_us(void)
+{
+    return gs_htu31d_simulator_clock_us;                                            /* return the time */
+}
+
+/**
+ * @brief     virtual clock delay ms
+ * @param[in] ms delay time in ms
+ * @note      the clock advances instantly
+ */
+void htu31d_simulator_clock_delay_ms(uint32_t ms)
+{
+    gs_htu31d_simulator_clock_us += (uint64_t)ms * 1000;                            /* advance the time */
+}
+
+/**
+ * @brief     virtual clock delay us
+ * @param[in] us delay time in us
+ * @note      the clock advances instantly
+ */
+void htu31d_simulator_clock_delay_us(uint32_t us)
+{
+    gs_htu31d_simulator_clock_us += us;                                             /* advance the time */
+}
+
+/**
+ * @brief  virtual clock timestamp
+ * @return timestamp in us
+ * @note   none
+ */
+uint32_t htu31d_simulator_clock_timestamp_us(void)
+{
+    gs_htu31d_simulator_clock_us += gs_htu31d_simulator_clock_tick_us;              /* add the tick */
+    
+    return (uint32_t)gs_htu31d_simulator_clock_us;                                  /* return the timestamp */
+}
+
+/**
+ * @brief     init the simulator with a constant 25C 50% environment
+ * @param[in] *sim pointer to a simulator structure
+ * @param[in] addr_pin addr pin
+ * @note      conversions complete immediately unless timestamp_us is set
+ */
+void htu31d_simulator_init(htu31d_simulator_t *sim, htu31d_addr_pin_t addr_pin)
+{
+    memset(sim, 0, sizeof(htu31d_simulator_t));                                     /* clear the simulator */
+    sim->iic_addr = (uint8_t)addr_pin;                                              /* set the address */
+    sim->serial_number[0] = 0x12;                                                   /* set serial number */
+    sim->serial_number[1] = 0x34;                                                   /* set serial number */
+    sim->serial_number[2] = 0x56;                                                   /* set serial number */
+    sim->temperature.mean = 25.0f;                                                  /* 25C */
+    sim->humidity.mean = 50.0f;                                                     /* 50% */
+    sim->seed = 0x2545F491U;                                                        /* noise seed */
+    a_htu31d_simulator_convert(sim, 0);                                             /* power on result */
+}
+
+/**
+ * @brief      get the environment value the simulator would convert
+ * @param[in]  *sim pointer to a simulator structure
+ * @param[in]  time_us sample time in us
+ * @param[out] *temperature pointer to a temperature buffer
+ * @param[out] *humidity pointer to a humidity buffer
+ * @note       noise is not included
+ */
+void htu31d_simulator_get_environment(htu31d_simulator_t *sim, uint32_t time_us, float *temperature, float *humidity)
+{
+    *temperature = a_htu31d_simulator_waveform(&sim->temperature, time_us);        /* get temperature */
+    *humidity = a_htu31d_simulator_waveform(&sim->humidity, time_us);              /* get humidity */
+}
+
+/**
+ * @brief     simulator iic bus init
+ * @param[in] *user_data pointer to a simulator structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t htu31d_simulator_iic_init(void *user_data)
+{
+    (void)user_data;
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     simulator iic bus deinit
+ * @param[in] *user_data pointer to a simulator structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t htu31d_simulator_iic_deinit(void *user_data)
+{
+    (void)user_data;
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     simulator iic bus write
+ * @param[in] *user_data pointer to a simulator structure
+ * @param[in] addr iic device write address
+ * @param[in] reg iic command
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write nacked
+ * @note      none
+ */
+uint8_t htu31d_simulator_iic_write(void *user_data, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    htu31d_simulator_t *sim = (htu31d_simulator_t *)user_data;
+    uint8_t hosr;
+    uint8_t tosr;
+    uint32_t now;
+    
+    (void)buf;
+    sim->writes++;                                                                  /* count the write */
+    if ((addr != sim->iic_addr) || (len != 0))                                      /* check the address and length */
+    {
+        sim->bus_nacks++;                                                           /* count the nack */
+        
+        return 1;                                                                   /* return error */
+    }
+    now = (sim->timestamp_us != NULL) ? sim->timestamp_us() : 0;                    /* get the time */
+    if ((reg & 0xC0) == HTU31D_SIMULATOR_CONVERSION)                                /* conversion */
+    {
+        hosr = (reg >> 3) & 0x03;                                                   /* get humidity osr */
+        tosr = (reg >> 1) & 0x03;                                                   /* get temperature osr */
+        sim->converting = 1;                                                        /* set converting */
+        sim->conversion_start = now;                                                /* save the start time */
+        sim->conversion_time = (uint32_t)gsc_htu31d_simulator_humidity_time_us[hosr] +
+                               gsc_htu31d_simulator_temperature_time_us[tosr];      /* set the conversion time */
+        sim->conversions++;                                                         /* count the conversion */
+        a_htu31d_simulator_convert(sim, now);                                       /* latch the result */
+    }
+    else if (reg == HTU31D_SIMULATOR_RESET)                                         /* reset */
+    {
+        sim->heater = 0;                                                            /* heater off */
+        sim->diagnostic = 0;                                                        /* clear diagnostic */
+        sim->converting = 0;                                                        /* stop conversion */
+        sim->resets++;                                                              /* count the reset */
+    }
+    else if (reg == HTU31D_SIMULATOR_HEATER_ON)                                     /* heater on */
+    {
+        sim->heater = 1;                                                            /* heater on */
+        sim->diagnostic |= HTU31D_DIAGNOSTIC_HEATER_ON;                             /* set the diagnostic bit */
+    }
+    else if (reg == HTU31D_SIMULATOR_HEATER_OFF)                                    /* heater off */
+    {
+        sim->heater = 0;                                                            /* heater off */
+        sim->diagnostic &= (uint8_t)(~HTU31D_DIAGNOSTIC_HEATER_ON);                 /* clear the diagnostic bit */
+    }
+    else
+    {
+        sim->bus_nacks++;                                                           /* count the nack */
+        
+        return 1;                                                                   /* return error */
+    }
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      simulator iic bus read
+ * @param[in]  *user_data pointer to a simulator structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic command
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read nacked
+ * @note       a data read during a conversion is nacked
+ */
+uint8_t htu31d_simulator_iic_read(void *user_data, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    htu31d_simulator_t *sim = (htu31d_simulator_t *)user_data;
+    uint8_t data[6];
+    uint8_t size;
+    
+    sim->reads++;                                                                   /* count the read */
+    if (addr != sim->iic_addr)                                                      /* check the address */
+    {
+        sim->bus_nacks++;                                                           /* count the nack */
+        
+        return 1;                                                                   /* return error */
+    }
+    if (sim->nack_next != 0)                                                        /* check nack injection */
+    {
+        sim->nack_next--;                                                           /* use the injection */
+        sim->bus_nacks++;                                                           /* count the nack */
+        
+        return 1;                                                                   /* return error */
+    }
+    if ((reg == HTU31D_SIMULATOR_READ_T_RH) || (reg == HTU31D_SIMULATOR_READ_RH))   /* data read */
+    {
+        if (a_htu31d_simulator_busy(sim) != 0)                                      /* check busy */
+        {
+            sim->busy_nacks++;                                                      /* count the nack */
+            
+            return 1;                                                               /* return error */
+        }
+        if (reg == HTU31D_SIMULATOR_READ_T_RH)                                      /* t && rh */
+        {
+            memcpy(data, sim->frame, 6);                                            /* copy the frame */
+            size = 6;                                                               /* 6 bytes */
+        }
+        else
+        {
+            memcpy(data, &sim->frame[3], 3);                                        /* copy the rh field */
+            size = 3;                                                               /* 3 bytes */
+        }
+        if ((sim->crc_error_period != 0) &&
+            ((sim->reads % sim->crc_error_period) == 0))                            /* check crc injection */
+        {
+            data[2] ^= 0x01;                                                        /* corrupt the crc */
+            sim->crc_errors++;                                                      /* count the error */
+        }
+    }
+    else if (reg == HTU31D_SIMULATOR_READ_SERIAL_NUMBER)                            /* serial number */
+    {
+        memcpy(data, sim->serial_number, 3);                                        /* copy the serial number */
+        data[3] = a_htu31d_simulator_crc(data, 3);                                  /* set the crc */
+        size = 4;                                                                   /* 4 bytes */
+    }
+    else if (reg == HTU31D_SIMULATOR_READ_DIAGNOSTIC)                               /* diagnostic */
+    {
+        data[0] = sim->diagnostic;                                                  /* copy the diagnostic */
+        data[1] = a_htu31d_simulator_crc(data, 1);                                  /* set the crc */
+        size = 2;                                                                   /* 2 bytes */
+    }
+    else
+    {
+        sim->bus_nacks++;                                                           /* count the nack */
+        
+        return 1;                                                                   /* return error */
+    }
+    if (sim->crc_error_next != 0)                                                   /* check one shot crc injection */
+    {
+        sim->crc_error_next--;                                                      /* use the injection */
+        data[size - 1] ^= 0x01;                                                     /* corrupt the last crc */
+        sim->crc_errors++;                                                          /* count the error */
+    }
+    memset(buf, 0xFF, len);                                                         /* idle bus reads 0xFF */
+    memcpy(buf, data, (len < size) ? len : size);                                   /* copy the data */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      find the sensor that answers an address
+ * @param[in]  *mux pointer to a simulator mux structure
+ * @param[in]  addr iic device write address
+ * @return     pointer to the simulator, NULL when no enabled sensor has the address
+ * @note       none
+ */
+static htu31d_simulator_t *a_htu31d_simulator_mux_find(htu31d_simulator_mux_t *mux, uint8_t addr)
+{
+    uint8_t i;
+    uint8_t j;
+    
+    for (i = 0; i < HTU31D_MUX_CHANNEL_MAX; i++)                                    /* check all channels */
+    {
+        if ((mux->control & (1 << i)) == 0)                                         /* check the channel */
+        {
+            continue;                                                               /* channel is off */
+        }
+        for (j = 0; j < 2; j++)                                                     /* check the sensors */
+        {
+            if ((mux->sensor[i][j] != NULL) && (mux->sensor[i][j]->iic_addr == addr))   /* check the address */
+            {
+                return mux->sensor[i][j];                                           /* found */
+            }
+        }
+    }
+    
+    return NULL;                                                                    /* not found */
+}
+
+/**
+ * @brief      simulator iic bus batch read
+ * @param[in]  **user_data pointer to a simulator structure array with num entries
+ * @param[in]  *addr pointer to an iic device write address array
+ * @param[in]  num device number
+ * @param[in]  reg iic command
+ * @param[out] *buf pointer to a data buffer with num * len bytes
+ * @param[in]  len data length of each device
+ * @return     status code
+ *             - 0 success
+ *             - 1 read nacked
+ * @note       like a real combined transaction it stops at the first nacked device
+ */
+uint8_t htu31d_simulator_iic_read_batch(void **user_data, const uint8_t *addr, uint8_t num, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t i;
+    
+    for (i = 0; i < num; i++)                                                       /* read all devices */
+    {
+        if (htu31d_simulator_iic_read(user_data[i], addr[i], reg,
+                                      buf + i * len, len) != 0)                     /* read the device */
+        {
+            return 1;                                                               /* return error */
+        }
+        ((htu31d_simulator_t *)user_data[i])->batch_reads++;                        /* count the batch read */
+    }
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     init the simulated mux with all channels off
+ * @param[in] *mux pointer to a simulator mux structure
+ * @param[in] addr mux write address
+ * @note      none
+ */
+void htu31d_simulator_mux_init(htu31d_simulator_mux_t *mux, uint8_t addr)
+{
+    memset(mux, 0, sizeof(htu31d_simulator_mux_t));                                 /* clear the mux */
+    mux->iic_addr = addr;                                                           /* set the address */
+}
+
+/**
+ * @brief     attach a simulator behind a mux channel
+ * @param[in] *mux pointer to a simulator mux structure
+ * @param[in] channel channel index
+ * @param[in] *sim pointer to an inited simulator structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 channel is full or invalid
+ * @note      a channel holds the two htu31d addresses
+ */
+uint8_t htu31d_simulator_mux_attach(htu31d_simulator_mux_t *mux, uint8_t channel, htu31d_simulator_t *sim)
+{
+    uint8_t j;
+    
+    if (channel >= HTU31D_MUX_CHANNEL_MAX)                                          /* check the channel */
+    {
+        return 1;                                                                   /* return error */
+    }
+    for (j = 0; j < 2; j++)                                                         /* find a free place */
+    {
+        if (mux->sensor[channel][j] == NULL)                                        /* check the place */
+        {
+            mux->sensor[channel][j] = sim;                                          /* attach the sensor */
+            
+            return 0;                                                               /* success return 0 */
+        }
+    }
+    
+    return 1;                                                                       /* return error */
+}
+
+/**
+ * @brief     simulator mux iic bus write
+ * @param[in] *user_data pointer to a simulator mux structure
+ * @param[in] addr iic device write address
+ * @param[in] reg iic command or mux control byte
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write nacked
+ * @note      it is the parent bus of an htu31d mux
+ */
+uint8_t htu31d_simulator_mux_iic_write(void *user_data, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    htu31d_simulator_mux_t *mux = (htu31d_simulator_mux_t *)user_data;
+    htu31d_simulator_t *sim;
+    
+    if (addr == mux->iic_addr)                                                      /* mux access */
+    {
+        if (len != 0)                                                               /* check the length */
+        {
+            mux->nacks++;                                                           /* count the nack */
+            
+            return 1;                                                               /* return error */
+        }
+        mux->control = reg;                                                         /* set the control register */
+        mux->selects++;                                                             /* count the select */
+        
+        return 0;                                                                   /* success return 0 */
+    }
+    sim = a_htu31d_simulator_mux_find(mux, addr);                                   /* find the sensor */
+    if (sim == NULL)                                                                /* check the sensor */
+    {
+        mux->nacks++;                                                               /* count the nack */
+        
+        return 1;                                                                   /* return error */
+    }
+    
+    return htu31d_simulator_iic_write(sim, addr, reg, buf, len);                    /* forward the write */
+}
+
+/**
+ * @brief      simulator mux iic bus read
+ * @param[in]  *user_data pointer to a simulator mux structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic command
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read nacked
+ * @note       only the sensors of the enabled channels answer
+ */
+uint8_t htu31d_simulator_mux_iic_read(void *user_data, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    htu31d_simulator_mux_t *mux = (htu31d_simulator_mux_t *)user_data;
+    htu31d_simulator_t *sim;
+    
+    sim = a_htu31d_simulator_mux_find(mux, addr);                                   /* find the sensor */
+    if (sim == NULL)                                                                /* check the sensor */
+    {
+        mux->nacks++;                                                               /* count the nack */
+        
+        return 1;                                                                   /* return error */
+    }
+    
+    return htu31d_simulator_iic_read(sim, addr, reg, buf, len);                     /* forward the read */
+}
+
+/**
+ * @brief      simulator mux iic bus batch read with channel selects
+ * @param[in]  *user_data pointer to a simulator mux structure
+ * @param[in]  mux_addr mux write address
+ * @param[in]  *select pointer to a mux control byte array, 0 means no select
+ * @param[in]  *addr pointer to an iic device write address array
+ * @param[in]  num device number
+ * @param[in]  reg iic command
+ * @param[out] *buf pointer to a data buffer with num * len bytes
+ * @param[in]  len data length of each device
+ * @return     status code
+ *             - 0 success
+ *             - 1 read nacked
+ * @note       it stops at the first nacked message
+ */
+uint8_t htu31d_simulator_mux_iic_read_batch_select(void *user_data, uint8_t mux_addr, const uint8_t *select, const uint8_t *addr,
+                                                   uint8_t num, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    htu31d_simulator_mux_t *mux = (htu31d_simulator_mux_t *)user_data;
+    uint8_t i;
+    
+    mux->batches++;                                                                 /* count the batch */
+    for (i = 0; i < num; i++)                                                       /* read all devices */
+    {
+        if ((select[i] != 0) &&
+            (htu31d_simulator_mux_iic_write(mux, mux_addr, select[i], NULL, 0) != 0))  /* select the channel */
+        {
+            return 1;                                                               /* return error */
+        }
+        if (htu31d_simulator_mux_iic_read(mux, addr[i], reg, buf + i * len, len) != 0) /* read the device */
+        {
+            return 1;                                                               /* return error */
+        }
+    }
+    
+    return 0;                                                                       /* success return 0 */
+}
@@ -0,0 +1,301 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_htu31d_simulator.h
+ * @brief     driver htu31d simulator header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_HTU31D_SIMULATOR_H
+#define DRIVER_HTU31D_SIMULATOR_H
+
+#include "driver_htu31d.h"
+#include "driver_htu31d_mux.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup htu31d_test_driver
+ * @{
+ */
+
+/**
+ * @brief htu31d simulator waveform structure definition
+ */
+typedef struct htu31d_simulator_waveform_s
+{
+    float mean;              /**< mean value */
+    float amplitude;         /**< sine amplitude */
+    float period_s;          /**< sine period in s, 0 means constant */
+    float noise;             /**< peak uniform noise */
+} htu31d_simulator_waveform_t;
+
+/**
+ * @brief htu31d simulator structure definition
+ */
+typedef struct htu31d_simulator_s
+{
+    uint8_t iic_addr;                                  /**< device iic address */
+    uint8_t serial_number[3];                          /**< serial number */
+    htu31d_simulator_waveform_t temperature;           /**< temperature waveform in C */
+    htu31d_simulator_waveform_t humidity;              /**< humidity waveform in % */
+    uint32_t crc_error_period;                         /**< corrupt the crc of every n-th data read, 0 means never */
+    uint32_t crc_error_next;                           /**< corrupt the crc of the next n reads */
+    uint32_t nack_next;                                /**< nack the next n reads */
+    uint32_t (*timestamp_us)(void);                    /**< point to a timestamp_us function address */
+    uint32_t seed;                                     /**< noise generator state */
+    uint8_t heater;                                    /**< heater flag */
+    uint8_t diagnostic;                                /**< diagnostic register */
+    uint8_t converting;                                /**< conversion in progress flag */
+    uint32_t conversion_start;                         /**< conversion start timestamp in us */
+    uint32_t conversion_time;                          /**< conversion time in us */
+    uint8_t frame[6];                                  /**< latched t && rh frame */
+    uint32_t writes;                                   /**< write transactions */
+    uint32_t reads;                                    /**< read transactions */
+    uint32_t batch_reads;                              /**< read transactions served inside a batch */
+    uint32_t conversions;                              /**< started conversions */
+    uint32_t resets;                                   /**< soft resets */
+    uint32_t busy_nacks;                               /**< reads nacked during a conversion */
+    uint32_t bus_nacks;                                /**< transactions nacked for a bad address or command */
+    uint32_t crc_errors;                               /**< injected crc errors */
+} htu31d_simulator_t;
+
+/**
+ * @brief htu31d simulator mux structure definition
+ */
+typedef struct htu31d_simulator_mux_s
+{
+    uint8_t iic_addr;                                                           /**< mux write address */
+    uint8_t control;                                                            /**< control register, one bit per channel */
+    htu31d_simulator_t *sensor[HTU31D_MUX_CHANNEL_MAX][2];                      /**< sensors behind the channels */
+    uint32_t selects;                                                           /**< control register writes */
+    uint32_t batches;                                                           /**< batch transactions */
+    uint32_t nacks;                                                             /**< transactions no device answered */
+} htu31d_simulator_mux_t;
+
+/**
+ * @brief     reset the virtual clock to 0
+ * @param[in] tick_us time added by every timestamp read
+ * @note      a non-zero tick lets polling loops make progress
+ */
+void htu31d_simulator_clock_init(uint32_t tick_us);
+
+/**
+ * @brief     advance the virtual clock
+ * @param[in] us advanced time in us
+ * @note      none
+ */
+void htu31d_simulator_clock_advance(uint32_t us);
+
+/**
+ * @brief  get the virtual clock time
+ * @return time in us since htu31d_simulator_clock_init
+ * @note   it does not wrap like htu31d_simulator_clock_timestamp_us
+ */
+uint64_t htu31d_simulator_clock_get_us(void);
+
+/**
+ * @brief     virtual clock delay ms
+ * @param[in] ms delay time in ms
+ * @note      the clock advances instantly
+ */
+void htu31d_simulator_clock_delay_ms(uint32_t ms);
+
+/**
+ * @brief     virtual clock delay us
+ * @param[in] us delay time in us
+ * @note      the clock advances instantly
+ */
+void htu31d_simulator_clock_delay_us(uint32_t us);
+
+/**
+ * @brief  virtual clock timestamp
+ * @return timestamp in us
+ * @note   none
+ */
+uint32_t htu31d_simulator_clock_timestamp_us(void);
+
+/**
+ * @brief     init the simulator with a constant 25C 50% environment
+ * @param[in] *sim pointer to a simulator structure
+ * @param[in] addr_pin addr pin
+ * @note      conversions complete immediately unless timestamp_us is set
+ */
+void htu31d_simulator_init(htu31d_simulator_t *sim, htu31d_addr_pin_t addr_pin);
+
+/**
+ * @brief     get the environment value the simulator would convert
+ * @param[in] *sim pointer to a simulator structure
+ * @param[in] time_us sample time in us
+ * @param[out] *temperature pointer to a temperature buffer
+ * @param[out] *humidity pointer to a humidity buffer
+ * @note      noise is not included
+ */
+void htu31d_simulator_get_environment(htu31d_simulator_t *sim, uint32_t time_us, float *temperature, float *humidity);
+
+/**
+ * @brief     simulator iic bus init
+ * @param[in] *user_data pointer to a simulator structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t htu31d_simulator_iic_init(void *user_data);
+
+/**
+ * @brief     simulator iic bus deinit
+ * @param[in] *user_data pointer to a simulator structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t htu31d_simulator_iic_deinit(void *user_data);
+
+/**
+ * @brief     simulator iic bus write
+ * @param[in] *user_data pointer to a simulator structure
+ * @param[in] addr iic device write address
+ * @param[in] reg iic command
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write nacked
+ * @note      none
+ */
+uint8_t htu31d_simulator_iic_write(void *user_data, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      simulator iic bus read
+ * @param[in]  *user_data pointer to a simulator structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic command
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read nacked
+ * @note       a data read during a conversion is nacked
+ */
+uint8_t htu31d_simulator_iic_read(void *user_data, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      simulator iic bus batch read
+ * @param[in]  **user_data pointer to a simulator structure array with num entries
+ * @param[in]  *addr pointer to an iic device write address array
+ * @param[in]  num device number
+ * @param[in]  reg iic command
+ * @param[out] *buf pointer to a data buffer with num * len bytes
+ * @param[in]  len data length of each device
+ * @return     status code
+ *             - 0 success
+ *             - 1 read nacked
+ * @note       like a real combined transaction it stops at the first nacked device
+ */
+uint8_t htu31d_simulator_iic_read_batch(void **user_data, const uint8_t *addr, uint8_t num, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     init the simulated mux with all channels off
+ * @param[in] *mux pointer to a simulator mux structure
+ * @param[in] addr mux write address
+ * @note      none
+ */
+void htu31d_simulator_mux_init(htu31d_simulator_mux_t *mux, uint8_t addr);
+
+/**
+ * @brief     attach a simulator behind a mux channel
+ * @param[in] *mux pointer to a simulator mux structure
+ * @param[in] channel channel index
+ * @param[in] *sim pointer to an inited simulator structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 channel is full or invalid
+ * @note      a channel holds the two htu31d addresses
+ */
+uint8_t htu31d_simulator_mux_attach(htu31d_simulator_mux_t *mux, uint8_t channel, htu31d_simulator_t *sim);
+
+/**
+ * @brief     simulator mux iic bus write
+ * @param[in] *user_data pointer to a simulator mux structure
+ * @param[in] addr iic device write address
+ * @param[in] reg iic command or mux control byte
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write nacked
+ * @note      it is the parent bus of an htu31d mux
+ */
+uint8_t htu31d_simulator_mux_iic_write(void *user_data, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      simulator mux iic bus read
+ * @param[in]  *user_data pointer to a simulator mux structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic command
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read nacked
+ * @note       only the sensors of the enabled channels answer
+ */
+uint8_t htu31d_simulator_mux_iic_read(void *user_data, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      simulator mux iic bus batch read with channel selects
+ * @param[in]  *user_data pointer to a simulator mux structure
+ * @param[in]  mux_addr mux write address
+ * @param[in]  *select pointer to a mux control byte array, 0 means no select
+ * @param[in]  *addr pointer to an iic device write address array
+ * @param[in]  num device number
+ * @param[in]  reg iic command
+ * @param[out] *buf pointer to a data buffer with num * len bytes
+ * @param[in]  len data length of each device
+ * @return     status code
+ *             - 0 success
+ *             - 1 read nacked
+ * @note       it stops at the first nacked message
+ */
+uint8_t htu31d_simulator_mux_iic_read_batch_select(void *user_data, uint8_t mux_addr, const uint8_t *select, const uint8_t *addr,
+                                                   uint8_t num, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
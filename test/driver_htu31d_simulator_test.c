@@ -0,0 +1,602 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_htu31d_simulator_test.c
+ * @brief     driver htu31d simulator test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_htu31d_simulator_test.h"
+#include <stdlib.h>
+
+/**
+ * @brief simulator test definition
+ */
+#define HTU31D_SIMULATOR_TEST_SENSORS    4        /**< simulated sensors */
+
+static htu31d_simulator_t gs_sim[HTU31D_SIMULATOR_TEST_SENSORS];            /**< simulators */
+static htu31d_handle_t gs_handle[HTU31D_SIMULATOR_TEST_SENSORS];            /**< htu31d handles */
+static htu31d_statistics_t gs_stats[HTU31D_SIMULATOR_TEST_SENSORS];         /**< htu31d statistics */
+static uint32_t gs_continuous_times;                                        /**< continuous samples to take */
+static uint32_t gs_continuous_count;                                        /**< continuous samples taken */
+static uint32_t gs_continuous_errors;                                       /**< continuous bad samples */
+static uint32_t gs_continuous_last;                                         /**< last continuous sample timestamp */
+
+/**
+ * @brief     link a handle to its own simulator
+ * @param[in] i sensor index
+ * @note      the simulator runs in virtual time with a 20C + i, 50% environment
+ */
+static void a_htu31d_simulator_test_link(uint8_t i)
+{
+    htu31d_simulator_init(&gs_sim[i], HTU31D_ADDR_PIN_LOW);
+    gs_sim[i].timestamp_us = htu31d_simulator_clock_timestamp_us;
+    gs_sim[i].temperature.mean = 20.0f + (float)i;
+    DRIVER_HTU31D_LINK_INIT(&gs_handle[i], htu31d_handle_t);
+    DRIVER_HTU31D_LINK_IIC_INIT(&gs_handle[i], htu31d_interface_iic_init);
+    DRIVER_HTU31D_LINK_IIC_DEINIT(&gs_handle[i], htu31d_interface_iic_deinit);
+    DRIVER_HTU31D_LINK_IIC_WRITE(&gs_handle[i], htu31d_interface_iic_write);
+    DRIVER_HTU31D_LINK_IIC_READ(&gs_handle[i], htu31d_interface_iic_read);
+    DRIVER_HTU31D_LINK_DELAY_MS(&gs_handle[i], htu31d_simulator_clock_delay_ms);
+    DRIVER_HTU31D_LINK_DELAY_US(&gs_handle[i], htu31d_simulator_clock_delay_us);
+    DRIVER_HTU31D_LINK_TIMESTAMP_US(&gs_handle[i], htu31d_simulator_clock_timestamp_us);
+    DRIVER_HTU31D_LINK_DEBUG_PRINT(&gs_handle[i], htu31d_interface_debug_print);
+    DRIVER_HTU31D_LINK_USER_DATA(&gs_handle[i], &gs_sim[i]);
+    DRIVER_HTU31D_LINK_IIC_INIT_CTX(&gs_handle[i], htu31d_simulator_iic_init);
+    DRIVER_HTU31D_LINK_IIC_DEINIT_CTX(&gs_handle[i], htu31d_simulator_iic_deinit);
+    DRIVER_HTU31D_LINK_IIC_WRITE_CTX(&gs_handle[i], htu31d_simulator_iic_write);
+    DRIVER_HTU31D_LINK_IIC_READ_CTX(&gs_handle[i], htu31d_simulator_iic_read);
+    (void)htu31d_set_addr_pin(&gs_handle[i], HTU31D_ADDR_PIN_LOW);
+    (void)htu31d_set_statistics(&gs_handle[i], &gs_stats[i]);
+}
+
+/**
+ * @brief     check a sample against the simulated environment
+ * @param[in] i sensor index
+ * @param[in] *sample pointer to a sample structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 sample is wrong
+ * @note      the simulators have no noise, so only the conversion rounding is allowed
+ */
+static uint8_t a_htu31d_simulator_test_check(uint8_t i, htu31d_sample_t *sample)
+{
+    float temperature;
+    float humidity;
+    
+    htu31d_simulator_get_environment(&gs_sim[i], sample->timestamp_us, &temperature, &humidity);
+    if ((abs(sample->temperature_centi - (int32_t)(temperature * 100.0f)) > 2) ||
+        (abs((int32_t)sample->humidity_centi - (int32_t)(humidity * 100.0f)) > 2))
+    {
+        htu31d_interface_debug_print("htu31d: sensor %d read %d centi C %d centi %% but expect %d centi C %d centi %%.\n",
+                                     i, sample->temperature_centi, sample->humidity_centi,
+                                     (int32_t)(temperature * 100.0f), (int32_t)(humidity * 100.0f));
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  group read test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the group must wait once for all conversions, and a sensor that nacks its conversion
+ *         command must be reported and skipped without stopping the others
+ */
+static uint8_t a_htu31d_simulator_test_group(void)
+{
+    uint8_t i;
+    uint8_t res;
+    uint8_t status[HTU31D_SIMULATOR_TEST_SENSORS];
+    uint32_t waits;
+    uint32_t waited;
+    uint32_t reads;
+    uint64_t start;
+    uint64_t elapsed;
+    htu31d_handle_t *handle[HTU31D_SIMULATOR_TEST_SENSORS];
+    htu31d_sample_t sample[HTU31D_SIMULATOR_TEST_SENSORS];
+    
+    for (i = 0; i < HTU31D_SIMULATOR_TEST_SENSORS; i++)
+    {
+        a_htu31d_simulator_test_link(i);
+        handle[i] = &gs_handle[i];
+    }
+    res = htu31d_group_init(handle, HTU31D_SIMULATOR_TEST_SENSORS, status);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: group init failed.\n");
+        
+        return 1;
+    }
+    
+    /* sensor 2 is unplugged */
+    gs_sim[2].iic_addr = 0;
+    reads = gs_sim[2].reads;
+    waits = 0;
+    for (i = 0; i < HTU31D_SIMULATOR_TEST_SENSORS; i++)
+    {
+        waits += gs_stats[i].wait_count;
+    }
+    start = htu31d_simulator_clock_get_us();
+    res = htu31d_group_read(handle, HTU31D_SIMULATOR_TEST_SENSORS, sample, status);
+    elapsed = htu31d_simulator_clock_get_us() - start;
+    gs_sim[2].iic_addr = HTU31D_ADDR_PIN_LOW;
+    if ((res != 1) || (status[2] != 1) || (gs_sim[2].reads != reads))
+    {
+        htu31d_interface_debug_print("htu31d: unplugged sensor is not skipped.\n");
+        (void)htu31d_group_deinit(handle, HTU31D_SIMULATOR_TEST_SENSORS, status);
+        
+        return 1;
+    }
+    waited = 0;
+    for (i = 0; i < HTU31D_SIMULATOR_TEST_SENSORS; i++)
+    {
+        waited += gs_stats[i].wait_count;
+        if ((i != 2) && ((status[i] != 0) || (a_htu31d_simulator_test_check(i, &sample[i]) != 0)))
+        {
+            htu31d_interface_debug_print("htu31d: group read of sensor %d is wrong.\n", i);
+            (void)htu31d_group_deinit(handle, HTU31D_SIMULATOR_TEST_SENSORS, status);
+            
+            return 1;
+        }
+    }
+    
+    /* one wait, not one per sensor */
+    if ((waited - waits != 1) || (elapsed >= 2 * gs_handle[0].conversion_time))
+    {
+        htu31d_interface_debug_print("htu31d: group read waited %d times for %dus.\n", waited - waits, (uint32_t)elapsed);
+        (void)htu31d_group_deinit(handle, HTU31D_SIMULATOR_TEST_SENSORS, status);
+        
+        return 1;
+    }
+    htu31d_interface_debug_print("htu31d: group read of 3 sensors took %dus for a %dus conversion.\n",
+                                 (uint32_t)elapsed, gs_handle[0].conversion_time);
+    
+    return htu31d_group_deinit(handle, HTU31D_SIMULATOR_TEST_SENSORS, status);
+}
+
+/**
+ * @brief  batch read test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   one sensor stops answering after its conversion is started, the failed batch must be
+ *         retried sensor by sensor and every result must land in the sample of its own sensor
+ */
+static uint8_t a_htu31d_simulator_test_batch(void)
+{
+    uint8_t i;
+    uint8_t res;
+    uint8_t status[HTU31D_SIMULATOR_TEST_SENSORS];
+    uint32_t wait_us;
+    uint32_t batch_reads[HTU31D_SIMULATOR_TEST_SENSORS];
+    uint32_t reads[HTU31D_SIMULATOR_TEST_SENSORS];
+    htu31d_handle_t *handle[HTU31D_SIMULATOR_TEST_SENSORS];
+    htu31d_sample_t sample[HTU31D_SIMULATOR_TEST_SENSORS];
+    
+    /* link the batch read */
+    for (i = 0; i < HTU31D_SIMULATOR_TEST_SENSORS; i++)
+    {
+        a_htu31d_simulator_test_link(i);
+        DRIVER_HTU31D_LINK_IIC_READ_BATCH_CTX(&gs_handle[i], htu31d_simulator_iic_read_batch);
+        handle[i] = &gs_handle[i];
+    }
+    res = htu31d_group_init(handle, HTU31D_SIMULATOR_TEST_SENSORS, status);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: group init failed.\n");
+        
+        return 1;
+    }
+    
+    /* all sensors answer, one batch demultiplexes the results */
+    res = htu31d_group_read(handle, HTU31D_SIMULATOR_TEST_SENSORS, sample, status);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: group read failed.\n");
+        (void)htu31d_group_deinit(handle, HTU31D_SIMULATOR_TEST_SENSORS, status);
+        
+        return 1;
+    }
+    for (i = 0; i < HTU31D_SIMULATOR_TEST_SENSORS; i++)
+    {
+        if ((gs_sim[i].batch_reads != 1) || (a_htu31d_simulator_test_check(i, &sample[i]) != 0))
+        {
+            htu31d_interface_debug_print("htu31d: batch read of sensor %d is wrong.\n", i);
+            (void)htu31d_group_deinit(handle, HTU31D_SIMULATOR_TEST_SENSORS, status);
+            
+            return 1;
+        }
+    }
+    
+    /* sensor 1 nacks after the start, the batch stops there and is retried one by one */
+    for (i = 0; i < HTU31D_SIMULATOR_TEST_SENSORS; i++)
+    {
+        batch_reads[i] = gs_sim[i].batch_reads;
+        reads[i] = gs_sim[i].reads;
+        sample[i].temperature_centi = 0;
+    }
+    res = htu31d_group_start_conversion(handle, HTU31D_SIMULATOR_TEST_SENSORS, status, &wait_us);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: group start conversion failed.\n");
+        (void)htu31d_group_deinit(handle, HTU31D_SIMULATOR_TEST_SENSORS, status);
+        
+        return 1;
+    }
+    htu31d_simulator_clock_delay_us(wait_us);
+    gs_sim[1].iic_addr = 0;
+    res = htu31d_group_fetch(handle, HTU31D_SIMULATOR_TEST_SENSORS, sample, status);
+    gs_sim[1].iic_addr = HTU31D_ADDR_PIN_LOW;
+    if ((res != 1) || (status[1] != 1))
+    {
+        htu31d_interface_debug_print("htu31d: nacked sensor is not reported.\n");
+        (void)htu31d_group_deinit(handle, HTU31D_SIMULATOR_TEST_SENSORS, status);
+        
+        return 1;
+    }
+    if ((gs_sim[0].batch_reads != batch_reads[0] + 1) || (gs_sim[2].batch_reads != batch_reads[2]) ||
+        (gs_sim[3].batch_reads != batch_reads[3]))
+    {
+        htu31d_interface_debug_print("htu31d: batch did not stop at the nacked sensor.\n");
+        (void)htu31d_group_deinit(handle, HTU31D_SIMULATOR_TEST_SENSORS, status);
+        
+        return 1;
+    }
+    for (i = 0; i < HTU31D_SIMULATOR_TEST_SENSORS; i++)
+    {
+        if (i == 1)
+        {
+            continue;
+        }
+        if ((status[i] != 0) || (gs_sim[i].reads != reads[i] + ((i == 0) ? 2 : 1)) ||
+            (a_htu31d_simulator_test_check(i, &sample[i]) != 0))
+        {
+            htu31d_interface_debug_print("htu31d: fallback read of sensor %d is wrong.\n", i);
+            (void)htu31d_group_deinit(handle, HTU31D_SIMULATOR_TEST_SENSORS, status);
+            
+            return 1;
+        }
+    }
+    htu31d_interface_debug_print("htu31d: batch fallback reported sensor 1 and read the others one by one.\n");
+    
+    return htu31d_group_deinit(handle, HTU31D_SIMULATOR_TEST_SENSORS, status);
+}
+
+/**
+ * @brief     continuous sample callback
+ * @param[in] *handle pointer to an htu31d handle structure
+ * @param[in] res sample status
+ * @param[in] *sample pointer to a sample structure
+ * @note      the samples must be spaced by one conversion time plus the few virtual clock ticks of the bus accesses
+ */
+static void a_htu31d_simulator_test_continuous_callback(htu31d_handle_t *handle, uint8_t res, htu31d_sample_t *sample)
+{
+    uint32_t spacing;
+    
+    spacing = sample->timestamp_us - gs_continuous_last;
+    if ((res != 0) || (a_htu31d_simulator_test_check(0, sample) != 0) ||
+        ((gs_continuous_count != 0) &&
+         ((spacing < handle->conversion_time) || (spacing > handle->conversion_time + 16))))
+    {
+        gs_continuous_errors++;
+    }
+    gs_continuous_last = sample->timestamp_us;
+    gs_continuous_count++;
+    if (gs_continuous_count >= gs_continuous_times)
+    {
+        (void)htu31d_continuous_stop(handle);
+    }
+}
+
+/**
+ * @brief  pipelined continuous read test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   a period below the conversion time starts the next conversion before the callback runs,
+ *         the sensor must never be read while it converts and the stop must drain the last conversion
+ */
+static uint8_t a_htu31d_simulator_test_continuous(void)
+{
+    uint8_t res;
+    uint32_t conversions;
+    uint64_t start;
+    
+    a_htu31d_simulator_test_link(0);
+    res = htu31d_init(&gs_handle[0]);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: init failed.\n");
+        
+        return 1;
+    }
+    gs_continuous_times = 100;
+    gs_continuous_count = 0;
+    gs_continuous_errors = 0;
+    conversions = gs_sim[0].conversions;
+    start = htu31d_simulator_clock_get_us();
+    res = htu31d_continuous_start(&gs_handle[0], 0, a_htu31d_simulator_test_continuous_callback);
+    if ((res != 0) || (gs_continuous_count != gs_continuous_times) || (gs_continuous_errors != 0))
+    {
+        htu31d_interface_debug_print("htu31d: continuous returned %d after %d samples with %d bad ones.\n",
+                                     res, gs_continuous_count, gs_continuous_errors);
+        (void)htu31d_deinit(&gs_handle[0]);
+        
+        return 1;
+    }
+    if ((gs_handle[0].conversion != 0) || (gs_sim[0].busy_nacks != 0) ||
+        (gs_sim[0].conversions - conversions != gs_continuous_times + 1))
+    {
+        htu31d_interface_debug_print("htu31d: continuous stop left a conversion in flight.\n");
+        (void)htu31d_deinit(&gs_handle[0]);
+        
+        return 1;
+    }
+    htu31d_interface_debug_print("htu31d: %d pipelined samples took %dus, %dus per conversion.\n",
+                                 gs_continuous_count, (uint32_t)(htu31d_simulator_clock_get_us() - start),
+                                 gs_handle[0].conversion_time);
+    if (htu31d_simulator_clock_get_us() - start > (uint64_t)(gs_continuous_times + 2) * gs_handle[0].conversion_time)
+    {
+        htu31d_interface_debug_print("htu31d: pipelined samples are slower than the conversion.\n");
+        (void)htu31d_deinit(&gs_handle[0]);
+        
+        return 1;
+    }
+    
+    return htu31d_deinit(&gs_handle[0]);
+}
+
+/**
+ * @brief  periodic read test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the release times must stay on the 10ms grid of the first release over many periods,
+ *         a stalled caller must be counted as overruns and show up in the max lateness
+ */
+static uint8_t a_htu31d_simulator_test_periodic(void)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t first;
+    uint32_t late;
+    htu31d_periodic_t periodic;
+    htu31d_sample_t sample;
+    
+    a_htu31d_simulator_test_link(0);
+    res = htu31d_init(&gs_handle[0]);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: init failed.\n");
+        
+        return 1;
+    }
+    res = htu31d_periodic_start(&gs_handle[0], &periodic, 10000);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: periodic start failed.\n");
+        (void)htu31d_deinit(&gs_handle[0]);
+        
+        return 1;
+    }
+    first = periodic.release;
+    for (i = 0; i < 1000; i++)
+    {
+        if (i == 500)
+        {
+            /* stall the caller for three periods */
+            htu31d_simulator_clock_advance(3 * periodic.period_us);
+        }
+        res = htu31d_periodic_read(&gs_handle[0], &periodic, &sample);
+        if ((res != 0) || (a_htu31d_simulator_test_check(0, &sample) != 0))
+        {
+            htu31d_interface_debug_print("htu31d: periodic read %d failed.\n", i);
+            (void)htu31d_deinit(&gs_handle[0]);
+            
+            return 1;
+        }
+        late = gs_handle[0].conversion_start - (periodic.release - periodic.period_us);
+        if ((periodic.release - first != (periodic.count + periodic.overrun) * periodic.period_us) ||
+            ((i != 500) && (late > 16)))
+        {
+            htu31d_interface_debug_print("htu31d: periodic read %d started %dus after its release.\n", i, late);
+            (void)htu31d_deinit(&gs_handle[0]);
+            
+            return 1;
+        }
+    }
+    if ((periodic.count != 1000) || (periodic.overrun != 2) ||
+        (periodic.max_lateness_us < gs_handle[0].conversion_time) ||
+        (periodic.max_lateness_us > gs_handle[0].conversion_time + 16))
+    {
+        htu31d_interface_debug_print("htu31d: periodic took %d samples with %d overruns and %dus max lateness.\n",
+                                     periodic.count, periodic.overrun, periodic.max_lateness_us);
+        (void)htu31d_deinit(&gs_handle[0]);
+        
+        return 1;
+    }
+    htu31d_interface_debug_print("htu31d: %d periodic samples, %d overruns, %dus max lateness.\n",
+                                 periodic.count, periodic.overrun, periodic.max_lateness_us);
+    
+    /* the sampler needs the timestamp */
+    gs_handle[0].timestamp_us = NULL;
+    if (htu31d_periodic_read(&gs_handle[0], &periodic, &sample) != 4)
+    {
+        htu31d_interface_debug_print("htu31d: periodic read without timestamp is not rejected.\n");
+        (void)htu31d_deinit(&gs_handle[0]);
+        
+        return 1;
+    }
+    
+    return htu31d_deinit(&gs_handle[0]);
+}
+
+/**
+ * @brief     warm init of one sensor
+ * @param[in] *name pointer to the case name
+ * @param[in] resets expected reset number during the init
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the faults must be injected into sensor 0 before the call
+ */
+static uint8_t a_htu31d_simulator_test_warm_init(const char *name, uint32_t resets)
+{
+    uint8_t res;
+    uint32_t count;
+    
+    count = gs_sim[0].resets;
+    res = htu31d_init(&gs_handle[0]);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: %s warm init failed.\n", name);
+        
+        return 1;
+    }
+    if (gs_sim[0].resets - count != resets)
+    {
+        htu31d_interface_debug_print("htu31d: %s warm init sent %d resets but expect %d.\n",
+                                     name, gs_sim[0].resets - count, resets);
+        (void)htu31d_deinit(&gs_handle[0]);
+        
+        return 1;
+    }
+    htu31d_interface_debug_print("htu31d: %s warm init sent %d resets.\n", name, resets);
+    
+    return htu31d_deinit(&gs_handle[0]);
+}
+
+/**
+ * @brief  warm init test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   a healthy sensor keeps running, every failed probe falls back to the reset
+ */
+static uint8_t a_htu31d_simulator_test_warm(void)
+{
+    a_htu31d_simulator_test_link(0);
+    (void)htu31d_set_init_mode(&gs_handle[0], HTU31D_INIT_MODE_WARM);
+    
+    /* healthy sensor */
+    if (a_htu31d_simulator_test_warm_init("healthy", 0) != 0)
+    {
+        return 1;
+    }
+    
+    /* nvm error bit */
+    gs_sim[0].diagnostic |= HTU31D_DIAGNOSTIC_NVM_ERROR;
+    if (a_htu31d_simulator_test_warm_init("nvm error", 1) != 0)
+    {
+        return 1;
+    }
+    
+    /* bad diagnostic crc */
+    gs_sim[0].crc_error_next = 1;
+    if (a_htu31d_simulator_test_warm_init("bad crc", 1) != 0)
+    {
+        return 1;
+    }
+    if (gs_stats[0].crc_error[HTU31D_STATISTICS_COMMAND_DIAGNOSTIC] == 0)
+    {
+        htu31d_interface_debug_print("htu31d: bad probe crc is not counted.\n");
+        
+        return 1;
+    }
+    
+    /* nacked probe */
+    gs_sim[0].nack_next = 1;
+    if (a_htu31d_simulator_test_warm_init("nacked", 1) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  simulator test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   it checks the driver paths that need several sensors or injected bus faults in virtual time
+ */
+uint8_t htu31d_simulator_test(void)
+{
+    htu31d_simulator_clock_init(1);
+    
+    /* start simulator test */
+    htu31d_interface_debug_print("htu31d: start simulator test.\n");
+    
+    /* group read */
+    htu31d_interface_debug_print("htu31d: group read test.\n");
+    if (a_htu31d_simulator_test_group() != 0)
+    {
+        return 1;
+    }
+    
+    /* batch read */
+    htu31d_interface_debug_print("htu31d: batch read test.\n");
+    if (a_htu31d_simulator_test_batch() != 0)
+    {
+        return 1;
+    }
+    
+    /* pipelined continuous read */
+    htu31d_interface_debug_print("htu31d: pipelined continuous read test.\n");
+    if (a_htu31d_simulator_test_continuous() != 0)
+    {
+        return 1;
+    }
+    
+    /* periodic read */
+    htu31d_interface_debug_print("htu31d: periodic read test.\n");
+    if (a_htu31d_simulator_test_periodic() != 0)
+    {
+        return 1;
+    }
+    
+    /* warm init */
+    htu31d_interface_debug_print("htu31d: warm init test.\n");
+    if (a_htu31d_simulator_test_warm() != 0)
+    {
+        return 1;
+    }
+    
+    /* finish simulator test */
+    htu31d_interface_debug_print("htu31d: finish simulator test.\n");
+    
+    return 0;
+}
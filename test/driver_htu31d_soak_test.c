@@ -0,0 +1,148 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_htu31d_soak_test.c
+ * @brief     driver htu31d soak test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_htu31d_soak_test.h"
+#include <stdlib.h>
+
+static htu31d_handle_t gs_handle;        /**< htu31d handle */
+static htu31d_simulator_t gs_sim;        /**< simulator */
+
+/**
+ * @brief     soak test
+ * @param[in] times conversion times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      it runs the blocking read against the simulator in virtual time and reports
+ *            the conversions per second of wall time
+ */
+uint8_t htu31d_soak_test(uint32_t times)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t now;
+    uint32_t last;
+    uint64_t wall_us;
+    uint16_t temperature_raw;
+    int16_t temperature_centi;
+    uint16_t humidity_raw;
+    uint16_t humidity_centi;
+    
+    /* link the simulator in virtual time */
+    htu31d_simulator_clock_init(1);
+    htu31d_simulator_init(&gs_sim, HTU31D_ADDR_PIN_LOW);
+    gs_sim.timestamp_us = htu31d_simulator_clock_timestamp_us;
+    gs_sim.temperature.amplitude = 5.0f;
+    gs_sim.temperature.period_s = 60.0f;
+    gs_sim.humidity.amplitude = 10.0f;
+    gs_sim.humidity.period_s = 90.0f;
+    DRIVER_HTU31D_LINK_INIT(&gs_handle, htu31d_handle_t);
+    DRIVER_HTU31D_LINK_IIC_INIT(&gs_handle, htu31d_interface_iic_init);
+    DRIVER_HTU31D_LINK_IIC_DEINIT(&gs_handle, htu31d_interface_iic_deinit);
+    DRIVER_HTU31D_LINK_IIC_WRITE(&gs_handle, htu31d_interface_iic_write);
+    DRIVER_HTU31D_LINK_IIC_READ(&gs_handle, htu31d_interface_iic_read);
+    DRIVER_HTU31D_LINK_DELAY_MS(&gs_handle, htu31d_simulator_clock_delay_ms);
+    DRIVER_HTU31D_LINK_DELAY_US(&gs_handle, htu31d_simulator_clock_delay_us);
+    DRIVER_HTU31D_LINK_TIMESTAMP_US(&gs_handle, htu31d_simulator_clock_timestamp_us);
+    DRIVER_HTU31D_LINK_DEBUG_PRINT(&gs_handle, htu31d_interface_debug_print);
+    DRIVER_HTU31D_LINK_USER_DATA(&gs_handle, &gs_sim);
+    DRIVER_HTU31D_LINK_IIC_INIT_CTX(&gs_handle, htu31d_simulator_iic_init);
+    DRIVER_HTU31D_LINK_IIC_DEINIT_CTX(&gs_handle, htu31d_simulator_iic_deinit);
+    DRIVER_HTU31D_LINK_IIC_WRITE_CTX(&gs_handle, htu31d_simulator_iic_write);
+    DRIVER_HTU31D_LINK_IIC_READ_CTX(&gs_handle, htu31d_simulator_iic_read);
+    (void)htu31d_set_addr_pin(&gs_handle, HTU31D_ADDR_PIN_LOW);
+    
+    /* start soak test */
+    htu31d_interface_debug_print("htu31d: start soak test.\n");
+    
+    /* init */
+    res = htu31d_init(&gs_handle);
+    if (res != 0)
+    {
+        htu31d_interface_debug_print("htu31d: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* read in a tight loop, the wall time is summed in short steps so it never wraps */
+    wall_us = 0;
+    last = htu31d_interface_timestamp_us();
+    for (i = 0; i < times; i++)
+    {
+        res = htu31d_read_temperature_humidity_fixed(&gs_handle, &temperature_raw, &temperature_centi,
+                                                     &humidity_raw, &humidity_centi);
+        if (res != 0)
+        {
+            htu31d_interface_debug_print("htu31d: read %d failed.\n", i);
+            (void)htu31d_deinit(&gs_handle);
+            
+            return 1;
+        }
+        if ((temperature_centi < 1999) || (temperature_centi > 3001) ||
+            (humidity_centi < 3999) || (humidity_centi > 6001))
+        {
+            htu31d_interface_debug_print("htu31d: read %d is out of the simulated range.\n", i);
+            (void)htu31d_deinit(&gs_handle);
+            
+            return 1;
+        }
+        if ((i & 0x3FF) == 0x3FF)
+        {
+            now = htu31d_interface_timestamp_us();
+            wall_us += now - last;
+            last = now;
+        }
+    }
+    now = htu31d_interface_timestamp_us();
+    wall_us += now - last;
+    
+    /* output */
+    htu31d_interface_debug_print("htu31d: %d conversions, %d s of virtual time in %d ms.\n",
+                                 gs_sim.conversions, (uint32_t)(htu31d_simulator_clock_get_us() / 1000000),
+                                 (uint32_t)(wall_us / 1000));
+    if (wall_us != 0)
+    {
+        htu31d_interface_debug_print("htu31d: %d conversions/s.\n", (uint32_t)((uint64_t)times * 1000000 / wall_us));
+    }
+    
+    /* deinit */
+    (void)htu31d_deinit(&gs_handle);
+    
+    /* finish soak test */
+    htu31d_interface_debug_print("htu31d: finish soak test.\n");
+    
+    return 0;
+}